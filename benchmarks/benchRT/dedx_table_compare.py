@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+
+# Compares the images scored with the dedx tables (output/dedxTable-*-table*.mhd)
+# with the images scored by the same actors computing the dedx with
+# G4EmCalculator at each step (same name with -direct). Only the voxels
+# above 1% of the maximum are compared. Exits with 1 if a relative
+# difference is above the tolerance.
+#
+# Usage: dedx_table_compare.py [output directory] [tolerance, default 0.005]
+
+import glob
+import os
+import struct
+import sys
+
+TYPES = {'MET_FLOAT': 'f', 'MET_DOUBLE': 'd', 'MET_INT': 'i', 'MET_UINT': 'I',
+         'MET_SHORT': 'h', 'MET_USHORT': 'H', 'MET_CHAR': 'b', 'MET_UCHAR': 'B'}
+
+
+def read_mhd(filename):
+    header = {}
+    with open(filename) as f:
+        for line in f:
+            if '=' in line:
+                key, value = line.split('=', 1)
+                header[key.strip()] = value.strip()
+    t = TYPES[header['ElementType']]
+    n = 1
+    for d in header['DimSize'].split():
+        n *= int(d)
+    order = '>' if header.get('BinaryDataByteOrderMSB', 'False') == 'True' else '<'
+    raw = os.path.join(os.path.dirname(filename), header['ElementDataFile'])
+    with open(raw, 'rb') as f:
+        return struct.unpack(order + str(n) + t, f.read(n * struct.calcsize(t)))
+
+
+def main():
+    directory = sys.argv[1] if len(sys.argv) > 1 else 'output'
+    tolerance = float(sys.argv[2]) if len(sys.argv) > 2 else 0.005
+    tables = sorted(glob.glob(os.path.join(directory, 'dedxTable-*-table*.mhd')))
+    if len(tables) < 4:
+        print('Expected at least 4 images scored with the dedx tables, found', len(tables))
+        return 1
+
+    status = 0
+    for table in tables:
+        direct = table.replace('-table', '-direct', 1)
+        if not os.path.exists(direct):
+            print('Missing', direct)
+            status = 1
+            continue
+        a = read_mhd(table)
+        b = read_mhd(direct)
+        threshold = 0.01 * max(abs(v) for v in b)
+        diffs = [abs(x - y) / abs(y) for x, y in zip(a, b) if abs(y) > threshold]
+        if threshold <= 0 or not diffs:
+            print('Empty image', direct)
+            status = 1
+            continue
+        worst = max(diffs)
+        mean = sum(diffs) / len(diffs)
+        result = 'ok' if worst <= tolerance else 'FAILED'
+        print('%-50s voxels %5d  mean %.2e  max %.2e  (tolerance %.1e) %s'
+              % (os.path.basename(table), len(diffs), mean, worst, tolerance, result))
+        if worst > tolerance:
+            status = 1
+    return status
+
+
+if __name__ == '__main__':
+    sys.exit(main())
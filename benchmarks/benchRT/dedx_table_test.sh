@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# Regression test of the dedx tables of the DoseActor and LETActor: runs
+# mac/dedxTable.mac and compares the actors using the tables with the
+# same actors computing the dedx at each step (relative tolerance 0.5%
+# on the voxels above 1% of the maximum).
+#
+# Usage: dedx_table_test.sh [Gate source directory] [Gate binary]
+
+echo CTEST_FULL_OUTPUT
+
+if [ ! -z ${1+x} ]; then
+    cd $1/benchmarks/benchRT
+else
+    cd `dirname $0`
+fi
+
+GATE_BINARY=${2:-Gate}
+
+mkdir -p output
+rm -f output/dedxTable-*
+$GATE_BINARY mac/dedxTable.mac > output/dedxTable-log.txt 2>&1
+if [ $? -ne 0 ]; then
+    echo "Gate failed, see `pwd`/output/dedxTable-log.txt"
+    exit 1
+fi
+
+python3 dedx_table_compare.py output 0.005
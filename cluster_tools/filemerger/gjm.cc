@@ -27,7 +27,7 @@ void showhelp(){
  cout<<"  Usage: gjm [-options] your_file.split"<<endl;
  cout<<endl;
  cout<<"  You may give the name of the split file created by gjs (see inside the .Gate directory)."<<endl;
- cout<<"  !! This merger is only designed to ROOT output. !!"<<endl;
+ cout<<"  !! This merger is only designed to ROOT output and to the mhd images of the dose actors. !!"<<endl;
  cout<<endl;
  cout<<"  Options: "<<endl;
  cout<<"  -outDir path              : where to save the output files default is PWD"<<endl;
@@ -41,6 +41,7 @@ void showhelp(){
  cout<<"  -cleanonlyTest            : just tells you what will be erased by the -cleanonly"<<endl;
  cout<<"  -clean                    : merge and then do the cleanup automatically"<<endl;
  cout<<"  -fastMerge                : correct the output in each file, to be used with a TChain (only for Root output)"<<endl;
+ cout<<"  -j N                      : number of threads, the trees and the images are merged in parallel - 1 default"<<endl;
  cout<<endl;
  cout<<"  Environment variable: "<<endl;
  cout<<"  GC_DOT_GATE_DIR : points to the .Gate directory"<<endl<<endl;
@@ -58,6 +59,7 @@ int main(int argc,char** argv)
   bool          test   = false;
   bool          merge  = true;
   bool       fastMerge = false;
+  int         nThreads = 1;
 
   // Parse the command line
   if (argc==1) showhelp();
@@ -87,6 +89,14 @@ int main(int argc,char** argv)
        test  = true;
     } else if (!strcmp(argv[nextArg],"-fastMerge")){
        fastMerge=true;
+    } else if (!strcmp(argv[nextArg],"-j") && (nextArg+1)<argc){
+       nextArg++;
+       if(!isdigit(argv[nextArg][0]) ) {
+          cout<<"-j "<<argv[nextArg]<<" That's not a number!"<<endl;
+          exit(0);
+       }
+       nThreads=atoi(argv[nextArg]);
+       if(nThreads<1) nThreads=1;
     } else if (!strcmp(argv[nextArg],"-cleanonly")){
        clean = true;
        merge = false;
@@ -138,7 +148,7 @@ int main(int argc,char** argv)
   }
 
   //create a merge manager
-  GateMergeManager* manager = new GateMergeManager(fastMerge,verboseLevel,forced,maxRoot,outDir);
+  GateMergeManager* manager = new GateMergeManager(fastMerge,verboseLevel,forced,maxRoot,outDir,nThreads);
 
   if(merge) manager->StartMerging(splitfileName);
   if(clean) manager->StartCleaning(splitfileName,test);
@@ -0,0 +1,58 @@
+/*----------------------
+   GATE version name: gate_v...
+
+   Copyright (C): OpenGATE Collaboration
+
+This software is distributed under the terms
+of the GNU Lesser General  Public Licence (LGPL)
+See GATE/LICENSE.txt for further details
+----------------------*/
+
+
+#ifndef GateImageStatMerger_h
+#define GateImageStatMerger_h 1
+#include <string>
+#include <vector>
+
+// Merges the images written by the GateImageWithStatistic of several jobs:
+// value image <base>.mhd, and optionally <base>-Squared.mhd and
+// <base>-Uncertainty.mhd. The images are streamed by blocks of slices, so the
+// memory used does not depend on the number of jobs nor on the image size.
+//
+// The value and squared images of the jobs are sums over their events: they
+// are summed, and the relative uncertainty is recomputed from the sums and
+// the total number of events (as in GateImageWithStatistic). With
+// SetMeanImages(true), the images are per-event means: they are weighted by
+// the number of events of each job. When a job has no squared image, its sum
+// of squares is recovered from its uncertainty image and its number of events.
+class GateImageStatMerger
+{
+public:
+
+  GateImageStatMerger(int verboseLevel=1)
+    : m_verboseLevel(verboseLevel), m_meanImages(false), m_maxSlabVoxels(4*1024*1024) {};
+
+  // nEvents <= 0 if unknown (then the uncertainty can't be merged)
+  void AddJob(const std::string& valueImage,double nEvents);
+  void SetMeanImages(bool mean)          {m_meanImages=mean;};
+  // maximum number of voxels of a block of slices
+  void SetMaxSlabVoxels(size_t nVoxels)  {m_maxSlabVoxels=nVoxels;};
+
+  // writes outName, and its squared and uncertainty images if the first job has them
+  bool Merge(const std::string& outName);
+
+  static std::string SquaredName(const std::string& valueImage);
+  static std::string UncertaintyName(const std::string& valueImage);
+  // number of events written by a SimulationStatisticActor, 0 if not found
+  static double ReadNumberOfEvents(const std::string& statFileName);
+
+private:
+  int                      m_verboseLevel;
+  bool                     m_meanImages;
+  size_t                   m_maxSlabVoxels;
+  std::vector<std::string> m_jobImages;
+  std::vector<double>      m_jobEvents;
+};
+
+
+#endif
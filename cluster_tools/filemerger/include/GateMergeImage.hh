@@ -0,0 +1,63 @@
+/*----------------------
+   GATE version name: gate_v...
+
+   Copyright (C): OpenGATE Collaboration
+
+This software is distributed under the terms
+of the GNU Lesser General  Public Licence (LGPL)
+See GATE/LICENSE.txt for further details
+----------------------*/
+
+
+#ifndef GateMergeImage_h
+#define GateMergeImage_h 1
+#include <string>
+#include <vector>
+#include <fstream>
+
+// Minimal MetaImage (.mhd/.raw) reader/writer for the image outputs of the
+// actors: uncompressed MET_FLOAT or MET_DOUBLE data in a separate file, as
+// written by GATE. The voxel values are kept in double precision. The voxels
+// can be read and written by blocks of slices, so that large images are
+// merged in bounded memory.
+class GateMergeImage
+{
+public:
+
+  GateMergeImage() : m_nVoxels(0), m_sliceSize(0), m_isDouble(true) {};
+
+  // whole image
+  bool Read(const std::string& mhdName);
+  bool Write(const std::string& mhdName) const;
+
+  // header only, the voxels are then read with ReadVoxels
+  bool ReadHeader(const std::string& mhdName);
+  // reads n voxels starting at voxel first (the raw file is opened at each call)
+  bool ReadVoxels(size_t first,size_t n,double* dest) const;
+
+  // writes the header of mhdName (with this image size and type) and opens its raw file
+  bool WriteHeader(const std::string& mhdName,std::ofstream& raw) const;
+  // appends n voxels to the raw file, converted to the voxel type of the image
+  bool WriteVoxels(std::ofstream& raw,const double* src,size_t n) const;
+
+  // true if both images have the same size
+  bool IsCompatible(const GateMergeImage& other) const;
+
+  size_t GetNumberOfVoxels() const {return m_nVoxels;};
+  size_t GetSliceSize()      const {return m_sliceSize;};
+  std::vector<double>&       GetData()       {return m_data;};
+  const std::vector<double>& GetData() const {return m_data;};
+
+private:
+  std::vector<std::string> m_headerKeys;     // header lines, in file order
+  std::vector<std::string> m_headerValues;
+  std::string             m_dimSize;         // DimSize value, to check compatibility
+  std::string             m_rawName;         // raw data file, with its directory
+  size_t                  m_nVoxels;
+  size_t                  m_sliceSize;       // number of voxels of a slice (all but the last dimension)
+  bool                    m_isDouble;        // MET_DOUBLE (true) or MET_FLOAT (false)
+  std::vector<double>     m_data;
+};
+
+
+#endif
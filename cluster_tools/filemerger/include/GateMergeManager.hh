@@ -22,13 +22,15 @@ class GateMergeManager
 {
 public:
 
-  GateMergeManager(bool fastMerge,int verboseLevel,bool forced,Long64_t maxRoot,std::string outDir){
+  GateMergeManager(bool fastMerge,int verboseLevel,bool forced,Long64_t maxRoot,std::string outDir,int nThreads=1){
      m_verboseLevel = verboseLevel;
      m_forced       =       forced;
      m_maxRoot      =      maxRoot;
      m_outDir       =       outDir;
      m_CompLevel    =            1;
      m_fastMerge    =    fastMerge;
+     m_nThreads     =     nThreads;
+     filearr        =         NULL;
 
      //check if a .Gate directory can be found
      if (!getenv("GC_DOT_GATE_DIR")) {
@@ -48,28 +50,31 @@ public:
   };
   ~GateMergeManager()
   {
-   if (filearr) delete filearr;
+   if (filearr) delete [] filearr;
   }
 
 
   void StartMerging(std::string splitfileName);
   void ReadSplitFile(std::string splitfileName);
-  bool MergeTree(std::string name);
-  bool MergeGate(TChain* chain);
-  bool MergeSing(TChain* chain);
-  bool MergeCoin(TChain* chain);
+  bool MergeTree(std::string name,TFile* target=NULL);
+  bool MergeGate(TChain* chain,TFile* target);
+  bool MergeSing(TChain* chain,TFile* target);
+  bool MergeCoin(TChain* chain,TFile* target);
 
   // the cleanup after succesful merging
   void StartCleaning(std::string splitfileName,bool test);
 
   // the merging methods
   void MergeRoot();
+  void MergeImages();
 
 private:
   void FastMergeRoot(); 
   bool FastMergeGate(std::string name);
   bool FastMergeSing(std::string name);
   bool FastMergeCoin(std::string name); 
+  bool FastMergeIDs(std::string name,const std::vector<std::string>& idNames);
+  void ParallelMergeTrees(const std::vector<std::string>& treeNames);
   bool                 m_forced;             // if to overwrite existing files
   int            m_verboseLevel;  
   TFile**               filearr;
@@ -83,6 +88,9 @@ private:
   TFile*           m_RootTarget;             // root output file
   std::string  m_RootTargetName;             // name of target i.e. root output file
   bool              m_fastMerge;             // fast merge option, corrects the eventIDs locally
+  int                m_nThreads;             // number of merging threads
+  std::vector<std::string> m_vActorTypes;    // type of the actors of each job (same order in all jobs)
+  std::vector<std::string> m_vActorFileNames;// actor output names, m_Nfiles groups of actors
 };
 
 
@@ -0,0 +1,176 @@
+/*----------------------
+   GATE version name: gate_v...
+
+   Copyright (C): OpenGATE Collaboration
+
+This software is distributed under the terms
+of the GNU Lesser General  Public Licence (LGPL)
+See GATE/LICENSE.txt for further details
+----------------------*/
+
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+#include "GateImageStatMerger.hh"
+#include "GateMergeImage.hh"
+
+using namespace std;
+
+// <base>.mhd -> <base><suffix>.mhd
+static string AddSuffix(const string& name,const string& suffix){
+  size_t dot=name.rfind('.');
+  if(dot==string::npos) return name+suffix;
+  return name.substr(0,dot)+suffix+name.substr(dot);
+}
+
+static bool Exists(const string& name){
+  ifstream f(name.c_str());
+  return (bool)f;
+}
+
+/*******************************************************************************************/
+string GateImageStatMerger::SquaredName(const string& valueImage){
+  return AddSuffix(valueImage,"-Squared");
+}
+
+/*******************************************************************************************/
+string GateImageStatMerger::UncertaintyName(const string& valueImage){
+  return AddSuffix(valueImage,"-Uncertainty");
+}
+
+/*******************************************************************************************/
+double GateImageStatMerger::ReadNumberOfEvents(const string& statFileName){
+  ifstream stat(statFileName.c_str());
+  string line;
+  while(getline(stat,line)){
+     if(line.find("NumberOfEvents")==string::npos) continue;
+     size_t eq=line.find('=');
+     if(eq!=string::npos) return atof(line.c_str()+eq+1);
+  }
+  cout<<"No NumberOfEvents in "<<statFileName<<endl;
+  return 0;
+}
+
+/*******************************************************************************************/
+void GateImageStatMerger::AddJob(const string& valueImage,double nEvents){
+  m_jobImages.push_back(valueImage);
+  m_jobEvents.push_back(nEvents);
+}
+
+/*******************************************************************************************/
+bool GateImageStatMerger::Merge(const string& outName){
+
+  size_t nJobs=m_jobImages.size();
+  if(nJobs==0){
+     cout<<"No images to merge into "<<outName<<endl;
+     return false;
+  }
+
+  // headers of the images of the jobs
+  vector<GateMergeImage> values(nJobs),squared(nJobs),uncertainties(nJobs);
+  vector<bool> hasSquared(nJobs,false),hasUncertainty(nJobs,false);
+  double N=0;
+  bool eventsKnown=true;
+  for(size_t j=0;j<nJobs;j++){
+     if(!values[j].ReadHeader(m_jobImages[j])) return false;
+     if(!values[j].IsCompatible(values[0])){
+        cout<<"Image "<<m_jobImages[j]<<" does not match "<<m_jobImages[0]<<endl;
+        return false;
+     }
+     string name=SquaredName(m_jobImages[j]);
+     if(Exists(name)) hasSquared[j]=squared[j].ReadHeader(name)&&squared[j].IsCompatible(values[0]);
+     name=UncertaintyName(m_jobImages[j]);
+     if(Exists(name)) hasUncertainty[j]=uncertainties[j].ReadHeader(name)&&uncertainties[j].IsCompatible(values[0]);
+     if(m_jobEvents[j]>0) N+=m_jobEvents[j];
+     else eventsKnown=false;
+  }
+  if(m_meanImages&&!eventsKnown){
+     cout<<"The number of events of each job is needed to merge mean images: "<<outName<<endl;
+     return false;
+  }
+
+  // what can be merged
+  bool writeSquared=hasSquared[0];
+  bool writeUncertainty=hasUncertainty[0];
+  if(writeUncertainty&&!eventsKnown){
+     cout<<"The uncertainty of "<<outName<<" can't be merged without the number of events of the jobs"<<endl;
+     writeUncertainty=false;
+  }
+  for(size_t j=0;j<nJobs&&(writeSquared||writeUncertainty);j++){
+     if(hasSquared[j]) continue;
+     if(!hasUncertainty[j]||m_jobEvents[j]<=0){
+        cout<<"No squared image for "<<m_jobImages[j]<<", the uncertainty of "<<outName<<" is not merged"<<endl;
+        writeSquared=false;
+        writeUncertainty=false;
+     }
+  }
+  bool needSquared=writeSquared||writeUncertainty;
+
+  // outputs
+  ofstream valueRaw,squaredRaw,uncertaintyRaw;
+  if(!values[0].WriteHeader(outName,valueRaw)) return false;
+  if(writeSquared&&!squared[0].WriteHeader(SquaredName(outName),squaredRaw)) return false;
+  if(writeUncertainty&&!uncertainties[0].WriteHeader(UncertaintyName(outName),uncertaintyRaw)) return false;
+
+  // blocks of whole slices
+  size_t nVoxels=values[0].GetNumberOfVoxels();
+  size_t sliceSize=values[0].GetSliceSize();
+  size_t slabSize=(m_maxSlabVoxels/sliceSize)*sliceSize;
+  if(slabSize==0) slabSize=sliceSize;
+  if(slabSize>nVoxels) slabSize=nVoxels;
+  if(m_verboseLevel>1) cout<<"Merging "<<nJobs<<" images into "<<outName<<" by blocks of "
+                           <<slabSize/sliceSize<<" slices"<<endl;
+
+  vector<double> sum(slabSize),sumSquared(slabSize),buffer(slabSize),buffer2(slabSize);
+  for(size_t first=0;first<nVoxels;first+=slabSize){
+     size_t n=min(slabSize,nVoxels-first);
+     sum.assign(n,0.);
+     sumSquared.assign(n,0.);
+     for(size_t j=0;j<nJobs;j++){
+        // sums over the events of the job
+        double Nj=m_jobEvents[j];
+        double scale=m_meanImages?Nj:1.;
+        if(!values[j].ReadVoxels(first,n,&buffer[0])) return false;
+        for(size_t i=0;i<n;i++) sum[i]+=scale*buffer[i];
+        if(!needSquared) continue;
+        if(hasSquared[j]){
+           if(!squared[j].ReadVoxels(first,n,&buffer2[0])) return false;
+           for(size_t i=0;i<n;i++) sumSquared[i]+=scale*buffer2[i];
+        } else {
+           // inverse of u = sqrt((1/(N-1))*(q/N - (v/N)^2))/(v/N)
+           if(!uncertainties[j].ReadVoxels(first,n,&buffer2[0])) return false;
+           for(size_t i=0;i<n;i++){
+              double v=scale*buffer[i];
+              if(v==0.) continue;
+              double u=buffer2[i];
+              sumSquared[i]+=Nj*pow(v/Nj,2)*(u*u*(Nj-1)+1);
+           }
+        }
+     }
+
+     // uncertainty, as in GateImageWithStatistic::UpdateUncertaintyImage
+     if(writeUncertainty){
+        for(size_t i=0;i<n;i++){
+           if(sum[i]!=0. && N!=1 && sumSquared[i]!=0.)
+              buffer[i]=sqrt((1.0/(N-1))*(sumSquared[i]/N-pow(sum[i]/N,2)))/(sum[i]/N);
+           else buffer[i]=1;
+        }
+        if(!uncertainties[0].WriteVoxels(uncertaintyRaw,&buffer[0],n)) return false;
+     }
+     if(m_meanImages){
+        for(size_t i=0;i<n;i++){
+           sum[i]/=N;
+           sumSquared[i]/=N;
+        }
+     }
+     if(!values[0].WriteVoxels(valueRaw,&sum[0],n)) return false;
+     if(writeSquared&&!squared[0].WriteVoxels(squaredRaw,&sumSquared[0],n)) return false;
+  }
+  return true;
+}
+/*******************************************************************************************/
@@ -0,0 +1,180 @@
+/*----------------------
+   GATE version name: gate_v...
+
+   Copyright (C): OpenGATE Collaboration
+
+This software is distributed under the terms
+of the GNU Lesser General  Public Licence (LGPL)
+See GATE/LICENSE.txt for further details
+----------------------*/
+
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "GateMergeImage.hh"
+
+using namespace std;
+
+static string Trim(const string& s){
+  size_t b=s.find_first_not_of(" \t\r");
+  if(b==string::npos) return "";
+  size_t e=s.find_last_not_of(" \t\r");
+  return s.substr(b,e-b+1);
+}
+
+// directory part of a path, with its trailing '/'
+static string DirName(const string& path){
+  size_t pos=path.rfind('/');
+  if(pos==string::npos) return "";
+  return path.substr(0,pos+1);
+}
+
+static string BaseName(const string& path){
+  size_t pos=path.rfind('/');
+  if(pos==string::npos) return path;
+  return path.substr(pos+1);
+}
+
+/*******************************************************************************************/
+bool GateMergeImage::Read(const string& mhdName){
+  if(!ReadHeader(mhdName)) return false;
+  m_data.resize(m_nVoxels);
+  return ReadVoxels(0,m_nVoxels,&m_data[0]);
+}
+
+/*******************************************************************************************/
+bool GateMergeImage::Write(const string& mhdName) const{
+  ofstream raw;
+  if(!WriteHeader(mhdName,raw)) return false;
+  return WriteVoxels(raw,&m_data[0],m_nVoxels);
+}
+
+/*******************************************************************************************/
+bool GateMergeImage::ReadHeader(const string& mhdName){
+
+  ifstream mhd(mhdName.c_str());
+  if(!mhd){
+     cout<<"Can't open image header: "<<mhdName<<endl;
+     return false;
+  }
+
+  m_headerKeys.clear();
+  m_headerValues.clear();
+  m_data.clear();
+  m_nVoxels=0;
+  m_sliceSize=0;
+  m_rawName="";
+  string line;
+  while(getline(mhd,line)){
+     size_t eq=line.find('=');
+     if(eq==string::npos) continue;
+     string key  =Trim(line.substr(0,eq));
+     string value=Trim(line.substr(eq+1));
+     m_headerKeys.push_back(key);
+     m_headerValues.push_back(value);
+
+     if(key=="DimSize"){
+        m_dimSize=value;
+        stringstream ss(value);
+        size_t n=0;
+        m_nVoxels=1;
+        while(ss>>n) {
+           m_sliceSize=m_nVoxels;
+           m_nVoxels*=n;
+        }
+     } else if(key=="ElementType"){
+        if(value=="MET_DOUBLE")     m_isDouble=true;
+        else if(value=="MET_FLOAT") m_isDouble=false;
+        else {
+           cout<<"Unsupported element type "<<value<<" in "<<mhdName<<endl;
+           return false;
+        }
+     } else if(key=="CompressedData" && value=="True"){
+        cout<<"Compressed image data are not supported: "<<mhdName<<endl;
+        return false;
+     } else if((key=="BinaryDataByteOrderMSB"||key=="ElementByteOrderMSB") && value=="True"){
+        cout<<"Big endian image data are not supported: "<<mhdName<<endl;
+        return false;
+     } else if(key=="ElementDataFile"){
+        m_rawName=value;
+     }
+  }
+  if(m_rawName==""||m_nVoxels==0){
+     cout<<"Incomplete image header: "<<mhdName<<endl;
+     return false;
+  }
+  if(m_rawName[0]!='/') m_rawName=DirName(mhdName)+m_rawName;
+  return true;
+}
+
+/*******************************************************************************************/
+bool GateMergeImage::ReadVoxels(size_t first,size_t n,double* dest) const{
+
+  ifstream raw(m_rawName.c_str(),ios::binary);
+  if(!raw){
+     cout<<"Can't open image data: "<<m_rawName<<endl;
+     return false;
+  }
+  if(m_isDouble){
+     raw.seekg(first*sizeof(double));
+     raw.read((char*)dest,n*sizeof(double));
+  } else {
+     vector<float> buffer(n);
+     raw.seekg(first*sizeof(float));
+     raw.read((char*)&buffer[0],n*sizeof(float));
+     for(size_t i=0;i<n;i++) dest[i]=buffer[i];
+  }
+  if(!raw){
+     cout<<"Truncated image data: "<<m_rawName<<endl;
+     return false;
+  }
+  return true;
+}
+
+/*******************************************************************************************/
+bool GateMergeImage::WriteHeader(const string& mhdName,ofstream& raw) const{
+
+  string rawName=mhdName;
+  size_t dot=rawName.rfind('.');
+  if(dot!=string::npos) rawName=rawName.substr(0,dot);
+  rawName+=".raw";
+
+  ofstream mhd(mhdName.c_str());
+  if(!mhd){
+     cout<<"Can't write image header: "<<mhdName<<endl;
+     return false;
+  }
+  for(size_t i=0;i<m_headerKeys.size();i++){
+     if(m_headerKeys[i]=="ElementDataFile") continue; // must be the last line
+     mhd<<m_headerKeys[i]<<" = "<<m_headerValues[i]<<endl;
+  }
+  mhd<<"ElementDataFile = "<<BaseName(rawName)<<endl;
+
+  raw.open(rawName.c_str(),ios::binary|ios::trunc);
+  if(!raw){
+     cout<<"Can't write image data: "<<rawName<<endl;
+     return false;
+  }
+  return true;
+}
+
+/*******************************************************************************************/
+bool GateMergeImage::WriteVoxels(ofstream& raw,const double* src,size_t n) const{
+  if(m_isDouble){
+     raw.write((const char*)src,n*sizeof(double));
+  } else {
+     vector<float> buffer(src,src+n);
+     raw.write((const char*)&buffer[0],n*sizeof(float));
+  }
+  return !raw.fail();
+}
+
+/*******************************************************************************************/
+bool GateMergeImage::IsCompatible(const GateMergeImage& other) const{
+  return m_dimSize==other.m_dimSize && m_nVoxels==other.m_nVoxels;
+}
+/*******************************************************************************************/
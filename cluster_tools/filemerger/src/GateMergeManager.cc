@@ -28,19 +28,33 @@ See GATE/LICENSE.txt for further details
 #include <sstream>
 #include <vector>
 #include <cstdlib>
+#include <cstdio>
 #include <cmath>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 #include "GateMergeManager.hh"
+#include "GateImageStatMerger.hh"
 
 using namespace std;
 
+static bool EndsWith(const string& s,const string& end){
+  return s.length()>=end.length() && s.compare(s.length()-end.length(),end.length(),end)==0;
+}
+
 void GateMergeManager::StartMerging(string splitfileName){
 
   // get the files to merge
   ReadSplitFile(splitfileName);
+  // each thread works on its own files
+  if(m_nThreads>1) ROOT::EnableThreadSafety();
   //do the merging
-  if (m_fastMerge==true) FastMergeRoot();
-  else MergeRoot();
+  if(m_vRootFileNames.size()>0||m_vActorFileNames.size()==0) {
+     if (m_fastMerge==true) FastMergeRoot();
+     else MergeRoot();
+  }
+  if(m_vActorFileNames.size()>0) MergeImages();
 
   //if we are here the merging has been successful
   //we mark the directory as ready for cleanup
@@ -61,7 +75,7 @@ void GateMergeManager::ReadSplitFile(string splitfileName){
   };
 
   //avoid multiple calls
-  if(m_vRootFileNames.size()>0) return;
+  if(m_vRootFileNames.size()>0||m_vActorFileNames.size()>0) return;
 
   stringstream ssnfiles;
   char cline[512];
@@ -99,6 +113,15 @@ void GateMergeManager::ReadSplitFile(string splitfileName){
         }
         if(m_verboseLevel>2) cout<<"Root output file name: "<<m_RootTargetName<<endl;
      }
+     // actor output files: "Actor filename: type name"
+     else if(!strncmp(cline,"Actor filename:",15)){
+        stringstream ssactor(cline+15);
+        string type,name;
+        ssactor>>type>>name;
+        m_vActorTypes.push_back(type);
+        m_vActorFileNames.push_back(name);
+        if(m_verboseLevel>2) cout<<"Actor "<<type<<" output file name: "<<name<<endl;
+     }
   }
 
   // check if number of root files correct
@@ -297,8 +320,11 @@ void GateMergeManager::MergeRoot(){
    }
 
    //now we take care of the trees
-   for(unsigned int i=0;i<treeNames.size();i++) 
-     if(!MergeTree(treeNames[i])) if(m_verboseLevel>1) cout<<"Problem with merging "<<treeNames[i]<<endl; 
+   if(m_nThreads>1 && treeNames.size()>1 && m_maxRoot==0) ParallelMergeTrees(treeNames);
+   else {
+     for(unsigned int i=0;i<treeNames.size();i++) 
+       if(!MergeTree(treeNames[i])) if(m_verboseLevel>1) cout<<"Problem with merging "<<treeNames[i]<<endl; 
+   }
 
    // everything is done
 }
@@ -355,9 +381,10 @@ void GateMergeManager::StartCleaning(string splitfileName,bool test){
 
 /*******************************************************************************************/
 //find out what kind of tree we have and call the right merger
-bool GateMergeManager::MergeTree(string chainName){
+bool GateMergeManager::MergeTree(string chainName,TFile* target){
 if (m_fastMerge==false)
  {
+   if(target==NULL) target=m_RootTarget;
    TChain* chain = new TChain(chainName.c_str());
 
    // number of files to merge
@@ -370,7 +397,7 @@ if (m_fastMerge==false)
       return false;
    }
 
-   if(chainName=="Gate") MergeGate(chain);
+   if(chainName=="Gate") MergeGate(chain,target);
 
    if(chain->FindBranch("eventID1")!=NULL) {
      if(  (chain->FindBranch("runID")==NULL)
@@ -380,7 +407,7 @@ if (m_fastMerge==false)
         return false;
      }
      // coincidence
-     return MergeCoin(chain);
+     return MergeCoin(chain,target);
 
    } else if(  (chain->FindBranch("runID")==NULL)||(chain->FindBranch("eventID")==NULL)
                                                   ||(chain->FindBranch("time")==NULL) )
@@ -389,7 +416,7 @@ if (m_fastMerge==false)
              return false;
             }
            // Singles or Hits
-           return MergeSing(chain);
+           return MergeSing(chain,target);
    }
    else
    {
@@ -460,101 +487,260 @@ for(int j=0;j<m_Nfiles;j++)
 /*******************************************************************************************/
 bool GateMergeManager::FastMergeSing(string name)
 {
-int eventID = 0;
-int runID = 0; 
-int offset      = 0;
-int currentfile = 0;
-float lastRun =-1;
-string clusterName=name+"_cluster"; 
+  vector<string> idNames(1,"eventID");
+  return FastMergeIDs(name,idNames);
+}
 
-for(int j=0;j<m_Nfiles;j++)
- {
-   filearr[j]->ReOpen("UPDATE");
-   TTree *oldTree = (TTree*)gDirectory->Get(name.c_str());
-   TBranch *branch  = oldTree->GetBranch("eventID");
-   branch->SetAddress(&eventID);
-   TBranch *branch2  = oldTree->GetBranch("runID");
-   branch2->SetAddress(&runID);
-   TBranch* newBranch=oldTree->Branch("eventIDcluster",&eventID,"eventID/I");
+/*******************************************************************************************/
+bool GateMergeManager::FastMergeCoin(string name)
+{
+  vector<string> idNames;
+  idNames.push_back("eventID1");
+  idNames.push_back("eventID2");
+  if(m_verboseLevel>0) cout<<"starting coincidence merging..."<<endl;
+  return FastMergeIDs(name,idNames);
+}
 
-   Int_t nentries=(Int_t)oldTree->GetEntries();
+/*******************************************************************************************/
+// Adds to the tree of each file a "<id>cluster" branch for each of the given eventID
+// branches. The eventIDs are shifted by the sum of the latest eventIDs of the previous
+// files, until the runID changes (the following runs are not shifted), as in MergeSing.
+// The offset and runID carried from one file to the next only depend on the first, last,
+// minimum and maximum runIDs of the files: they are computed first, then the files are
+// corrected in parallel, each thread working on its own files.
+bool GateMergeManager::FastMergeIDs(string name,const vector<string>& idNames)
+{
+   vector<TTree*> trees(m_Nfiles,(TTree*)NULL);
+   vector<int> startOffset(m_Nfiles,0);
+   vector<int> startRun(m_Nfiles,-1);
+   int offset  = 0;
+   int lastRun =-1;
+   for(int j=0;j<m_Nfiles;j++){
+      filearr[j]->ReOpen("UPDATE");
+      trees[j] = (TTree*)filearr[j]->Get(name.c_str());
+      if(trees[j]==NULL){
+         cout<<"No tree "<<name<<" in "<<m_vRootFileNames[j]<<endl;
+         return false;
+      }
+      if(j>0) offset+=m_lastEvents[j];
+      startOffset[j]=offset;
+      startRun[j]=lastRun;
+
+      Long64_t nentries=trees[j]->GetEntries();
+      if(nentries<=0) continue;
+      int runID=0;
+      TBranch* runBranch=trees[j]->GetBranch("runID");
+      runBranch->SetAddress(&runID);
+      runBranch->GetEntry(0);
+      int firstRun=runID;
+      runBranch->GetEntry(nentries-1);
+      if(firstRun!=lastRun
+         ||trees[j]->GetMinimum("runID")!=trees[j]->GetMaximum("runID")) offset=0;
+      lastRun=runID;
+      trees[j]->ResetBranchAddresses();
+   }
 
-   if (j==0) offset=0;
-   else offset+=m_lastEvents[currentfile];
-   currentfile++;
+   atomic<int> nextFile(0);
+   auto worker=[&](){
+      int j;
+      while((j=nextFile++)<m_Nfiles){
+         if(m_verboseLevel>1) cout<<"working on file..."<<j<<endl;
+         TTree* oldTree=trees[j];
+         int runID=0;
+         vector<int> ids(idNames.size(),0);
+         vector<TBranch*> branches(idNames.size());
+         vector<TBranch*> newBranches(idNames.size());
+         TBranch* runBranch=oldTree->GetBranch("runID");
+         runBranch->SetAddress(&runID);
+         for(unsigned int k=0;k<idNames.size();k++){
+            branches[k]=oldTree->GetBranch(idNames[k].c_str());
+            branches[k]->SetAddress(&ids[k]);
+            newBranches[k]=oldTree->Branch((idNames[k]+"cluster").c_str(),&ids[k],(idNames[k]+"/I").c_str());
+         }
 
-   for(int i=0;i<nentries;i++)
-     {
-      branch->GetEvent(i);
-      if(lastRun!=runID)
-        {
-         lastRun=runID;
-         offset=0;
-        }
-      eventID+=offset;
-      newBranch->Fill();
-    }
-  oldTree->Write();
-  }
-  return true;
+         int fileOffset =startOffset[j];
+         int fileLastRun=startRun[j];
+         Long64_t nentries=oldTree->GetEntries();
+         for(Long64_t i=0;i<nentries;i++){
+            runBranch->GetEntry(i);
+            for(unsigned int k=0;k<idNames.size();k++) branches[k]->GetEntry(i);
+            if(fileLastRun!=runID){
+               fileLastRun=runID;
+               fileOffset=0;
+            }
+            for(unsigned int k=0;k<idNames.size();k++){
+               ids[k]+=fileOffset;
+               newBranches[k]->Fill();
+            }
+         }
+         oldTree->Write();
+      }
+   };
+   int nthreads=min(m_nThreads,m_Nfiles);
+   if(nthreads<=1) worker();
+   else {
+      vector<thread> threads;
+      for(int t=0;t<nthreads;t++) threads.push_back(thread(worker));
+      for(int t=0;t<nthreads;t++) threads[t].join();
+   }
+   return true;
 }
 
 /*******************************************************************************************/
-bool GateMergeManager::FastMergeCoin(string name)
+// Each tree is merged by a thread into its own temporary file, the merged trees are then
+// copied into the target without decompressing their baskets
+void GateMergeManager::ParallelMergeTrees(const vector<string>& treeNames)
 {
-//create the output file
-int eventID1 = 0;
-int eventID2 = 0;
-int runID = 0;
-int offset      = 0;
-int currentfile = 0;
-float lastRun =-1;
-string clusterName=name+"_cluster";
-cout<<"starting coincidence merging..."<<endl;
-for(int j=0;j<m_Nfiles;j++)
- {
-cout<<"working on file..."<<j<<endl;
-   filearr[j]->ReOpen("UPDATE");
-   TTree *oldTree = (TTree*)gDirectory->Get(name.c_str());
-   TBranch *branch1  = oldTree->GetBranch("eventID1");
-   branch1->SetAddress(&eventID1);
-   TBranch *branch2  = oldTree->GetBranch("eventID2");
-   branch2->SetAddress(&eventID2);
-   TBranch *branch3  = oldTree->GetBranch("runID");
-   branch3->SetAddress(&runID);
+   unsigned int ntrees=treeNames.size();
+   vector<string> tmpNames(ntrees);
+   vector<int> merged(ntrees,0);
+   atomic<unsigned int> nextTree(0);
+
+   auto worker=[&](){
+      unsigned int i;
+      while((i=nextTree++)<ntrees){
+         tmpNames[i]=m_RootTargetName+"."+treeNames[i]+".tmp";
+         TFile* tmp=TFile::Open(tmpNames[i].c_str(),"RECREATE");
+         if(tmp==NULL){
+            cout<<"Can't create the temporary file "<<tmpNames[i]<<endl;
+            continue;
+         }
+         tmp->SetCompressionLevel(m_CompLevel);
+         merged[i]=MergeTree(treeNames[i],tmp);
+         tmp->Close();
+         delete tmp;
+      }
+   };
+   int nthreads=min(m_nThreads,(int)ntrees);
+   vector<thread> threads;
+   for(int t=0;t<nthreads;t++) threads.push_back(thread(worker));
+   for(int t=0;t<nthreads;t++) threads[t].join();
+
+   for(unsigned int i=0;i<ntrees;i++){
+      if(!merged[i]) if(m_verboseLevel>1) cout<<"Problem with merging "<<treeNames[i]<<endl;
+      if(tmpNames[i]=="") continue;
+      TFile* tmp=TFile::Open(tmpNames[i].c_str(),"OLD");
+      if(tmp!=NULL){
+         // the Gate tree is written even if MergeTree reports a problem
+         TTree* tree=(TTree*)tmp->Get(treeNames[i].c_str());
+         if(tree!=NULL){
+            m_RootTarget->cd();
+            TTree* copy=tree->CloneTree(-1,"fast");
+            copy->Write();
+            delete copy;
+         }
+         tmp->Close();
+         delete tmp;
+      }
+      remove(tmpNames[i].c_str());
+   }
+}
 
-   TBranch* newBranch1=oldTree->Branch("eventID1cluster",&eventID1,"eventID1/I");
-   TBranch* newBranch2=oldTree->Branch("eventID2cluster",&eventID2,"eventID2/I");
+/*******************************************************************************************/
+// Merges the image outputs of the actors. The relative uncertainty images are recomputed
+// from the summed value and squared images with the total number of events, which is
+// read from the output of a SimulationStatisticActor.
+void GateMergeManager::MergeImages()
+{
+   int nActors=m_vActorFileNames.size()/m_Nfiles;
+   if(nActors*m_Nfiles!=(int)m_vActorFileNames.size()){
+      cout<<"Inconsistent number of actor entries in split file!"<<endl;
+      exit(0);
+   }
 
-   Int_t nentries=(Int_t)oldTree->GetEntries();
+   // actors whose images are sums over the events
+   static const char* additiveActors[]={"DoseActor","TLEDoseActor","NTLEDoseActor",
+                                        "SETLEDoseActor","KermaActor","NeutronKermaActor",
+                                        "FluenceActor","TLFluenceActor"};
+   const int nAdditiveActors=sizeof(additiveActors)/sizeof(additiveActors[0]);
+
+   // number of events of each job
+   vector<double> jobEvents(m_Nfiles,0.);
+   for(int k=0;k<nActors;k++){
+      if(m_vActorTypes[k]!="SimulationStatisticActor") continue;
+      for(int j=0;j<m_Nfiles;j++)
+         jobEvents[j]=GateImageStatMerger::ReadNumberOfEvents(m_vActorFileNames[j*nActors+k]);
+      break;
+   }
 
-   if (j==0) offset=0;
-   else offset+=m_lastEvents[currentfile];
-   cout<<"the offset in this file is: "<<offset<<endl;
-   currentfile++;
+   // list of the value images: [image][job], their squared and uncertainty images are
+   // merged with them
+   vector< vector<string> > jobImages;
+   vector<string> outNames;
+   for(int k=0;k<nActors;k++){
+      bool additive=false;
+      for(int a=0;a<nAdditiveActors;a++) if(m_vActorTypes[k]==additiveActors[a]) additive=true;
+      if(!additive) {
+         if(m_vActorTypes[k]!="SimulationStatisticActor" && m_verboseLevel>0)
+            cout<<"Outputs of "<<m_vActorTypes[k]<<" are not merged: "<<m_vActorFileNames[k]<<endl;
+         continue;
+      }
+      string first=m_vActorFileNames[k];
+      size_t dot=first.rfind('.');
+      if(dot==string::npos||first.substr(dot)!=".mhd"){
+         if(m_verboseLevel>0) cout<<"Only mhd images are merged, skipping "<<first<<endl;
+         continue;
+      }
+      // the images of the first job: <base>1.mhd and <base>1-<suffix>.mhd
+      string base1=first.substr(0,dot);
+      vector<string> suffixes;
+      glob_t globbuf;
+      if(glob((base1+"-*.mhd").c_str(),0,NULL,&globbuf)==0){
+         for(size_t g=0;g<globbuf.gl_pathc;g++){
+            string name=globbuf.gl_pathv[g];
+            string suffix=name.substr(base1.length(),name.length()-base1.length()-4);
+            if(EndsWith(suffix,"-Squared")||EndsWith(suffix,"-Uncertainty")) continue;
+            suffixes.push_back(suffix);
+         }
+      }
+      globfree(&globbuf);
+      ifstream plain(first.c_str());
+      if(plain) suffixes.push_back("");
+
+      // name of the merged image: the split number "1" is removed
+      string base=base1.substr(0,base1.length()-1);
+      if(m_outDir!=""){
+         size_t pos=base.rfind('/');
+         base=m_outDir+(pos==string::npos?base:base.substr(pos+1));
+      }
+      for(unsigned int s=0;s<suffixes.size();s++){
+         vector<string> names(m_Nfiles);
+         for(int j=0;j<m_Nfiles;j++){
+            string job=m_vActorFileNames[j*nActors+k];
+            names[j]=job.substr(0,job.rfind('.'))+suffixes[s]+".mhd";
+         }
+         jobImages.push_back(names);
+         outNames.push_back(base+suffixes[s]+".mhd");
+      }
+   }
 
-   for(int i=0;i<nentries;i++){
-       branch1->GetEvent(i);
-       branch2->GetEvent(i);
-       branch3->GetEvent(i);
-       if(lastRun!=runID) 
-        {
-         lastRun=runID;
-         offset=0; 
-        }
-       eventID1+=offset;
-       eventID2+=offset;
-       newBranch1->Fill();
-       newBranch2->Fill();
-    }
-    oldTree->Write();
- }
-    return true;
+   // each image is streamed by one thread
+   atomic<unsigned int> next(0);
+   auto worker=[&](){
+      unsigned int i;
+      while((i=next++)<outNames.size()){
+         if(!m_forced){
+            ifstream exists(outNames[i].c_str());
+            if(exists){
+               cout<<"The image "<<outNames[i]<<" already exists! Try -f to overwrite it."<<endl;
+               continue;
+            }
+         }
+         GateImageStatMerger merger(m_verboseLevel);
+         for(int j=0;j<m_Nfiles;j++) merger.AddJob(jobImages[i][j],jobEvents[j]);
+         if(!merger.Merge(outNames[i])) cout<<"Problem with merging "<<outNames[i]<<endl;
+         else if(m_verboseLevel>0) cout<<"Merged "<<outNames[i]<<endl;
+      }
+   };
+   int nthreads=max(1,min(m_nThreads,(int)outNames.size()));
+   vector<thread> threads;
+   for(int t=0;t<nthreads;t++) threads.push_back(thread(worker));
+   for(int t=0;t<nthreads;t++) threads[t].join();
 }
 
 /*******************************************************************************************/
 // Gate tree merger
-bool GateMergeManager::MergeGate(TChain* chainG) {
+bool GateMergeManager::MergeGate(TChain* chainG,TFile* target) {
 
    int nentries=chainG->GetEntries();   
 
@@ -565,7 +751,7 @@ bool GateMergeManager::MergeGate(TChain* chainG) {
 
    //create the new tree
    //Allow for large files and do not write every bit separately
-   m_RootTarget->cd();
+   target->cd();
    TTree * newTree = chainG->CloneTree(0);
    newTree->SetAutoSave(2000000000);
    if(m_maxRoot!=0) newTree->SetMaxTreeSize(m_maxRoot);
@@ -630,7 +816,7 @@ bool GateMergeManager::MergeGate(TChain* chainG) {
 
 /*******************************************************************************************/
 // Singles and Hits tree merger
-bool GateMergeManager::MergeSing(TChain* chainS){
+bool GateMergeManager::MergeSing(TChain* chainS,TFile* target){
 
    int nentriesS=chainS->GetEntries();
 
@@ -642,7 +828,7 @@ bool GateMergeManager::MergeSing(TChain* chainS){
    chainS->SetBranchAddress("runID",&runID);
    chainS->SetBranchAddress("time",&time);
 
-   m_RootTarget->cd();
+   target->cd();
    TTree * newSing = chainS->CloneTree(0);
    newSing->SetAutoSave(2000000000);
    if(m_maxRoot!=0) newSing->SetMaxTreeSize(m_maxRoot);
@@ -687,7 +873,7 @@ bool GateMergeManager::MergeSing(TChain* chainS){
 
 /*******************************************************************************************/
 // Coincidences tree merger
-bool GateMergeManager::MergeCoin(TChain* chainC){
+bool GateMergeManager::MergeCoin(TChain* chainC,TFile* target){
 
    int nentriesC=chainC->GetEntries();
 
@@ -702,7 +888,7 @@ bool GateMergeManager::MergeCoin(TChain* chainC){
     int runID    = 0;
     chainC->SetBranchAddress("runID",&runID);
 
-    m_RootTarget->cd();
+    target->cd();
     TTree * newCoin = chainC->CloneTree(0);
     newCoin->SetAutoSave(2000000000);
     if(m_maxRoot!=0) newCoin->SetMaxTreeSize(m_maxRoot);
@@ -0,0 +1,152 @@
+/*----------------------
+   GATE version name: gate_v...
+
+   Copyright (C): OpenGATE Collaboration
+
+This software is distributed under the terms
+of the GNU Lesser General  Public Licence (LGPL)
+See GATE/LICENSE.txt for further details
+----------------------*/
+
+
+#include <string>
+#include <cstring>
+#include <ctype.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include "GateImageStatMerger.hh"
+using namespace std;
+
+void showhelp(){
+
+ cout<<endl;
+ cout<<"  +-------------------------------------------+"<<endl;
+ cout<<"  | gim -- The GATE image output merger       |"<<endl;
+ cout<<"  +-------------------------------------------+"<<endl;
+ cout<<endl;
+ cout<<"  Usage: gim [-options] -o merged.mhd job1.mhd [-stat job1_stat.txt] job2.mhd [-stat job2_stat.txt] ..."<<endl;
+ cout<<"         gim [-options] -o merged.mhd -l jobs.list"<<endl;
+ cout<<endl;
+ cout<<"  Merges the value images written by the image actors of several jobs, with their"<<endl;
+ cout<<"  -Squared and -Uncertainty images. The images are read by blocks of slices."<<endl;
+ cout<<"  The number of events of the jobs (from a SimulationStatisticActor output) is"<<endl;
+ cout<<"  needed to merge the uncertainty."<<endl;
+ cout<<endl;
+ cout<<"  Options: "<<endl;
+ cout<<"  -o file                   : name of the merged image"<<endl;
+ cout<<"  -stat file                : SimulationStatisticActor output of the previous image"<<endl;
+ cout<<"  -l file                   : list of the images, one per line: image.mhd [stat_file|number_of_events]"<<endl;
+ cout<<"  -mean                     : the images are per-event means, they are weighted by the number of events"<<endl;
+ cout<<"  -mem MB                   : memory used for the blocks of slices - 128 default"<<endl;
+ cout<<"  -v                        : verbosity 0 1 2 - 1 default "<<endl;
+ cout<<"  -f                        : forced output - an existing output file will be overwritten"<<endl;
+ cout<<endl;
+ exit(0);
+}
+
+// number of events given as a number or as a SimulationStatisticActor output
+double ParseEvents(const string& s){
+  char* end=NULL;
+  double n=strtod(s.c_str(),&end);
+  if(end!=s.c_str()&&*end=='\0') return n;
+  return GateImageStatMerger::ReadNumberOfEvents(s);
+}
+
+int main(int argc,char** argv)
+{
+  string         outName ="";
+  int       verboseLevel = 1;
+  bool            forced = false;
+  bool        meanImages = false;
+  size_t           memMB = 128;
+  vector<string>  images;
+  vector<double>  events;
+
+  // Parse the command line
+  if (argc==1) showhelp();
+  int nextArg=1;
+  while (nextArg<argc) {
+    if (!strcmp(argv[nextArg],"-v") && (nextArg+1)<argc){
+       nextArg++;
+       if(!isdigit(argv[nextArg][0]) ) {
+          cout<<"-v "<<argv[nextArg]<<" That's not a number!"<<endl;
+          exit(0);
+       }
+       verboseLevel=atoi(argv[nextArg]);
+    } else if (!strcmp(argv[nextArg],"-o") && (nextArg+1)<argc){
+       nextArg++;
+       outName=argv[nextArg];
+    } else if (!strcmp(argv[nextArg],"-stat") && (nextArg+1)<argc){
+       nextArg++;
+       if(images.empty()){
+          cout<<"-stat "<<argv[nextArg]<<" must follow an image!"<<endl;
+          exit(0);
+       }
+       events.back()=GateImageStatMerger::ReadNumberOfEvents(argv[nextArg]);
+    } else if (!strcmp(argv[nextArg],"-l") && (nextArg+1)<argc){
+       nextArg++;
+       ifstream list(argv[nextArg]);
+       if(!list){
+          cout<<"Can't open list file "<<argv[nextArg]<<endl;
+          exit(0);
+       }
+       string line;
+       while(getline(list,line)){
+          stringstream ss(line);
+          string image,nEvents;
+          if(!(ss>>image)||image[0]=='#') continue;
+          images.push_back(image);
+          events.push_back(ss>>nEvents?ParseEvents(nEvents):0.);
+       }
+    } else if (!strcmp(argv[nextArg],"-mean")){
+       meanImages=true;
+    } else if (!strcmp(argv[nextArg],"-mem") && (nextArg+1)<argc){
+       nextArg++;
+       if(!isdigit(argv[nextArg][0]) ) {
+          cout<<"-mem "<<argv[nextArg]<<" That's not a number!"<<endl;
+          exit(0);
+       }
+       memMB=atol(argv[nextArg]);
+    } else if (!strcmp(argv[nextArg],"-f")){
+       forced=true;
+    } else if (!strcmp(argv[nextArg],"-h")
+             ||!strcmp(argv[nextArg],"-help")) {
+       showhelp();
+    } else if (strstr(argv[nextArg],".mhd")){
+       images.push_back(argv[nextArg]);
+       events.push_back(0.);
+    } else {
+       cout<<"Not a valid argument: "<<argv[nextArg]<<endl;
+       showhelp();
+    }
+    nextArg++;
+  }
+
+  if(outName==""||images.empty()){
+     cout<<"No output name or no images to merge!"<<endl;
+     exit(0);
+  }
+  if(!forced){
+     ifstream exists(outName.c_str());
+     if(exists){
+        cout<<"The image "<<outName<<" already exists! Try -f to overwrite it."<<endl;
+        exit(0);
+     }
+  }
+
+  // four blocks of doubles are held in memory
+  GateImageStatMerger merger(verboseLevel);
+  merger.SetMeanImages(meanImages);
+  merger.SetMaxSlabVoxels(memMB*1024*1024/(4*sizeof(double)));
+  for(unsigned int i=0;i<images.size();i++) merger.AddJob(images[i],events[i]);
+
+  if(verboseLevel>0) cout<<"Combining "<<images.size()<<" images -> "<<outName<<endl;
+  if(!merger.Merge(outName)){
+     cout<<"Problem with merging "<<outName<<endl;
+     return 1;
+  }
+  return 0;
+}
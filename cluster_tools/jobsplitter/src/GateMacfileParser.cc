@@ -926,7 +926,10 @@ void GateMacfileParser::SearchForActors(G4int splitNumber,ofstream& output, ofst
     if (findInList)
     {
       AddSplitNumberWithExtension(splitNumber);
-      AddPWD("/gate/actor/"+actorName+"/save");
+      G4String key = "/gate/actor/"+actorName+"/save";
+      AddPWD(key);
+      // recorded for gjm, which sums the image outputs of the jobs
+      splitfile<<"Actor filename: "<<listOfEnabledActorType.back()<<" "<<macline.substr(key.length()+1)<<endl;
     }
     // Else, it is an error, this actor does not exist !
     else
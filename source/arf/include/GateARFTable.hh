@@ -67,6 +67,7 @@ private:
   G4double mTotalNumberOfPhotons; /* total number of simulated photons for this incident energy window */
   long unsigned int mBinnedPhotonCounter; /*  the number of binned photons */
   int mPhiCounts;
+  G4bool mIsShared; /* _ArfTableVector points to a shared file, not owned */
 
 public:
   GateARFTable(const G4String & aName);
@@ -154,8 +155,11 @@ public:
   ;
   void InitializePhi();
   void InitializeCosTheta();
+  void InitializeGrids();
   void Describe();
   void Initialize(const G4double & energyLow, const G4double & energyHigh);
+  /* the buffer is laid out as by GetARFAsBinaryBuffer, and must outlive the table */
+  void InitializeFromSharedBuffer(const G4double* tableBuffer);
   G4int GetIndexes(const G4double & x, const G4double & y, G4int& theta, G4int& phi);
   void NormalizeTable();
   G4double RetrieveProbability(const G4double & x, const G4double & y);
@@ -10,6 +10,7 @@
 #include "globals.hh"
 #include<map>
 #include "G4ThreeVector.hh"
+#include "GateSharedFile.hh"
 class GateARFSD;
 class GateARFTable;
 class GateARFTableMgrMessenger;
@@ -35,6 +36,8 @@ private:
   G4int mLoadArfTables;
   G4String mBinaryFilename;
   G4int mNumberOfBins;
+  GateSharedFile mSharedTables;
+  G4bool LoadSharedARFTables(const G4String & binaryFilename);
 public:
   GateARFTableMgr(const G4String & aName, GateARFSD* arfSD);
   ~GateARFTableMgr();
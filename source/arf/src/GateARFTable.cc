@@ -46,6 +46,7 @@ GateARFTable::GateARFTable(const G4String & aName) :
   _TotalNumberbOfThetaPhi = _NumberOfCosTheta * _NumberOfTanPhi;
   mBinnedPhotonCounter = 0;
   mPhiCounts = 0;
+  mIsShared = false;
   mStep1 = 0.010 / (_NumberOfCosTheta * 0.5);
   mStep2 = 0.040 / _NumberOfTanPhi;
   mStep3 = 0.20 / (_NumberOfTanPhi * 0.5);
@@ -83,7 +84,7 @@ GateARFTable::GateARFTable(const G4String & aName) :
 
 GateARFTable::~GateARFTable()
   {
-  if (_ArfTableVector != 0)
+  if (_ArfTableVector != 0 && !mIsShared)
     {
     delete[] _ArfTableVector;
     }
@@ -179,22 +180,13 @@ void GateARFTable::Initialize(const G4double & energyLow, const G4double & energ
   {
   _EnergyLowUser = energyLow; /* window energy specified by the user */
   _EnergyHighUser = energyHigh;
-  if (_CosThetaVector != 0)
-    {
-    delete[] _CosThetaVector;
-    }
-  _CosThetaVector = new G4double[_NumberOfCosTheta];
-  _CosThetaIVector = new G4double[_NumberOfCosTheta];
-  _ThetaVector = new G4double[_NumberOfCosTheta];
-  G4cout.precision(10);
+  InitializeGrids();
 
-  InitializeCosTheta();
-  InitializePhi();
-
-  if (_ArfTableVector != 0)
+  if (_ArfTableVector != 0 && !mIsShared)
     {
     delete[] _ArfTableVector;
     }
+  mIsShared = false;
   _ArfTableVector = new G4double[_TotalNumberbOfThetaPhi];
   _DrfTableVector = new G4double[_DrfTableDimensionX * _DrfTableDimensionY];
   _LowX = -.5 * G4double(_DrfTableDimensionX) * _DrfBinSize;
@@ -210,6 +202,41 @@ void GateARFTable::Initialize(const G4double & energyLow, const G4double & energ
   G4cout << " Initialized ARF Table " << GetName() << Gateendl;
   }
 
+void GateARFTable::InitializeGrids()
+  {
+  if (_CosThetaVector != 0)
+    {
+    delete[] _CosThetaVector;
+    }
+  _CosThetaVector = new G4double[_NumberOfCosTheta];
+  _CosThetaIVector = new G4double[_NumberOfCosTheta];
+  _ThetaVector = new G4double[_NumberOfCosTheta];
+  G4cout.precision(10);
+
+  InitializeCosTheta();
+  InitializePhi();
+  }
+
+/* the probabilities are read in place, and the DRF table which is only
+ needed to compute them is not allocated */
+void GateARFTable::InitializeFromSharedBuffer(const G4double* tableBuffer)
+  {
+  InitializeGrids();
+  if (_ArfTableVector != 0 && !mIsShared)
+    {
+    delete[] _ArfTableVector;
+    }
+  _EnergyLow = tableBuffer[0];
+  _EnergyHigh = tableBuffer[1];
+  mEnergyResolution = tableBuffer[2];
+  mEnergyReference = tableBuffer[3];
+  _EnergyLowUser = tableBuffer[4];
+  _EnergyHighUser = tableBuffer[5];
+  _ArfTableVector = const_cast<G4double*>(tableBuffer + 6);
+  mIsShared = true;
+  G4cout << " Initialized ARF Table " << GetName() << " from shared memory" << Gateendl;
+  }
+
 G4double GateARFTable::RetrieveProbability(const G4double & x, const G4double & y)
   {
   G4int theta = 0;
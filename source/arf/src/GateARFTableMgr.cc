@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include "G4ThreeVector.hh"
 #include "G4RotationMatrix.hh"
 #include "GateARFSD.hh"
@@ -270,6 +271,11 @@ void GateARFTableMgr::LoadARFFromBinaryFile(const G4String & binaryFilename)
   {
   mLoadArfTables = 1;
   mCurrentIndex = 0;
+  if (GateSharedFile::IsEnabled() && LoadSharedARFTables(binaryFilename))
+    {
+    ListTables();
+    return;
+    }
   G4String basename = GetName() + "ARFTable_";
   std::ifstream inputBinaryFile;
   inputBinaryFile.open(binaryFilename.c_str(), std::ios::binary);
@@ -327,5 +333,54 @@ void GateARFTableMgr::LoadARFFromBinaryFile(const G4String & binaryFilename)
   ListTables();
   }
 
+/* the tables of the binary file are copied to a shared file, aligned and
+ without the byte between them, and read in place by all the processes */
+G4bool GateARFTableMgr::LoadSharedARFTables(const G4String & binaryFilename)
+  {
+  G4String sharedName = "arf-" + GateSharedFile::ComputeFileKey(binaryFilename) + ".bin";
+  G4bool mapped = mSharedTables.Map(sharedName, [&binaryFilename](std::ostream & os)
+    {
+    std::ifstream inputBinaryFile(binaryFilename.c_str(), std::ios::binary);
+    G4double header[2]; /* number of tables and size of a table */
+    inputBinaryFile.read((char*) (header), sizeof(header));
+    os.write((const char*) (header), sizeof(header));
+    std::vector<G4double> tableBuffer(8 + size_t(header[1]));
+    for (size_t i = 0; inputBinaryFile && i < size_t(header[0]); i++)
+      {
+      inputBinaryFile.seekg(1, std::ios::cur);
+      inputBinaryFile.read((char*) (tableBuffer.data()), tableBuffer.size() * sizeof(G4double));
+      os.write((const char*) (tableBuffer.data()), tableBuffer.size() * sizeof(G4double));
+      }
+    return inputBinaryFile.good() && os.good();
+    });
+  if (!mapped)
+    {
+    return false;
+    }
+
+  const G4double* data = (const G4double*) (mSharedTables.GetData());
+  size_t nbOfTables = size_t(data[0]);
+  size_t bytesNumber = 8 + size_t(data[1]);
+  if (mSharedTables.GetSize() != (2 + nbOfTables * bytesNumber) * sizeof(G4double))
+    {
+    GateWarning("The shared ARF tables " << sharedName << " have a wrong size, they are read from "
+                << binaryFilename << Gateendl);
+    mSharedTables.Unmap();
+    return false;
+    }
+  G4String basename = GetName() + "ARFTable_";
+  for (size_t i = 0; i < nbOfTables; i++)
+    {
+    std::ostringstream oss;
+    oss << mCurrentIndex;
+    GateARFTable* arfTable = new GateARFTable(basename + oss.str());
+    arfTable->InitializeFromSharedBuffer(data + 2 + i * bytesNumber);
+    AddaTable(arfTable);
+    }
+  G4cout << " ARF tables of " << binaryFilename << " shared in " << GateSharedFile::GetDirectory()
+         << "/" << sharedName << Gateendl;
+  return true;
+  }
+
 #endif
 
@@ -22,11 +22,93 @@
 #include <getopt.h>
 #include <cstdlib>
 #include <queue>
+#include <unistd.h>
+#include <sys/wait.h>
 
 
 
 
 
+// Writes the pulses of the chain into the singles tree
+void FillSingles(GateDigitizer* digitizer, const G4String& thechainName,
+                 GateCCSingleTree* m_SingleTree, GateCCRootSingleBuffer& m_SinglesBuffer)
+{
+    GatePulseList* pPulseList=digitizer->FindPulseList(thechainName);
+    if(pPulseList){
+        if(pPulseList->size()>0){
+
+
+           GatePulseConstIterator iterIn;
+            for (iterIn = pPulseList->begin() ; iterIn != pPulseList->end() ; ++iterIn){
+
+                GateSingleDigi* aSingleDigi=new GateSingleDigi(*iterIn);
+
+
+                m_SinglesBuffer.Fill(aSingleDigi);
+                m_SingleTree->Fill();
+                m_SinglesBuffer.Clear();
+
+                if(aSingleDigi){
+                    delete aSingleDigi;
+                    aSingleDigi=0;
+                }
+            }
+        }
+    }
+}
+
+
+
+// Applies a macro file, returns false if it is not a macro file
+bool ExecuteMacro(const std::string& macrofile)
+{
+    size_t foundPoint =  macrofile.find_last_of( "." );
+    // Finding suffix
+    G4String suffix = "";
+    if( foundPoint != G4String::npos )
+        suffix =  macrofile.substr( foundPoint + 1 );
+    if( suffix != "mac" )
+    {
+        std::cout << "problemas " << macrofile << " is not a macro file" << std::endl;
+        return false;
+    }
+
+    // Get the pointer to the User Interface manager
+    G4UImanager* UImanager = G4UImanager::GetUIpointer();
+    // Launching Gate  macro file
+    std::cout << "Reading " << macrofile << " ..." << std::endl;
+    G4String command = "/control/execute ";
+    UImanager->ApplyCommand( command + macrofile );
+    std::cout << "Done" << std::endl;
+    return true;
+}
+
+
+
+// Replays the hits of the events (read once by the parent process) through the digitizer
+// configured by the macro, in a child process
+void ReplayConfiguration(GateDigitizer* digitizer, const G4String& thechainName,
+                         const std::vector< std::vector<GateCrystalHit*> >& events,
+                         const std::string& singles_filePathName, const std::string& digitizer_macrofile)
+{
+    if (!ExecuteMacro(digitizer_macrofile)) _exit(1);
+
+    TFile* pTfile = new TFile(singles_filePathName.c_str(),"RECREATE");
+    GateCCSingleTree* m_SingleTree=new GateCCSingleTree("Singles");
+    GateCCRootSingleBuffer  m_SinglesBuffer;
+    m_SingleTree->Init(m_SinglesBuffer);
+
+    for (size_t i=0; i<events.size(); i++) {
+        digitizer->Digitize(events[i]);
+        FillSingles(digitizer, thechainName, m_SingleTree, m_SinglesBuffer);
+    }
+    pTfile->Write();
+    pTfile->Close();
+    std::cout << "Written " << singles_filePathName << std::endl;
+}
+
+
+
 int main(int argc, char *argv[])
 {
     // Usage
@@ -35,30 +117,35 @@ int main(int argc, char *argv[])
           << "Gate_CC_hits_digitizer" << std::endl
           << "Gate for Compton Camera" << std::endl
           << "Process hits to provide singles" << std::endl
-          << "Usage : " << argv[0] << " <hit.root> <singles.root> <options.mac>" << std::endl;
+          << "Usage : " << argv[0] << " <hit.root> <singles.root> <options.mac>" << std::endl
+          << "        " << argv[0] << " [-j N] <hit.root> <geometry.mac> <singles1.root> <digitizer1.mac> [<singles2.root> <digitizer2.mac> ...]" << std::endl
+          << "The second form reads the hits once, then replays them through each digitizer configuration" << std::endl
+          << "in a separate process (at most N at the same time, default: number of cores)." << std::endl
+          << "The geometry macro must not define the digitizer. All the hits are kept in memory." << std::endl;
 
     // Get user parameters
-    if (argc != 4) {
-        std::cout << "Need 4 parameters" << std::endl
+    int nJobs = sysconf(_SC_NPROCESSORS_ONLN);
+    int c;
+    while ((c = getopt(argc, argv, "j:")) != -1) {
+        if (c == 'j') nJobs = atoi(optarg);
+        else {
+            std::cout << usage.str() << std::endl;
+            exit(0);
+        }
+    }
+    int nArgs = argc - optind;
+    if (nJobs < 1) nJobs = 1;
+    if (nArgs != 3 && (nArgs < 4 || nArgs%2 != 0)) {
+        std::cout << "Need 3 parameters, or a geometry macro and pairs of singles file and digitizer macro" << std::endl
                   << usage.str() << std::endl;
         exit(0);
     }
+    bool isReplay = (nArgs != 3);
 
 
-    std::string hits_filePathName=argv[1];
-    std::string singles_filePathName = argv[2];
-    std::string options_macrofile = argv[3];
-
-    size_t foundPoint =  options_macrofile.find_last_of( "." );
-    // Finding suffix
-    G4String suffix = "";
-    if( foundPoint != G4String::npos )
-        suffix =  options_macrofile.substr( foundPoint + 1 );
-    if( suffix != "mac" )
-    {
-        std::cout << "problemas last argument is not a macro file" << std::endl;
-        exit(0);
-    }
+    std::string hits_filePathName=argv[optind];
+    std::string singles_filePathName = isReplay ? "" : argv[optind+1];
+    std::string options_macrofile = argv[optind+ (isReplay ? 1 : 2)];
 
     // GATE Initialisation
     // First of all, set the G4cout to our message manager
@@ -86,15 +173,59 @@ int main(int argc, char *argv[])
     GatePulseProcessorChain* chain=new GatePulseProcessorChain(digitizer, thechainName);
     digitizer->StoreNewPulseProcessorChain(chain);
 
-    // Get the pointer to the User Interface manager
-    G4UImanager* UImanager = G4UImanager::GetUIpointer();
     // Launching Gate  macro file
-    //GateMessage( "Core", 0, "Starting macro " << options_macrofile << G4endl);
-    std::cout << "Reading " << options_macrofile << " ..." << std::endl;
-    G4String command = "/control/execute ";
-    UImanager->ApplyCommand( command + options_macrofile );
-    std::cout << "Done" << std::endl;
+    if (!ExecuteMacro(options_macrofile)) exit(0);
+
+
+    //Read Hits tree
+    GateCCHitFileReader* m_hitFileReader= GateCCHitFileReader::GetInstance(hits_filePathName);
+    m_hitFileReader->PrepareAcquisition();
 
+    if (isReplay) {
+        // The hits are read once, the child processes share them (copy-on-write)
+        std::vector< std::vector<GateCrystalHit*> > events;
+        while(m_hitFileReader->HasNextEvent()){
+            m_hitFileReader->PrepareNextEvent();
+            events.push_back(m_hitFileReader->ReleaseEventHits());
+        }
+        m_hitFileReader->TerminateAfterAcquisition();
+        std::cout << "Read " << events.size() << " events" << std::endl;
+
+        int nRunning = 0;
+        int status = 0;
+        for (int arg = optind+2; arg < argc; arg += 2) {
+            if (nRunning == nJobs) {
+                int childStatus;
+                if (wait(&childStatus) > 0 && childStatus != 0) status = 1;
+                nRunning--;
+            }
+            std::cout.flush();
+            G4cout.flush();
+            pid_t pid = fork();
+            if (pid == 0) {
+                ReplayConfiguration(digitizer, thechainName, events, argv[arg], argv[arg+1]);
+                _exit(0);
+            }
+            if (pid < 0) {
+                std::cout << "Could not start the replay of " << argv[arg+1] << std::endl;
+                status = 1;
+            }
+            else nRunning++;
+        }
+        while (nRunning > 0) {
+            int childStatus;
+            if (wait(&childStatus) > 0 && childStatus != 0) status = 1;
+            nRunning--;
+        }
+
+        for (size_t i=0; i<events.size(); i++)
+            for (size_t j=0; j<events[i].size(); j++)
+                delete events[i][j];
+        delete  randomEngine;
+        delete runManager;
+        delete digitizer;
+        return status;
+    }
 
 
     //Prepare output file
@@ -106,36 +237,12 @@ int main(int argc, char *argv[])
 
 
 
-    //Read Hits tree
-    GateCCHitFileReader* m_hitFileReader= GateCCHitFileReader::GetInstance(hits_filePathName);
-    m_hitFileReader->PrepareAcquisition();
     while(m_hitFileReader->HasNextEvent()){
 
         m_hitFileReader->PrepareNextEvent();
         digitizer->Digitize(m_hitFileReader->PrepareEndOfEvent());
         //SaveInto Single tree the pulses
-        GatePulseList* pPulseList=digitizer->FindPulseList(thechainName);
-        if(pPulseList){
-            if(pPulseList->size()>0){
-
-
-               GatePulseConstIterator iterIn;
-                for (iterIn = pPulseList->begin() ; iterIn != pPulseList->end() ; ++iterIn){
-
-                    GateSingleDigi* aSingleDigi=new GateSingleDigi(*iterIn);
-
-
-                    m_SinglesBuffer.Fill(aSingleDigi);
-                    m_SingleTree->Fill();
-                    m_SinglesBuffer.Clear();
-
-	             if(aSingleDigi){
-                        delete aSingleDigi;
-                        aSingleDigi=0;
-                    }
-                }
-            }
-        }
+        FillSingles(digitizer, thechainName, m_SingleTree, m_SinglesBuffer);
 
     }
     pTfile->Write();
@@ -150,4 +257,3 @@ int main(int argc, char *argv[])
 
     return 0;
 }
-
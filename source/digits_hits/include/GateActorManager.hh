@@ -87,8 +87,12 @@ public:
   void PostUserTrackingAction(const G4Track*);
   /// G4UserSteppingAction callback
   void UserSteppingAction(const G4Step*);
+  /// Steps in the volumes with attached actors (called by their GateMultiSensitiveDetector)
+  void VolumeSteppingAction(GateMultiSensitiveDetector*, G4Step*, G4TouchableHistory*);
   //-----------------------------------------------------------------------------
 
+  void PrintStepStatistics(const G4Run*) const;
+
   typedef GateVActor *(*maker_actor)(G4String name, G4int depth);
   std::map<G4String,maker_actor> theListOfActorPrototypes;
 
@@ -116,6 +120,8 @@ protected:
   GateActorManagerMessenger* pActorManagerMessenger;  //pointer to the Messenger
   G4int mCurrentEventId;
 
+  long int mNumberOfSteps;
+
 private:
   int IsInitialized;
   bool resetAfterSaving;
@@ -68,6 +68,11 @@ class GateBlurring : public GateVPulseProcessor
     //! The result of the pulse-processing is incorporated into the output pulse-list
     void ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList);
 
+    //! Batch version of ProcessOnePulse(), called by ProcessPulseList() for the whole list
+    G4bool IsBatchProcessor() const { return true; }
+    void ProcessPulseBatch(const GatePulseList& inputPulseList, std::vector<G4double>& energies,
+                           std::vector<G4double>& times, std::vector<char>& keep);
+
   private:
     GateVBlurringLaw* m_blurringLaw;
     GateBlurringMessenger *m_messenger;   //!< Messenger
@@ -73,6 +73,9 @@ public:
 
     //GateCrystalHitsCollection* PrepareEndOfEvent();
     std::vector<GateCrystalHit*> PrepareEndOfEvent();
+    //! Same as PrepareEndOfEvent(), but the caller takes the ownership of the hits
+    //! (they are not deleted by the next PrepareNextEvent())
+    std::vector<GateCrystalHit*> ReleaseEventHits();
 
     void TerminateAfterAcquisition();
 
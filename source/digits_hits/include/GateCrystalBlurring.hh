@@ -50,6 +50,11 @@ class GateCrystalBlurring : public GateVPulseProcessor
     //! The result of the pulse-processing is incorporated into the output pulse-list
     void ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList);
 
+    //! Batch version of ProcessOnePulse(), called by ProcessPulseList() for the whole list
+    G4bool IsBatchProcessor() const { return true; }
+    void ProcessPulseBatch(const GatePulseList& inputPulseList, std::vector<G4double>& energies,
+                           std::vector<G4double>& times, std::vector<char>& keep);
+
   private:
     G4double m_crystalresolution;         //!< Simulated energy resolution
     G4double m_crystalresolutionmin;      //!< Simulated min energy resolution
@@ -85,6 +85,7 @@ private:
   G4double m_scannerRotAngle; // Rotation angle of the scanner
   GateOutputVolumeID m_outputVolumeID;
   G4int m_systemID;           // system ID in for the multi-system approach
+  GateDetectorAddress m_detectorAddress; // packed system and output volume IDs
 
   // To use with GateROOTBasicOutput classes
   G4ThreeVector pos;  // position
@@ -193,6 +194,9 @@ private:
       inline void  SetSystemID(const G4int systemID) { m_systemID = systemID; }
       inline G4int GetSystemID() const { return m_systemID; }
 
+      inline void  SetDetectorAddress(GateDetectorAddress address) { m_detectorAddress = address; }
+      inline GateDetectorAddress GetDetectorAddress() const { return m_detectorAddress; }
+
       inline G4bool GoodForAnalysis() const
       	  { return ( (m_process != "Transportation") || (m_edep!=0.) ); }
 
@@ -88,6 +88,13 @@ class GateCrystalSD : public G4VSensitiveDetector
 
       static const G4String theCrystalCollectionName; //! Name of the hit collection
 
+      //! Volume of the previous hit: the successive hits are mostly in the same crystal,
+      //! whose system and output volume ID don't need to be searched again
+      GateVolumeID m_lastVolumeID;
+      GateVSystem* m_lastSystem;
+      GateOutputVolumeID m_lastOutputVolumeID;
+      GateDetectorAddress m_lastDetectorAddress;
+
 };
 
 
@@ -106,6 +106,14 @@ public:
   void MakeCoincidencePulse(G4int i)
   { m_coincidenceSorterList[i]->ProcessSinglePulseList();}
 
+  //! Fuses the processors of the chains (see GatePulseProcessorChain::Compile()), called at the beginning of each run
+  void CompileChains();
+  inline void SetFuseStages(G4bool val) { m_fuseStages = val; }
+  inline G4bool GetFuseStages() const { return m_fuseStages; }
+  //! Processing of the pulse-lists as arrays by the batch processors (see GateVPulseProcessor::ProcessPulseBatch())
+  inline void SetProcessBatches(G4bool val) { m_processBatches = val; }
+  inline G4bool GetProcessBatches() const { return m_processBatches; }
+
   virtual void Digitize();
   void Digitize(std::vector<GateCrystalHit*> vHitsCollection);
   void DigitizePulses();
@@ -167,6 +175,8 @@ protected:
   std::vector<GateVDigiMakerModule*>  		m_digiMakerList;       	 //!< Vector of digi-maker modules
 
   GateDigitizerMessenger*    			m_messenger;
+  G4bool                                        m_fuseStages;            //!< Fusion of the batch processors of the chains
+  G4bool                                        m_processBatches;        //!< Batch processing of the pulse-lists
 
 
   typedef std::pair<G4String,GatePulseList*> 	GatePulseListAlias;
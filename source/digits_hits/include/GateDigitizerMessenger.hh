@@ -78,6 +78,8 @@ class GateDigitizerMessenger: public GateClockDependentMessenger
     G4UIcmdWithoutParameter*    ListChoicesCmd;       //!< the UI command 'info'
     G4UIcmdWithoutParameter*    ListCmd;	      //!< the UI command 'list'
     G4UIcmdWithAString*         pInsertCmd;	      //!< the UI command 'insert'
+    G4UIcmdWithABool*           FuseStagesCmd;        //!< the UI command 'fuseStages'
+    G4UIcmdWithABool*           ProcessBatchesCmd;    //!< the UI command 'processBatches'
 
   private:
     G4String  	      	m_newInsertionBaseName;  //!< the name to be given to the next insertion
@@ -32,6 +32,7 @@
 #include "GateRegionDoseStat.hh"
 
 class G4EmCalculator;
+class GateStoppingPowerTable;
 
 class GateDoseActor : public GateVImageActor
 {
@@ -79,6 +80,8 @@ public:
   void VolumeFilter(G4String b) { mVolumeFilter = b; }
   void MaterialFilter(G4String b) { mMaterialFilter = b; }
   void setTestFlag(bool b) { mTestFlag = b; }
+  void EnableDEDXTable(bool b) { mIsDEDXTableEnabled = b; }
+  void SetDEDXTableBinsPerDecade(G4int n) { mDEDXTableBinsPerDecade = n; }
   //Regions
   void SetDoseByRegionsInputFilename(std::string f);
   void SetDoseByRegionsOutputFilename(std::string f);
@@ -179,6 +182,10 @@ protected:
   G4String mMaterialFilter;
 
   G4EmCalculator* emcalc;
+  // dedx ratios for dose to water/other material
+  bool mIsDEDXTableEnabled;
+  G4int mDEDXTableBinsPerDecade;
+  GateStoppingPowerTable* mDEDXTable;
 
 };
 
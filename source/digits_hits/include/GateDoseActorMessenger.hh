@@ -18,6 +18,7 @@
 
 #include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
 #include "GateImageActorMessenger.hh"
 
 class GateDoseActor;
@@ -67,6 +68,8 @@ protected:
   G4UIcmdWithAString * pVolumeFilterCmd;
   G4UIcmdWithAString * pMaterialFilterCmd;
   G4UIcmdWithABool * pTestFlagCmd;
+  G4UIcmdWithABool * pEnableDEDXTableCmd;
+  G4UIcmdWithAnInteger * pSetDEDXTableBinsCmd;
   //Regions
   G4UIcmdWithAString * pDoseRegionInputCmd;
   G4UIcmdWithAString * pDoseRegionOutputCmd;
@@ -38,6 +38,11 @@ class GateEnergyEfficiency : public GateVPulseProcessor
     //! It is is called by ProcessPulseList() for each of the input pulses
     //! The result of the pulse-processing is incorporated into the output pulse-list
     void ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList);
+
+    //! Batch version of ProcessOnePulse(), called by ProcessPulseList() for the whole list
+    G4bool IsBatchProcessor() const { return true; }
+    void ProcessPulseBatch(const GatePulseList& inputPulseList, std::vector<G4double>& energies,
+                           std::vector<G4double>& times, std::vector<char>& keep);
   private:
     GateVDistribution* m_efficiency;    	   //!< efficiency table
     GateEnergyEfficiencyMessenger *m_messenger;   //!< Messenger
@@ -26,6 +26,7 @@
 #include "G4VProcess.hh"
 
 class G4EmCalculator;
+class GateStoppingPowerTable;
 
 class GateLETActor : public GateVImageActor
 {
@@ -44,6 +45,8 @@ public:
   void SetLETtoWater(bool b) { mIsLETtoWaterEnabled = b; }
   void SetParallelCalculation(bool b) { mIsParallelCalculationEnabled = b; }
   void SetLETType(G4String s) { mAveragingType = s; }
+  void EnableDEDXTable(bool b) { mIsDEDXTableEnabled = b; }
+  void SetDEDXTableBinsPerDecade(G4int n) { mDEDXTableBinsPerDecade = n; }
 
   virtual void BeginOfRunAction(const G4Run*r);
   virtual void BeginOfEventAction(const G4Event * event);
@@ -97,6 +100,13 @@ protected:
   bool mIsParallelCalculationEnabled;
 
   G4EmCalculator * emcalc;
+  G4Material * mWater;
+
+  // tabulated electronic dedx, and total dedx in water for LET to water
+  bool mIsDEDXTableEnabled;
+  G4int mDEDXTableBinsPerDecade;
+  GateStoppingPowerTable * mElectronicDEDXTable;
+  GateStoppingPowerTable * mTotalDEDXTable;
   
   StepHitType mUserStepHitType;
 };
@@ -15,6 +15,7 @@ See LICENSE.md for further details
 
 #include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
 #include "GateImageActorMessenger.hh"
 #include "G4SystemOfUnits.hh" 
 
@@ -35,6 +36,8 @@ protected:
   G4UIcmdWithABool * pSetLETtoWaterCmd;
   G4UIcmdWithAString * pAveragingTypeCmd; 
   G4UIcmdWithABool * pSetParallelCalculationCmd;
+  G4UIcmdWithABool * pEnableDEDXTableCmd;
+  G4UIcmdWithAnInteger * pSetDEDXTableBinsCmd;
 };
 
 #endif /* end #define GATELETACTORMESSENGER_HH*/
@@ -0,0 +1,177 @@
+/*!
+ *	\file GateListModeBlockWriter.hh
+ *	\brief Block-compressed writer of fixed-width list-mode records
+ *
+ *	\section LICENCE
+ *
+ *	Copyright (C): OpenGATE Collaboration
+ *	This software is distributed under the terms of the GNU Lesser General
+ *	Public Licence (LGPL) See LICENSE.md for further details
+ */
+
+#ifndef GATELISTMODEBLOCKWRITER_HH
+#define GATELISTMODEBLOCKWRITER_HH
+
+#include <fstream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "globals.hh"
+
+/*!
+ *	\class GateListModeBlockWriter GateListModeBlockWriter.hh
+ *	\brief Writes fixed-width records into a block-compressed, indexed file
+ *
+ *	Records are appended into an in-memory block. Full blocks are handed to
+ *	a writer thread which compresses them (zlib) and writes them to disk, so
+ *	that the simulation thread never waits for the compression nor for the
+ *	disk, unless too many blocks are pending.
+ *
+ *	File layout (native byte order, given by the byte-order mark):
+ *	- file header (64 bytes): magic "GATECLM", version, byte-order mark,
+ *	  record type, record size, compression, time/energy/position LSBs
+ *	- blocks: block header (32 bytes: number of records, raw size, stored
+ *	  size, compression flag, min and max record time in s) + payload. The
+ *	  payload is stored uncompressed when compression does not reduce it.
+ *	- block index: one entry (32 bytes: file offset of the block header,
+ *	  number of records, min and max time) per block
+ *	- trailer (24 bytes): offset of the index, number of blocks, magic
+ *	  "GATECLMI"
+ *
+ *	Readers can jump to the trailer, load the index and only decompress the
+ *	blocks overlapping a time range.
+ */
+class GateListModeBlockWriter
+{
+public:
+  /*!
+   *	\brief Constructor
+   *
+   *	\param recordType four-character code of the record type (e.g. "SNGL")
+   *	\param recordSize size of one record in bytes
+   */
+  GateListModeBlockWriter( char const* recordType, size_t recordSize );
+
+  /*!
+   *	\brief Destructor, closes the file if still open
+   */
+  ~GateListModeBlockWriter();
+
+  /*!
+   *	\fn void Open( G4String const& fileName )
+   *	\brief Open the output file, write its header and start the writer thread
+   *	\param fileName name of the output file
+   */
+  void Open( G4String const& fileName );
+
+  /*!
+   *	\fn void Close()
+   *	\brief Flush the current block, stop the writer thread, write the block
+   *	index and the trailer, and close the file
+   */
+  void Close();
+
+  /*!
+   *	\fn void Append( void const* record, G4double time )
+   *	\brief Append one record to the current block
+   *	\param record pointer on the packed record (GetRecordSize() bytes)
+   *	\param time time of the record in s, used for the block index
+   */
+  void Append( void const* record, G4double time );
+
+  /*!
+   *	\fn inline G4bool IsOpen() const
+   *	\return true if the file is open
+   */
+  inline G4bool IsOpen() const { return m_isOpen; }
+
+  /*!
+   *	\fn inline size_t GetRecordSize() const
+   *	\return the size of one record in bytes
+   */
+  inline size_t GetRecordSize() const { return m_recordSize; }
+
+  /*!
+   *	\fn inline long long GetBytesWritten() const
+   *	\return the number of bytes written on disk so far (pending blocks are
+   *	counted with their uncompressed size)
+   */
+  inline long long GetBytesWritten() const
+  { return m_bytesWritten + m_bytesPending; }
+
+  /*!
+   *	\fn static void SetRecordsPerBlock( G4int n )
+   *	\brief set the number of records per compressed block
+   */
+  static void SetRecordsPerBlock( G4int n ) { m_recordsPerBlock = n; }
+  static G4int GetRecordsPerBlock() { return m_recordsPerBlock; }
+
+  /*!
+   *	\fn static void SetCompressionLevel( G4int level )
+   *	\brief set the zlib compression level (0: no compression, 1-9)
+   */
+  static void SetCompressionLevel( G4int level ) { m_compressionLevel = level; }
+  static G4int GetCompressionLevel() { return m_compressionLevel; }
+
+  //! Quantization steps of the packed records, written in the file header
+  static const G4double kTimeLSB; /*!< time step of the records, in s */
+  static const G4double kEnergyLSB; /*!< energy step of the records, in MeV */
+  static const G4double kPositionLSB; /*!< position step of the records, in mm */
+
+private:
+  /*!
+   *	\struct Block
+   *	\brief Records of one block, with their time range
+   */
+  struct Block
+  {
+    std::vector< char > data;
+    unsigned int nRecords;
+    G4double minTime;
+    G4double maxTime;
+  };
+
+  /*!
+   *	\struct IndexEntry
+   *	\brief Entry of the block index written at the end of the file
+   */
+  struct IndexEntry
+  {
+    unsigned long long offset;
+    unsigned int nRecords;
+    unsigned int reserved;
+    G4double minTime;
+    G4double maxTime;
+  };
+
+  void NewBlock();
+  void PushCurrentBlock();
+  void WriterLoop();
+  void WriteBlock( Block const& block );
+
+  char m_recordType[ 4 ]; /*!< Four-character code of the record type */
+  size_t m_recordSize; /*!< Size of one record in bytes */
+  G4bool m_isOpen; /*!< Flag of open file */
+  std::ofstream m_file; /*!< Output file, only used by the writer thread while open */
+
+  Block* m_currentBlock; /*!< Block being filled */
+  std::deque< Block* > m_pendingBlocks; /*!< Blocks waiting for the writer thread */
+  std::vector< IndexEntry > m_index; /*!< Index of the written blocks */
+  std::thread m_writerThread; /*!< Compression and writing thread */
+  std::mutex m_mutex; /*!< Protects m_pendingBlocks and m_stopRequested */
+  std::condition_variable m_blockAvailable; /*!< Signals a new block (or stop) */
+  std::condition_variable m_slotAvailable; /*!< Signals that a pending block was written */
+  G4bool m_stopRequested; /*!< Asks the writer thread to finish */
+  std::atomic< long long > m_bytesWritten; /*!< Bytes written on disk */
+  std::atomic< long long > m_bytesPending; /*!< Bytes of the pending blocks */
+
+  static G4int m_recordsPerBlock; /*!< Number of records per block */
+  static G4int m_compressionLevel; /*!< zlib compression level */
+  static const size_t kMaxPendingBlocks = 4; /*!< Max number of blocks waiting for the writer thread */
+};
+
+#endif
@@ -73,6 +73,11 @@ class GateLocalBlurring : public GateVPulseProcessor
     //! The result of the pulse-processing is incorporated into the output pulse-list
     void ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList);
 
+    //! Batch version of ProcessOnePulse(), called by ProcessPulseList() for the whole list
+    G4bool IsBatchProcessor() const { return true; }
+    void ProcessPulseBatch(const GatePulseList& inputPulseList, std::vector<G4double>& energies,
+                           std::vector<G4double>& times, std::vector<char>& keep);
+
   private:
     /*!
       Structure /param which contains the resolution and the energy of reference.
@@ -141,6 +141,9 @@ protected :
   GateOutputMgr(const G4String name);
   static GateOutputMgr* instance;
 
+  //! Entry of the module in the GateProfiler, -1 when it is disabled
+  G4int GetProfilerIndex(size_t iMod);
+
   //! Verbose level
   G4int                      nVerboseLevel;
 
@@ -102,7 +102,7 @@ public:
     inline void     SetRayleighVolumeName(const G4String& name) { m_RayleighVolumeName = name; }
     inline G4String GetRayleighVolumeName() const        { return m_RayleighVolumeName; }
 
-    inline void  SetVolumeID(const GateVolumeID& volumeID)            { m_volumeID = volumeID; }
+    inline void  SetVolumeID(const GateVolumeID& volumeID)            { m_volumeID = volumeID; m_detectorAddress = -1; }
     inline const GateVolumeID& GetVolumeID() const                  	{ return m_volumeID; }
 
     inline void  SetScannerPos(const G4ThreeVector& xyz)            	{ m_scannerPos = xyz; }
@@ -111,10 +111,34 @@ public:
     inline void     SetScannerRotAngle(G4double angle)      	        { m_scannerRotAngle = angle; }
     inline G4double GetScannerRotAngle() const                   	      	{ return m_scannerRotAngle; }
 
-    inline void  SetOutputVolumeID(const GateOutputVolumeID& outputVolumeID)        	{ m_outputVolumeID = outputVolumeID; }
+    inline void  SetOutputVolumeID(const GateOutputVolumeID& outputVolumeID)        	{ m_outputVolumeID = outputVolumeID; m_detectorAddress = -1; }
     inline const GateOutputVolumeID& GetOutputVolumeID()  const             	      	{ return m_outputVolumeID; }
     inline G4int GetComponentID(size_t depth) const    { return (m_outputVolumeID.size()>depth) ? m_outputVolumeID[depth] : -1; }
 
+    //! Packed address of the volume IDs, computed by the system for the hit. It must be set
+    //! after the volume IDs, whose setters reset it.
+    inline void  SetDetectorAddress(GateDetectorAddress address)     { m_detectorAddress = address; }
+    inline GateDetectorAddress GetDetectorAddress() const            { return m_detectorAddress; }
+
+    //! True if the two pulses have the same volume ID: compares the addresses when they are
+    //! known, and the volume IDs only when the addresses are equal but not exact
+    inline G4bool IsInSameVolume(const GatePulse* right) const
+    {
+      if (m_detectorAddress>=0 && right->m_detectorAddress>=0) {
+        if (m_detectorAddress != right->m_detectorAddress) return false;
+        if (m_detectorAddress & DETECTOR_ADDRESS_EXACT) return true;
+      }
+      return m_volumeID == right->m_volumeID;
+    }
+
+    //! Address of the element of level 'depth' (e.g. the block) of the pulse, i.e. its address
+    //! masked down to this level, or -1 if the pulse has no address in 'system'
+    GateDetectorAddress GetBlockAddress(size_t depth, GateVSystem* system) const;
+
+    //! True if the output volume IDs of the two pulses are identical down to the level 'depth'
+    //! (e.g. in the same block). The addresses are compared when they come from 'system'.
+    G4bool IsInSameBlock(const GatePulse* right, size_t depth, GateVSystem* system) const;
+
     //! S. Stute: Modify one value inside the VolumeID and outputVolumeID vectors
     void ChangeVolumeIDAndOutputVolumeIDValue(size_t depth, G4int value);
     // Reset the local position to be 0
@@ -214,6 +238,7 @@ private:
     G4ThreeVector m_scannerPos; 	  //!< Position of the scanner
     G4double m_scannerRotAngle; 	  //!< Rotation angle of the scanner
     GateOutputVolumeID m_outputVolumeID;
+    GateDetectorAddress m_detectorAddress; //!< Packed system and output volume IDs, -1 if unknown
 #ifdef GATE_USE_OPTICAL
     G4bool m_optical;               //!< Is the pulse generated by optical photons
 #endif
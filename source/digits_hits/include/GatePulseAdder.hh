@@ -13,6 +13,7 @@ See LICENSE.md for further details
 #include "globals.hh"
 #include <iostream>
 #include <vector>
+#include <unordered_map>
 #include "G4ThreeVector.hh"
 
 #include "GateVPulseProcessor.hh"
@@ -28,6 +29,9 @@ class GatePulseAdderMessenger;
       one output pulse, whose energy is the sum of all the input-pulse energies,
       and whose position is the centroid of the input-pulse positions.
 
+    - The output pulses are found from the exact detector address of their volume
+      with a hash table. Only the pulses without exact address are compared one by one.
+
       \sa GateVPulseProcessor
 */
 
@@ -54,10 +58,21 @@ class GatePulseAdder : public GateVPulseProcessor
     //! It is is called by ProcessPulseList() for each of the input pulses
     //! The result of the pulse-processing is incorporated into the output pulse-list
     void ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList);
+    //! Overload of the method of GateVPulseProcessor, to reset the table of the output pulses
+    GatePulseList* ProcessPulseList(const GatePulseList* inputPulseList);
+
+    //! Finds the output pulse in the same volume as the input pulse, 0 if none
+    GatePulse* FindOutputPulse(const GatePulse* inputPulse,GatePulseList& outputPulseList);
+
     position_policy_t   m_positionPolicy;
 
   private:
     GatePulseAdderMessenger *m_messenger;     //!< Messenger
+
+    //! Output pulses of the current list, from the exact address of their volume
+    std::unordered_map<GateDetectorAddress,GatePulse*> m_outputPulseOfAddress;
+    //! Output pulses of the current list without exact address
+    std::vector<GatePulse*> m_outputPulsesWithoutAddress;
 };
 
 
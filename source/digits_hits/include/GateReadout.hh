@@ -13,6 +13,7 @@ See LICENSE.md for further details
 #include "globals.hh"
 #include <iostream>
 #include <vector>
+#include <unordered_map>
 #include "G4ThreeVector.hh"
 
 #include "GateVPulseProcessor.hh"
@@ -88,6 +89,11 @@ class GateReadout : public GateVPulseProcessor
     GateArrayComponent* m_crystalComponent;
 
     GateReadoutMessenger *m_messenger;	  //!< Messenger for this readout
+
+    //! Index of the output pulses of the current list, from their block address
+    std::unordered_map<GateDetectorAddress,G4int> m_outputPulseOfBlock;
+    //! Index of the output pulses of the current list without block address
+    std::vector<G4int> m_outputPulsesWithoutAddress;
 };
 
 
@@ -21,6 +21,7 @@ See LICENSE.md for further details
 #include "GateConfiguration.h"
 #include "globals.hh"
 #include <fstream>
+#include <vector>
 
 /*! \class  GateSinogram
     \brief  Structure to store the sinogram sets from a PET simulation
@@ -30,6 +31,12 @@ See LICENSE.md for further details
     - This structure is generated during a PET simulation by GateToSinogram. It can be stored
       into an output file using a set-writer such as GateSinoToEcat7
 
+    - The counts can either be stored in a dense array of 2D sinograms (default) or, when sparse
+      storage is enabled, as one sorted (bin,count) buffer per 2D sinogram. New counts are appended
+      to the buffer and merged into its sorted part once the unsorted tail grows too large, so that
+      the memory used is proportional to the number of recorded coincidences and not to the number
+      of ring pairs. Sparse 2D sinograms are expanded one at a time when they are read or written.
+
     \sa GateToSinogram, GateSinoToEcat7
 */
 class GateSinogram
@@ -37,6 +44,13 @@ class GateSinogram
   public:
     typedef unsigned short SinogramDataType;
 
+    //! One non-empty bin of a sparse 2D sinogram
+    struct SparseBin {
+      G4int            bin;     	      	      	  //!< Bin index (radial element + view * radial elements)
+      SinogramDataType count;   	      	      	  //!< Bin content (or increment, in the unsorted tail)
+    };
+    typedef std::vector<SparseBin> SparseSinogram;
+
   public:
 
     inline GateSinogram();       	      	      	  //!< Public constructor
@@ -109,10 +123,28 @@ class GateSinogram
     inline void SetCrystalNb(size_t aNb)
       { m_crystalNb = aNb;}
 
-     //! Returns the data pointer
+     //! Returns the data pointer (0 when the sparse storage is used)
     inline SinogramDataType** GetData() const
       { return m_data;}
 
+    //! Tells whether the sinograms have been allocated (either dense or sparse)
+    inline G4bool IsAllocated() const
+      { return m_data || !m_sparseData.empty();}
+
+    //! Returns the value of the sparse storage flag
+    inline G4bool IsSparseStorage() const
+      { return m_flagSparseStorage;}
+    //! Enable/disable the sparse storage: must be set before Reset()
+    inline void SetSparseStorage(G4bool val)
+      { m_flagSparseStorage = val;}
+
+    //! Returns the number of new entries a sparse 2D sinogram may buffer before being compacted
+    inline size_t GetSparseCompactionThreshold() const
+      { return m_sparseCompactionThreshold;}
+    //! Set the number of new entries a sparse 2D sinogram may buffer before being compacted
+    inline void SetSparseCompactionThreshold(size_t aNb)
+      { m_sparseCompactionThreshold = aNb;}
+
     //! Returns the randoms pointer
     inline SinogramDataType* GetRandoms() const
       { return m_randomsNb;}
@@ -121,9 +153,12 @@ class GateSinogram
     virtual void SetVerboseLevel(G4int val)
       { nVerboseLevel = val; };
 
-    //! Returns a 2D sinogram from the set
-    inline SinogramDataType* GetSinogram(size_t sinoID) const
-      { return m_data[sinoID];}
+    /*! \brief Returns a 2D sinogram from the set
+
+        With the sparse storage, the 2D sinogram is expanded into an internal buffer which stays
+        valid until the next call: callers must not keep the pointer of a previous 2D sinogram.
+    */
+    SinogramDataType* GetSinogram(size_t sinoID);
 
     //! Returns the number of pixels per 2D sinogram
     inline G4int PixelsPerSinogram() const
@@ -163,6 +198,12 @@ class GateSinogram
     */
     void StreamOut(std::ofstream& dest, size_t sinoID, size_t seekID);
 
+  protected:
+    //! Sort the tail of a sparse 2D sinogram and merge it into the sorted part
+    void CompactSparseSinogram(size_t sinoID);
+
+  public:
+
     //! \name Data fields
     //@{
 
@@ -182,6 +223,13 @@ class GateSinogram
     size_t                m_virtualRingPerBlockNb;              //!< Nb of virtual crystal rings per block, used for sinogram output bin identifacation
     size_t                m_virtualCrystalPerBlockNb;           //!< Nb of virtual crystals in transaxial direction per block, used for sinogram output bin identifacation
 
+    G4bool                m_flagSparseStorage;                  //!< Defines whether the counts are stored as sparse 2D sinograms
+    size_t                m_sparseCompactionThreshold;          //!< Min nb of unsorted entries triggering the compaction of a sparse 2D sinogram
+    std::vector<SparseSinogram> m_sparseData;                   //!< Array of sparse 2D sinograms
+    std::vector<size_t>   m_sparseSortedNb;                     //!< Nb of sorted (compacted) entries at the head of each sparse 2D sinogram
+    SinogramDataType     *m_expandedData;                       //!< Buffer holding the last expanded sparse 2D sinogram
+    G4int                 m_expandedSinoID;                     //!< ID of the sparse 2D sinogram held in m_expandedData (-1 if none)
+
     // ProjectionDataType   *m_dataMax;       	      	      	//!< Max count for each projection
 
     //@}
@@ -206,6 +254,10 @@ inline GateSinogram::GateSinogram()
   , m_sinogramNb(0)
   , m_virtualRingPerBlockNb(0)
   , m_virtualCrystalPerBlockNb(0)
+  , m_flagSparseStorage(false)
+  , m_sparseCompactionThreshold(1024)
+  , m_expandedData(0)
+  , m_expandedSinoID(-1)
 {
 }
 
@@ -0,0 +1,96 @@
+/*----------------------
+   Copyright (C): OpenGATE Collaboration
+
+This software is distributed under the terms
+of the GNU Lesser General  Public Licence (LGPL)
+See LICENSE.md for further details
+----------------------*/
+
+/*
+  \class  GateStoppingPowerTable
+  Tabulated stopping powers for the actors computing a dose (or LET) to
+  another material.
+
+  G4EmCalculator computes the dedx from the physics tables at each call,
+  which is the dominant cost of the dose-to-water computation. Here the
+  dedx of each (particle, material) pair and the dedx ratios of each
+  (particle, material, reference material) triplet are tabulated on a
+  logarithmic energy grid when first needed, then linearly interpolated in
+  log(energy). Outside of the energy range of the tables, the values are
+  computed with G4EmCalculator as before.
+*/
+
+#ifndef GATESTOPPINGPOWERTABLE_HH
+#define GATESTOPPINGPOWERTABLE_HH
+
+#include <map>
+#include <vector>
+#include <utility>
+#include <cfloat>
+
+#include "globals.hh"
+#include "G4SystemOfUnits.hh"
+
+class G4EmCalculator;
+class G4ParticleDefinition;
+class G4Material;
+
+//-----------------------------------------------------------------------------
+class GateStoppingPowerTable
+{
+ public:
+
+  enum DEDXType { kTotalDEDX, kElectronicDEDX };
+
+  GateStoppingPowerTable(G4EmCalculator * calc, DEDXType type, G4double cut=DBL_MAX);
+
+  // Number of energy bins per decade and energy range of the tables. The
+  // tables already built are cleared.
+  void SetBinsPerDecade(G4int n);
+  void SetEnergyRange(G4double emin, G4double emax);
+  G4int GetBinsPerDecade() const { return mBinsPerDecade; }
+
+  // dedx of the particle in the material
+  G4double GetDEDX(G4double energy, const G4ParticleDefinition * p, const G4Material * m);
+  // dedx(ref)/dedx(m), 0 if one of them is 0 (e.g. neutral particles)
+  G4double GetDEDXRatio(G4double energy, const G4ParticleDefinition * p,
+                        const G4Material * m, const G4Material * ref);
+
+  void Clear();
+
+ protected:
+  typedef std::vector<G4double> Table;
+  typedef std::pair<const G4ParticleDefinition*, const G4Material*> Key;
+  typedef std::pair<Key, const G4Material*> RatioKey;
+
+  G4double Compute(G4double energy, const G4ParticleDefinition * p, const G4Material * m);
+  G4double ComputeRatio(G4double energy, const G4ParticleDefinition * p,
+                        const G4Material * m, const G4Material * ref);
+  const Table & GetTable(const G4ParticleDefinition * p, const G4Material * m);
+  const Table & GetRatioTable(const G4ParticleDefinition * p, const G4Material * m, const G4Material * ref);
+  inline G4double Interpolate(const Table & t, G4double energy) const;
+  inline bool InRange(G4double energy) const { return energy >= mEmin && energy < mEmax; }
+  void CheckTable(const Table & t, const G4String & name,
+                  const G4ParticleDefinition * p, const G4Material * m, const G4Material * ref);
+
+  G4EmCalculator * mEmCalculator;
+  DEDXType mType;
+  G4double mCut;
+  G4int mBinsPerDecade;
+  G4double mEmin;
+  G4double mEmax;
+  G4double mLogEmin;
+  G4double mInvLogStep;
+
+  std::map<Key, Table> mTables;
+  std::map<RatioKey, Table> mRatioTables;
+
+  // last table used: successive steps are mostly in the same material
+  Key mLastKey;
+  const Table * mLastTable;
+  RatioKey mLastRatioKey;
+  const Table * mLastRatioTable;
+};
+//-----------------------------------------------------------------------------
+
+#endif /* end #define GATESTOPPINGPOWERTABLE_HH */
@@ -29,6 +29,7 @@
 #include "GateSingleDigi.hh"
 #include "GatePrimaryGeneratorAction.hh"
 #include "GateRunManager.hh"
+#include "GateListModeBlockWriter.hh"
 
 class GateToBinaryMessenger;
 
@@ -191,6 +192,44 @@ public:
    */
   inline virtual void SetRecordFlag( G4int flag ) { m_recordFlag = flag; }
 
+  /*!
+   *	\fn inline static void SetCompactFormat( G4bool flag )
+   *	\brief write singles and coincidences as packed, block-compressed
+   *	records (see GateListModeBlockWriter) instead of the ASCII-mask layout
+   *	\param flag true/false
+   */
+  inline static void SetCompactFormat( G4bool flag )
+  { m_compactFormat = flag; }
+
+  /*!
+   *	\fn inline static G4bool GetCompactFormat()
+   *	\return true if the compact format is used
+   */
+  inline static G4bool GetCompactFormat() { return m_compactFormat; }
+
+  /*!
+   *	\fn static void PackCompactRecord( GatePulse const& pulse, char* dest )
+   *	\brief Pack a pulse into a fixed-width compact record
+   *
+   *	Record layout (32 bytes): time [ps] (uint64), eventID (int32), crystal
+   *	ID (uint32), global position x/y/z [0.1 mm] (3 x int16), energy
+   *	[0.1 keV] (uint16), runID (uint16), sourceID (uint16), number of
+   *	Compton/Rayleigh interactions in phantom/crystal (4 x uint8). Values
+   *	outside the range of their field are saturated.
+   *	\param pulse the pulse to pack
+   *	\param dest destination, at least kCompactRecordSize bytes
+   */
+  static void PackCompactRecord( GatePulse const& pulse, char* dest );
+
+  /*!
+   *	\fn static G4int ComputeCrystalID( GateOutputVolumeID const& volumeID )
+   *	\brief Linear crystal index of an output volume ID in the first system
+   *	\return the crystal index, or -1 if no system is defined
+   */
+  static G4int ComputeCrystalID( GateOutputVolumeID const& volumeID );
+
+  static const size_t kCompactRecordSize = 32; /*!< Size of a packed single record */
+
   /*!
    *	\fn virtual void RegisterNewCoincidenceDigiCollection( G4String const& aCollectionName, G4bool outputFlag )
    *	\brief Register a new coincidence digit collection
@@ -243,7 +282,7 @@ public:
       : nVerboseLevel( 0 ), m_outputFlag( outputFlag ),
         m_fileBaseName( G4String( "" ) ),
         m_collectionName( aCollectionName ), m_fileCounter( 0 ),
-        m_collectionID( -1 )
+        m_collectionID( -1 ), m_compactWriter( 0 )
     {}
 
     /*!
@@ -252,7 +291,7 @@ public:
      *	Destructor of the VOutputChannel class
      *
      */
-    virtual ~VOutputChannel() {}
+    virtual ~VOutputChannel() { delete m_compactWriter; }
 
     /*!
      *	\fn virtual void RecordDigitizer()
@@ -311,6 +350,7 @@ public:
     G4int m_fileCounter; /*!< Count of the file */
     G4int	m_collectionID; /*!< Collection ID */
     std::ofstream m_outputFile; /*!< Output file */
+    GateListModeBlockWriter* m_compactWriter; /*!< Writer of the compact format */
     static G4int m_outputFileSizeLimit; /*!< Output file size limit */
   } VOutputChannel;
 
@@ -333,7 +373,10 @@ public:
     SingleOutputChannel( G4String const& aCollectionName,
                          G4bool outputFlag )
       : GateToBinary::VOutputChannel( aCollectionName, outputFlag )
-    {}
+    {
+      m_compactWriter = new GateListModeBlockWriter( "SNGL",
+                                                     kCompactRecordSize );
+    }
 
     /*!
      *	\brief Destructor
@@ -369,7 +412,10 @@ public:
     CoincidenceOutputChannel( G4String const& aCollectionName,
                               G4bool outputFlag)
       : GateToBinary::VOutputChannel( aCollectionName, outputFlag )
-    {}
+    {
+      m_compactWriter = new GateListModeBlockWriter( "COIN",
+                                                     2 * kCompactRecordSize );
+    }
 
     /*!
      *	\brief Destructor
@@ -399,6 +445,9 @@ protected:
   std::ofstream m_outFileRun; /*!< outfile for run */
   std::ofstream m_outFileHits; /*!< outfile for hits */
 
+  static G4bool m_compactFormat; /*!< Flag of the compact list-mode format */
+  static std::vector< G4int > m_crystalIDFactors; /*!< Per-level factors of the linear crystal ID */
+
 private:
   static G4String FixedWidthZeroPaddedString(const G4String & full, size_t length);
 };
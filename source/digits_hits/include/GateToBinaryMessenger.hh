@@ -100,6 +100,9 @@ protected:
 	G4UIcommand* m_coincidenceMaskCmd; /*!< Command for the coincidence mask */
 	G4UIcommand* m_singleMaskCmd; /*!< Command for the single mask */
 	G4UIcmdWithAnInteger* m_setOutFileSizeLimitCmd; /*!< Limit of the binary output file (in byte) */
+	G4UIcmdWithABool* m_compactFormatCmd; /*!< Command for the compact list-mode format */
+	G4UIcmdWithAnInteger* m_compressionLevelCmd; /*!< Compression level of the compact format */
+	G4UIcmdWithAnInteger* m_recordsPerBlockCmd; /*!< Number of records per block of the compact format */
 	std::vector< G4UIcmdWithABool* > m_outputChannelCmd; /*!< Command for the output */
 
 	std::vector< GateToBinary::VOutputChannel* >  m_outputChannelVector; /*!< vector of output channel */
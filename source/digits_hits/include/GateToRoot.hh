@@ -224,6 +224,13 @@ public:
   G4bool GetRootOpticalFlag()                   { return m_rootOpticalFlag; };
   void   SetRootOpticalFlag(G4bool flag)        { m_rootOpticalFlag = flag; };
 
+  //! Compression level of the output file (-1: ROOT default)
+  G4int  GetCompressionLevel()              { return m_compressionLevel; };
+  void   SetCompressionLevel(G4int level)   { m_compressionLevel = level; };
+  //! Number of ROOT threads compressing the baskets (0: no implicit multi-threading)
+  G4int  GetImplicitMTThreads()             { return m_implicitMTThreads; };
+  void   SetImplicitMTThreads(G4int n)      { m_implicitMTThreads = n; };
+
 
   //! Get the output file name
   const  G4String& GetFileName()             { return m_fileName; };
@@ -307,6 +314,8 @@ private:
   G4bool   m_rootNtupleFlag;
   G4bool   m_saveRndmFlag;
   G4bool   m_rootOpticalFlag;
+  G4int    m_compressionLevel;
+  G4int    m_implicitMTThreads;
 
   G4String m_fileName;
 
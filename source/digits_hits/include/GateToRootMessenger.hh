@@ -65,6 +65,14 @@ class GateToRootMessenger: public GateOutputModuleMessenger
     G4UIcommand*      SingleMaskCmd;
 	G4int m_singleMaskLength;
 
+    G4UIcommand*      HitMaskCmd;
+	G4int m_hitMaskLength;
+
+    G4UIcmdWithAnInteger*    BasketSizeCmd;
+    G4UIcmdWithAnInteger*    CompressionLevelCmd;
+    G4UIcmdWithAnInteger*    AutoSaveCmd;
+    G4UIcmdWithAnInteger*    ImplicitMTCmd;
+
     std::vector<G4UIcmdWithABool*>  		 OutputChannelCmdList;
     std::vector<GateToRoot::VOutputChannel*>  m_outputChannelList;
 };
@@ -106,6 +106,16 @@ public:
     inline GateSinogram* GetSinogram() const
       { return m_sinogram;}
 
+    //! Returns the value of the sparse storage flag
+    inline G4bool IsSparseStorage() const
+      { return m_sinogram->IsSparseStorage();}
+    //! Enable the sparse storage of the 2D sinograms
+    inline void SparseStorage(G4bool val)
+      { m_sinogram->SetSparseStorage(val);}
+    //! Set the number of new entries a sparse 2D sinogram may buffer before being compacted
+    inline void SetSparseCompactionThreshold(size_t aNb)
+      { m_sinogram->SetSparseCompactionThreshold(aNb);}
+
     //! Returns the number of crystals per crystal ring
     inline G4int GetCrystalNb() const
       { return m_sinogram->GetCrystalNb();}
@@ -32,6 +32,8 @@ class GateToSinoAccelMessenger: public GateOutputModuleMessenger
     G4UIcmdWithADoubleAndUnit*  SetTangCrystalResolCmd;  //!< The UI command "set crystal location blurring FWHM in the tangential direction"
     G4UIcmdWithADoubleAndUnit*  SetAxialCrystalResolCmd; //!< The UI command "set crystal location blurring FWHM in the axial direction"
     G4UIcmdWithAString*         SetInputDataCmd;         //!< The UI command "set input data name"
+    G4UIcmdWithABool*           SparseStorageCmd;        //!< The UI command "store the 2D sinograms as sparse bin buffers"
+    G4UIcmdWithAnInteger*       SetSparseCompactionThresholdCmd; //!< The UI command "set the nb of buffered entries before compacting a sparse 2D sinogram"
 };
 
 #endif
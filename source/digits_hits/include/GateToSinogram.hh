@@ -63,6 +63,9 @@ public:
     //! \brief Writes the projection sets onto an output stream
     void StreamOut(std::ofstream& dest);
 
+    //! \brief Writes a set of 2D sinograms into raw, info and dim files, up to the maximum ring difference
+    void StreamOutSinogramSet(GateSinogram* sinogram, const G4String& frameFileName, const G4String& description);
+
     //! Returns the value of the raw ouptut enabled/disabled status flag
     inline virtual G4bool IsRawOutputEnabled() const
     	  { return m_flagIsRawOutputEnabled;}
@@ -94,6 +97,26 @@ public:
           { m_flagStoreScatters = val; }
 
 
+    //! Returns the value of the sparse storage flag
+    inline virtual G4bool IsSparseStorage() const
+          { return m_flagSparseStorage; }
+    //! Enable the sparse storage of the 2D sinograms
+    inline virtual void SparseStorage(G4bool val)
+          { m_flagSparseStorage = val; }
+    //! Returns the number of new entries a sparse 2D sinogram may buffer before being compacted
+    inline size_t GetSparseCompactionThreshold() const
+          { return m_sparseCompactionThreshold; }
+    //! Set the number of new entries a sparse 2D sinogram may buffer before being compacted
+    inline void SetSparseCompactionThreshold(size_t aNb)
+          { m_sparseCompactionThreshold = aNb; }
+
+    //! Returns the maximum absolute ring difference written in the raw output (all ring differences by default)
+    inline G4int GetMaxRingDifference() const
+          { return (m_maxRingDifference < 0) ? (G4int)m_ringNb - 1 : m_maxRingDifference; }
+    //! Set the maximum absolute ring difference written in the raw output (-1 for all)
+    inline void SetMaxRingDifference(G4int aNb)
+          { m_maxRingDifference = aNb; }
+
     //! Get the output file name
     const  G4String& GetFileName()
           { return m_fileName;       };
@@ -244,6 +267,10 @@ protected:
   // C. Comtat, February 2011: Required to simulate Biograph output sinograms with virtual crystals
   size_t              m_virtualRingPerBlockNb;     //! < Number of virtual axial crystals in one block, i.e. Biograph
   size_t              m_virtualCrystalPerBlockNb;  //! < Number of virtual transaxial crystals in one block, i.e. Biograph
+
+  G4bool              m_flagSparseStorage;        //!< Define whether the 2D sinograms are stored as sparse bin buffers
+  size_t              m_sparseCompactionThreshold; //!< Min nb of unsorted entries triggering the compaction of a sparse 2D sinogram
+  G4int               m_maxRingDifference;        //!< Maximum absolute ring difference written in the raw output (-1 for all)
   // std::ofstream     m_dataFile;   	      	   //!< Output stream for the data file
 
 };
@@ -50,6 +50,10 @@ class GateToSinogramMessenger: public GateOutputModuleMessenger
     G4UIcmdWithAnInteger*       SetVirtualRingCmd;       //!< The UI command "set the number of virtual rings between blocks (Biograph, for example)
     G4UIcmdWithAnInteger*       SetVirtualCrystalCmd;    //!< The UI command "set the number of virtual crystals between radial blocks (Biograph, for example)
 
+    G4UIcmdWithABool*           SparseStorageCmd;        //!< The UI command "store the 2D sinograms as sparse bin buffers"
+    G4UIcmdWithAnInteger*       SetSparseCompactionThresholdCmd; //!< The UI command "set the nb of buffered entries before compacting a sparse 2D sinogram"
+    G4UIcmdWithAnInteger*       SetMaxRingDiffCmd;       //!< The UI command "set the maximum ring difference of the raw output"
+
 };
 
 #endif
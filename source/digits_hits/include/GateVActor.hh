@@ -119,6 +119,21 @@ public:
   G4int GetNumberOfFilters() {return mNumOfFilters;}
   void IncNumberOfFilters() {mNumOfFilters++;}
 
+  //-----------------------------------------------------------------------------
+  // Steps dispatched to the actor during the current run, and steps accepted
+  // by its filters (counted by GateActorManager)
+  void CountStep(bool accepted) { mNumberOfDispatchedSteps++; if (accepted) mNumberOfAcceptedSteps++; }
+  void ResetStepCounters() { mNumberOfDispatchedSteps = 0; mNumberOfAcceptedSteps = 0; }
+  long int GetNumberOfDispatchedSteps() const { return mNumberOfDispatchedSteps; }
+  long int GetNumberOfAcceptedSteps() const { return mNumberOfAcceptedSteps; }
+  /// Step in the attached volume (dispatched by GateActorManager)
+  G4bool ProcessVolumeStep(G4Step * step, G4TouchableHistory * th) { return ProcessHits(step, th); }
+  /// Entries of the actor and of its filters in the GateProfiler (-1 if not profiled)
+  void SetProfilerIndices(G4int actor, G4int filter) { mProfilerIndex = actor; mFilterProfilerIndex = filter; }
+  G4int GetProfilerIndex() const { return mProfilerIndex; }
+  G4int GetFilterProfilerIndex() const { return mFilterProfilerIndex; }
+  //-----------------------------------------------------------------------------
+
 protected:
   G4String mTypeName;
   G4String mVolumeName;
@@ -129,6 +144,10 @@ protected:
   virtual G4bool ProcessHits(G4Step * step, G4TouchableHistory *) { UserSteppingAction(0, step); return true; }
 
   G4int mNumOfFilters;
+  long int mNumberOfDispatchedSteps;
+  long int mNumberOfAcceptedSteps;
+  G4int mProfilerIndex;
+  G4int mFilterProfilerIndex;
 
   //-----------------------------------------------------------------------------
   bool mIsBeginOfRunActionEnabled;
@@ -13,6 +13,26 @@
 #include "GateActorManager.hh"
 #include "GateVActor.hh"
 #include "GateMultiSensitiveDetector.hh"
+#include "GateFilterManager.hh"
+
+#include "GateProfiler.hh"
+
+//-----------------------------------------------------------------------------
+// Filters of the actors, timed when the profiler is enabled
+static inline G4bool AcceptStep(GateVActor * actor, const G4Step * step)
+{
+  if (actor->GetNumberOfFilters()==0) return true;
+  GateProfilerScope scope(actor->GetFilterProfilerIndex());
+  return actor->GetFilterManager()->Accept(step);
+}
+
+static inline G4bool AcceptTrack(GateVActor * actor, const G4Track * track)
+{
+  if (actor->GetNumberOfFilters()==0) return true;
+  GateProfilerScope scope(actor->GetFilterProfilerIndex());
+  return actor->GetFilterManager()->Accept(track);
+}
+//-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 GateActorManager::GateActorManager()
@@ -22,6 +42,7 @@ GateActorManager::GateActorManager()
   pActorManagerMessenger = new GateActorManagerMessenger(this);
   IsInitialized =0;
   resetAfterSaving = false;
+  mNumberOfSteps = 0;
   GateDebugMessageDec("Actor",4,"GateActormanager() -- end\n");
 }
 //-----------------------------------------------------------------------------
@@ -91,7 +112,10 @@ void GateActorManager::CreateListsOfEnabledActors()
     //if ((*sit)->GetObjectName() == "output") (*sit) = GateOutputMgr::GetInstance();
     //GateMessage("Core", 0, "Actor = " << (*sit)->GetObjectName() << Gateendl);
 
-    (*sit)->Construct();
+    {
+      GateProfilerPhase phase("actor:" + (*sit)->GetObjectName());
+      (*sit)->Construct();
+    }
     if ((*sit)->IsBeginOfRunActionEnabled()       && IsInitialized<2) theListOfActorsEnabledForBeginOfRun.push_back( (*sit) );
     if ((*sit)->IsEndOfRunActionEnabled()         && IsInitialized<2) theListOfActorsEnabledForEndOfRun.push_back( (*sit) );
     if ((*sit)->IsBeginOfEventActionEnabled()     && IsInitialized<2) theListOfActorsEnabledForBeginOfEvent.push_back( (*sit) );
@@ -150,8 +174,21 @@ void GateActorManager::BeginOfRunAction(const G4Run* run)
   std::vector<GateVActor*>::iterator sit;
 
   //GateMessage("Core", 0, "Run " << run->GetRunID() << " is starting.\n");
-  for (sit = theListOfActorsEnabledForBeginOfRun.begin(); sit!=theListOfActorsEnabledForBeginOfRun.end(); ++sit)
+  GateFilterManager::ResetSharedResults();
+  mNumberOfSteps = 0;
+  for (sit = theListOfActors.begin(); sit!=theListOfActors.end(); ++sit)
+    (*sit)->ResetStepCounters();
+  if (GateProfiler::IsEnabled()) {
+    GateProfiler * profiler = GateProfiler::GetInstance();
+    for (sit = theListOfActors.begin(); sit!=theListOfActors.end(); ++sit)
+      (*sit)->SetProfilerIndices(profiler->GetIndex("actor", (*sit)->GetObjectName()),
+                                 profiler->GetIndex("filter", (*sit)->GetObjectName()+"_filter"));
+  }
+
+  for (sit = theListOfActorsEnabledForBeginOfRun.begin(); sit!=theListOfActorsEnabledForBeginOfRun.end(); ++sit) {
+    GateProfilerScope scope((*sit)->GetProfilerIndex());
     (*sit)->BeginOfRunAction(run);
+  }
 
 }
 //-----------------------------------------------------------------------------
@@ -160,9 +197,12 @@ void GateActorManager::BeginOfRunAction(const G4Run* run)
 void GateActorManager::EndOfRunAction(const G4Run* run)
 {
   std::vector<GateVActor*>::iterator sit;
-  for (sit = theListOfActorsEnabledForEndOfRun.begin(); sit!=theListOfActorsEnabledForEndOfRun.end(); ++sit)
+  for (sit = theListOfActorsEnabledForEndOfRun.begin(); sit!=theListOfActorsEnabledForEndOfRun.end(); ++sit) {
+    GateProfilerScope scope((*sit)->GetProfilerIndex());
     (*sit)->EndOfRunAction(run);
+  }
   //GateMessage("Core", 0, "Run " << run->GetRunID() << " is ending.\n");
+  PrintStepStatistics(run);
 }
 //-----------------------------------------------------------------------------
 
@@ -171,8 +211,10 @@ void GateActorManager::BeginOfEventAction(const G4Event* evt)
 {
   if (evt) mCurrentEventId = evt->GetEventID();
   std::vector<GateVActor*>::iterator sit;
-  for (sit = theListOfActorsEnabledForBeginOfEvent.begin(); sit!=theListOfActorsEnabledForBeginOfEvent.end(); ++sit)
+  for (sit = theListOfActorsEnabledForBeginOfEvent.begin(); sit!=theListOfActorsEnabledForBeginOfEvent.end(); ++sit) {
+    GateProfilerScope scope((*sit)->GetProfilerIndex());
     (*sit)->BeginOfEventAction(evt);
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -180,8 +222,10 @@ void GateActorManager::BeginOfEventAction(const G4Event* evt)
 void GateActorManager::EndOfEventAction(const G4Event* evt)
 {
   std::vector<GateVActor*>::iterator sit;
-  for (sit = theListOfActorsEnabledForEndOfEvent.begin(); sit!=theListOfActorsEnabledForEndOfEvent.end(); ++sit)
+  for (sit = theListOfActorsEnabledForEndOfEvent.begin(); sit!=theListOfActorsEnabledForEndOfEvent.end(); ++sit) {
+    GateProfilerScope scope((*sit)->GetProfilerIndex());
     (*sit)->EndOfEventAction(evt);
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -193,8 +237,8 @@ void GateActorManager::PreUserTrackingAction(const G4Track* track)
   std::vector<GateVActor*>::iterator sit;
   for (sit = theListOfActorsEnabledForPreUserTrackingAction.begin(); sit!=theListOfActorsEnabledForPreUserTrackingAction.end(); ++sit)
     {
-      if ((*sit)->GetNumberOfFilters()!=0)
-        if (!(*sit)->GetFilterManager()->Accept(track) ) continue;
+      if (!AcceptTrack(*sit, track)) continue;
+      GateProfilerScope scope((*sit)->GetProfilerIndex());
       (*sit)->PreUserTrackingAction(0,track);
     }
 }
@@ -206,8 +250,8 @@ void GateActorManager::PostUserTrackingAction(const G4Track* track)
   std::vector<GateVActor*>::iterator sit;
   for (sit = theListOfActorsEnabledForPostUserTrackingAction.begin(); sit!=theListOfActorsEnabledForPostUserTrackingAction.end(); ++sit)
     {
-      if ((*sit)->GetNumberOfFilters()!=0)
-        if (!(*sit)->GetFilterManager()->Accept(track) ) continue;
+      if (!AcceptTrack(*sit, track)) continue;
+      GateProfilerScope scope((*sit)->GetProfilerIndex());
       (*sit)->PostUserTrackingAction(0,track);
     }
 }
@@ -217,18 +261,62 @@ void GateActorManager::PostUserTrackingAction(const G4Track* track)
 void GateActorManager::UserSteppingAction(const G4Step* step)
 {
   std::vector<GateVActor*>::iterator sit;
+  mNumberOfSteps++;
   // GateDebugMessage("Actor", 1, "list = " << theListOfActorsEnabledForUserSteppingAction.size() << Gateendl);
   for (sit = theListOfActorsEnabledForUserSteppingAction.begin(); sit!=theListOfActorsEnabledForUserSteppingAction.end(); ++sit)
     {
       // GateDebugMessage("Actor", 1, "Step for " << (*sit)->GetObjectName());
-      if ((*sit)->GetNumberOfFilters()!=0){
-        if (!(*sit)->GetFilterManager()->Accept(step) ) continue;
+      if (!AcceptStep(*sit, step)) {
+        (*sit)->CountStep(false);
+        continue;
       }
+      (*sit)->CountStep(true);
+      GateProfilerScope scope((*sit)->GetProfilerIndex());
       (*sit)->UserSteppingAction(0, step);
     }
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+void GateActorManager::VolumeSteppingAction(GateMultiSensitiveDetector * msd, G4Step* step, G4TouchableHistory* th)
+{
+  // zero length steps without deposit are skipped, as in G4MultiFunctionalDetector::ProcessHits
+  if (step->GetStepLength() <= 0. && step->GetTotalEnergyDeposit() <= 0.) return;
+
+  // actors attached to the volume of the step or to one of its ancestors
+  const std::vector<GateVActor*> & actors = msd->GetListOfActors();
+  std::vector<GateVActor*>::const_iterator sit;
+  for (sit = actors.begin(); sit!=actors.end(); ++sit)
+    {
+      if (!AcceptStep(*sit, step)) {
+        (*sit)->CountStep(false);
+        continue;
+      }
+      (*sit)->CountStep(true);
+      GateProfilerScope scope((*sit)->GetProfilerIndex());
+      (*sit)->ProcessVolumeStep(step, th);
+    }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void GateActorManager::PrintStepStatistics(const G4Run* run) const
+{
+  if (GateMessageManager::GetMessageLevel("Actor") < 2) return;
+  GateMessage("Actor", 2, "Run " << run->GetRunID() << ": " << mNumberOfSteps << " steps\n");
+  std::vector<GateVActor*>::const_iterator sit;
+  for (sit = theListOfActors.begin(); sit!=theListOfActors.end(); ++sit) {
+    if (!(*sit)->IsUserSteppingActionEnabled()) continue;
+    long int n = (*sit)->GetNumberOfDispatchedSteps();
+    G4String volume = (*sit)->GetVolumeName();
+    GateMessage("Actor", 2, "  " << (*sit)->GetObjectName() << " (" << (volume == "" ? "world" : volume) << "): "
+                << n << " steps dispatched ("
+                << std::setprecision(3) << (mNumberOfSteps ? 100.*n/mNumberOfSteps : 0.) << "%), "
+                << (*sit)->GetNumberOfAcceptedSteps() << " accepted by the filters\n");
+  }
+}
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 void GateActorManager::SetMultiFunctionalDetector(GateVActor * actor, GateVVolume * volume)
 {
@@ -40,6 +40,16 @@ void GateBlurring::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& ou
 	outputPulseList.push_back(outputPulse);
 }
 
+void GateBlurring::ProcessPulseBatch(const GatePulseList&, std::vector<G4double>& energies,
+                                     std::vector<G4double>&, std::vector<char>& keep)
+{
+	m_sigmas.assign(energies.size(),-1.);
+	for (size_t i=0; i<energies.size(); ++i)
+	  if (keep[i])
+	    m_sigmas[i] = (m_blurringLaw->ComputeResolution(energies[i])*energies[i])/GateConstants::fwhm_to_sigma;
+	ShootGaussArray(energies,m_sigmas);
+}
+
 void GateBlurring::DescribeMyself(size_t indent)
 {
  G4cout << GateTools::Indent(indent) << "Blurring law:\t" << m_blurringLaw->GetObjectName() << Gateendl;
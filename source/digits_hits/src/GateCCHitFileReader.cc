@@ -110,6 +110,10 @@ void GateCCHitFileReader::PrepareAcquisition()
   // Set the addresses of the branch buffers: each buffer is a field of the root-hit structure
   GateCCHitTree::SetBranchAddresses(m_hitTree,m_hitBuffer);
 
+  // The tree is read sequentially: the baskets of all the branches are read in bulk
+  m_hitTree->SetCacheSize(64*1024*1024);
+  m_hitTree->AddBranchToCache("*",kTRUE);
+
 
   //Load the first hit into the root-hit structure
   LoadHitData();
@@ -178,6 +182,15 @@ std::vector<GateCrystalHit*> GateCCHitFileReader::PrepareEndOfEvent()
 
 
 
+std::vector<GateCrystalHit*> GateCCHitFileReader::ReleaseEventHits()
+{
+  std::vector<GateCrystalHit*> hits;
+  hits.swap(vHitsCollection);
+  return hits;
+}
+
+
+
 void GateCCHitFileReader::TerminateAfterAcquisition()
 {
   // Close the file
@@ -52,7 +52,7 @@ void GateClustering::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList&
         //store the distance to the different clusters in the outputPulse
         for(unsigned int i=0; i<outputPulseList.size();i++){
             //Maybe remove eventID condition
-            if(outputPulse->GetVolumeID() == (outputPulseList.at(i))->GetVolumeID() && outputPulse->GetEventID()==(outputPulseList.at(i))->GetEventID() ){
+            if(outputPulse->IsInSameVolume(outputPulseList.at(i)) && outputPulse->GetEventID()==(outputPulseList.at(i))->GetEventID() ){
                 //Since I using only same volumeID pulses I could also use local position
                 dist.push_back(getDistance(outputPulse->GetGlobalPos(),outputPulseList.at(i)->GetGlobalPos()));
                 index4ClustSameVol.push_back(i);
@@ -107,7 +107,7 @@ GatePulseList* GateClustering::ProcessPulseList(const GatePulseList* inputPulseL
             bool flagM=0;
             for(unsigned int i=0; i<outputPulseList->size()-1; i++){
                 for(unsigned int k=i+1;k<outputPulseList->size(); k++){
-                    if(outputPulseList->at(i)->GetVolumeID() == outputPulseList->at(k)->GetVolumeID()){
+                    if(outputPulseList->at(i)->IsInSameVolume(outputPulseList->at(k))){
                         flagM=1;
                         break;
                     }
@@ -131,7 +131,7 @@ GatePulseList* GateClustering::ProcessPulseList(const GatePulseList* inputPulseL
             });
             We may not need to sort them
             auto newEnd = std::unique(outputPulseList->begin(), outputPulseList->end(), [](const GatePulse & first, const GatePulse & sec) {
-             if (first.GetVolumeID() == sec.GetVolumeID())
+             if (first.IsInSameVolume(&sec))
                  return true;
              else
                 return false;
@@ -59,6 +59,22 @@ void GateCrystalBlurring::ProcessOnePulse(const GatePulse* inputPulse,GatePulseL
 
 }
 
+// The resolution, QE and Gaussian draws are interleaved pulse by pulse, as in ProcessOnePulse(),
+// so that both paths use the same random sequence
+void GateCrystalBlurring::ProcessPulseBatch(const GatePulseList&, std::vector<G4double>& energies,
+                                            std::vector<G4double>&, std::vector<char>& keep)
+{
+  for (size_t i=0; i<energies.size(); ++i) {
+    if (!keep[i]) continue;
+    m_crystalresolution = G4RandFlat::shoot(m_crystalresolutionmin, m_crystalresolutionmax);
+    m_crystalcoeff = m_crystalresolution * sqrt(m_crystaleref);
+    if (G4UniformRand() <= m_crystalQE)
+      energies[i] = G4RandGauss::shoot(energies[i],m_crystalcoeff*sqrt(energies[i])/GateConstants::fwhm_to_sigma);
+    else
+      energies[i] = 0;
+  }
+}
+
 void GateCrystalBlurring::DescribeMyself(size_t indent)
 {
   G4cout << GateTools::Indent(indent) << "Resolution of " << m_crystalresolution  << " for " <<  G4BestUnit(m_crystaleref,"Energy") << Gateendl;
@@ -36,7 +36,7 @@ const G4String GateCrystalSD::theCrystalCollectionName = "crystalCollection";
 //------------------------------------------------------------------------------
 // Constructor
 GateCrystalSD::GateCrystalSD(const G4String& name)
-:G4VSensitiveDetector(name),m_system(0)
+:G4VSensitiveDetector(name),m_system(0),m_lastSystem(0),m_lastDetectorAddress(-1)
 {
   collectionName.insert(theCrystalCollectionName);
 }
@@ -129,7 +129,14 @@ G4bool GateCrystalSD::ProcessHits(G4Step*aStep, G4TouchableHistory*)
 
   // Get the scanner position and rotation angle
 /*  GateSystemComponent* baseComponent = GetSystem()->GetBaseComponent();*/
-  GateVSystem* system = FindSystem(volumeID);
+  // The system and the output volume ID only depend on the volume
+  if ( !m_lastSystem || !(volumeID == m_lastVolumeID) ) {
+    m_lastVolumeID = volumeID;
+    m_lastSystem = FindSystem(volumeID);
+    m_lastOutputVolumeID = m_lastSystem->ComputeOutputVolumeID(volumeID);
+    m_lastDetectorAddress = m_lastSystem->ComputeDetectorAddress(volumeID, m_lastOutputVolumeID);
+  }
+  GateVSystem* system = m_lastSystem;
   GateSystemComponent* baseComponent = system->GetBaseComponent();
   G4ThreeVector scannerPos = baseComponent->GetCurrentTranslation();
   G4double scannerRotAngle = 0;
@@ -178,8 +185,8 @@ G4bool GateCrystalSD::ProcessHits(G4Step*aStep, G4TouchableHistory*)
 
 //Seb Modif 24/02/2009
 /*  GateOutputVolumeID outputVolumeID = GetSystem()->ComputeOutputVolumeID(aHit->GetVolumeID());*/
-  GateOutputVolumeID outputVolumeID = system->ComputeOutputVolumeID(aHit->GetVolumeID());
-  aHit->SetOutputVolumeID(outputVolumeID);
+  aHit->SetOutputVolumeID(m_lastOutputVolumeID);
+  aHit->SetDetectorAddress(m_lastDetectorAddress);
 
   // Insert the new hit into the hit collection
   crystalCollection->insert( aHit );
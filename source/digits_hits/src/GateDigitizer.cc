@@ -18,6 +18,16 @@
 #include "GateOutputMgr.hh"
 #include "GateVPulseProcessor.hh"
 #include "GateVSystem.hh"
+#include "GateProfiler.hh"
+
+//-----------------------------------------------------------------
+// Entry of a digitizer stage in the GateProfiler, -1 when it is disabled
+template<class T> static G4int GetProfilerIndex(T * stage, const G4String & type)
+{
+  if (!GateProfiler::IsEnabled()) return -1;
+  return GateProfiler::GetInstance()->GetIndex(stage, "digitizer", type+":"+stage->GetObjectName());
+}
+//-----------------------------------------------------------------
 
 typedef std::pair<G4String,GatePulseList*> 	GatePulseListAlias;
 
@@ -39,7 +49,9 @@ GateDigitizer::GateDigitizer()
     G4VDigitizerModule("digitizer"),
     m_elementTypeName("digitizer module"),
     m_system(0),
-    m_systemList(0)
+    m_systemList(0),
+    m_fuseStages(false),
+    m_processBatches(true)
 {
   m_messenger = new GateDigitizerMessenger(this);
 
@@ -391,6 +403,25 @@ void GateDigitizer::Describe(size_t indent)
 //-----------------------------------------------------------------
 
 
+//-----------------------------------------------------------------
+// The pulse-lists read by the chains and the sorters must still be
+// produced. The intermediate pulse-lists read by the digi-makers of
+// the processors are not kept: the fusion is enabled by the user.
+void GateDigitizer::CompileChains()
+{
+  std::set<G4String> usedNames;
+  size_t i;
+  for (i=0; i<m_singleChainList.size() ; ++i)
+    usedNames.insert(m_singleChainList[i]->GetInputName());
+  for (i=0; i<m_coincidenceSorterList.size() ; ++i)
+    usedNames.insert(m_coincidenceSorterList[i]->GetInputName());
+
+  for (i=0; i<m_singleChainList.size() ; ++i)
+    m_singleChainList[i]->Compile(usedNames, m_fuseStages && m_processBatches);
+}
+//-----------------------------------------------------------------
+
+
 //-----------------------------------------------------------------
 //make void GateDigitizer::Digitize(GateCrystalHitsCollection * optional)
 void GateDigitizer::Digitize()
@@ -410,7 +441,10 @@ void GateDigitizer::Digitize()
   //If I do not erase pulse list I lossinfo of evtID, time,.. at singles level pulse
   ErasePulseListVector();
 
-  m_hitConvertor->ProcessHits(CHC);
+  {
+    GateProfilerScope scope(GetProfilerIndex(m_hitConvertor, "hitConvertor"));
+    m_hitConvertor->ProcessHits(CHC);
+  }
 
   DigitizePulses();
 
@@ -418,6 +452,7 @@ void GateDigitizer::Digitize()
  for (size_t i=0; i<m_digiMakerList.size() ; ++i) {
     if (nVerboseLevel>1)
       G4cout << "[GateDigitizer::Digitize]: launching digitizer module '" << m_digiMakerList[i]->GetObjectName() << "'\n";
+    GateProfilerScope scope(GetProfilerIndex(m_digiMakerList[i], "digiMaker"));
     m_digiMakerList[i]->Digitize();
   }
 
@@ -459,6 +494,7 @@ void GateDigitizer::DigitizePulses()  {
     G4cout << "[GateDigitizer::Digitize]: launching processor chain '" << GetChain(i)->GetObjectName() << "'\n";
     //GetChain(i)->Describe();
     GetChain(i)->GetOutputName();
+    GateProfilerScope scope(GetProfilerIndex(GetChain(i), "chain"));
     GetChain(i)->ProcessPulseList();
   }
 
@@ -467,6 +503,7 @@ void GateDigitizer::DigitizePulses()  {
   for (i=0; i<m_coincidenceSorterList.size() ; ++i) {
     if (nVerboseLevel>1)
       G4cout << "[GateDigitizer::Digitize]: launching coincidence sorter '" << m_coincidenceSorterList[i]->GetObjectName() << "'\n";
+    GateProfilerScope scope(GetProfilerIndex(m_coincidenceSorterList[i], "coincidenceSorter"));
     m_coincidenceSorterList[i]->ProcessSinglePulseList();
   }
    //G4cout << "coinc vector Siz after procesSinglesList="<<m_coincidencePulseVector.size()<<G4endl;
@@ -475,6 +512,7 @@ void GateDigitizer::DigitizePulses()  {
   for (i=0; i<m_coincidenceChainList.size() ; ++i) {
     if (nVerboseLevel>1)
       G4cout << "[GateDigitizer::Digitize]: launching coincidence-processor '" << m_coincidenceChainList[i]->GetObjectName() << "'\n";
+    GateProfilerScope scope(GetProfilerIndex(m_coincidenceChainList[i], "coincidenceChain"));
     m_coincidenceChainList[i]->ProcessCoincidencePulses();
   }
 
@@ -59,6 +59,20 @@ GateDigitizerMessenger::GateDigitizerMessenger(GateDigitizer* itsDigitizer)
   ListCmd = new G4UIcmdWithoutParameter(cmdName,this);
   ListCmd->SetGuidance(guidance);
 
+  cmdName = GetDirectoryName()+"fuseStages";
+  guidance = "Applies the consecutive energy/time processors of each chain in one pass (their intermediate singles are not produced).";
+  FuseStagesCmd = new G4UIcmdWithABool(cmdName,this);
+  FuseStagesCmd->SetGuidance(guidance);
+  FuseStagesCmd->SetParameterName("flag",true);
+  FuseStagesCmd->SetDefaultValue(true);
+
+  cmdName = GetDirectoryName()+"processBatches";
+  guidance = "Processes the pulse-lists as arrays in the energy/time processors (true by default), or pulse by pulse.";
+  ProcessBatchesCmd = new G4UIcmdWithABool(cmdName,this);
+  ProcessBatchesCmd->SetGuidance(guidance);
+  ProcessBatchesCmd->SetParameterName("flag",true);
+  ProcessBatchesCmd->SetDefaultValue(true);
+
   pInsertCmd->SetCandidates(DumpMap());
 
 //  G4cout << " FIN Constructor GateDigitizerMessenger \n";
@@ -69,6 +83,8 @@ GateDigitizerMessenger::GateDigitizerMessenger(GateDigitizer* itsDigitizer)
 // Destructor
 GateDigitizerMessenger::~GateDigitizerMessenger()
 {
+  delete ProcessBatchesCmd;
+  delete FuseStagesCmd;
   delete ListCmd;
   delete ListChoicesCmd;
   delete pInsertCmd;
@@ -88,6 +104,10 @@ void GateDigitizerMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
     { ListChoices(); }
   else if( command==ListCmd )
     { GetDigitizer()->ListElements(); }
+  else if( command==FuseStagesCmd )
+    { GetDigitizer()->SetFuseStages(FuseStagesCmd->GetNewBoolValue(newValue)); }
+  else if( command==ProcessBatchesCmd )
+    { GetDigitizer()->SetProcessBatches(ProcessBatchesCmd->GetNewBoolValue(newValue)); }
   else
     GateClockDependentMessenger::SetNewValue(command,newValue);
 }
@@ -14,6 +14,7 @@
 // gate
 #include "GateDoseActor.hh"
 #include "GateMiscFunctions.hh"
+#include "GateStoppingPowerTable.hh"
 
 // g4
 #include <G4EmCalculator.hh>
@@ -74,6 +75,9 @@ GateDoseActor::GateDoseActor(G4String name, G4int depth):
   pMessenger = new GateDoseActorMessenger(this);
   GateDebugMessageDec("Actor",4,"GateDoseActor() -- end\n");
   emcalc = new G4EmCalculator;
+  mIsDEDXTableEnabled = false;
+  mDEDXTableBinsPerDecade = 50;
+  mDEDXTable = new GateStoppingPowerTable(emcalc, GateStoppingPowerTable::kTotalDEDX);
 }
 //-----------------------------------------------------------------------------
 
@@ -82,6 +86,7 @@ GateDoseActor::GateDoseActor(G4String name, G4int depth):
 /// Destructor
 GateDoseActor::~GateDoseActor()  {
   delete pMessenger;
+  delete mDEDXTable;
 }
 //-----------------------------------------------------------------------------
 
@@ -177,6 +182,7 @@ void GateDoseActor::Construct() {
   G4NistManager::Instance()->FindOrBuildMaterial("G4_WATER");
   // Find OtherMaterial
   G4NistManager::Instance()->FindOrBuildMaterial(mOtherMaterial);
+  mDEDXTable->SetBinsPerDecade(mDEDXTableBinsPerDecade);
   // Record the stepHitType
   mUserStepHitType = mStepHitType;
 
@@ -693,14 +699,20 @@ void GateDoseActor::UserSteppingActionInVoxel(const int index, const G4Step* ste
       //For neutrons the dose is neglected - testing with 1.3 MeV photon beam or 150 MeV protons or 1500 MeV carbon ion beam showed that the error induced is < 0.01%
       //		when comparing dose and dosetowater in the material G4_WATER (we are systematically missing a little bit of dose of course with this solution)
       if (p == G4Gamma::Gamma())  p = G4Electron::Electron();
-      DEDX = emcalc->ComputeTotalDEDX(energy, p, current_material, cut);
-      DEDX_Water = emcalc->ComputeTotalDEDX(energy, p, water, cut);
-      //In current implementation, dose deposited directly by neutrons is neglected - the below lines prevent "inf or NaN"
-      if (DEDX==0 || DEDX_Water==0){
-      	doseToWater=0;
+      if (mIsDEDXTableEnabled) {
+        // tabulated DEDX_Water/DEDX, 0 if one of them is 0
+        doseToWater = dose*mDEDXTable->GetDEDXRatio(energy, p, current_material, water)*density*e_SI;
       }
-      else{
-        doseToWater = dose*(DEDX_Water/1.0)/(DEDX/(density*e_SI));
+      else {
+        DEDX = emcalc->ComputeTotalDEDX(energy, p, current_material, cut);
+        DEDX_Water = emcalc->ComputeTotalDEDX(energy, p, water, cut);
+        //In current implementation, dose deposited directly by neutrons is neglected - the below lines prevent "inf or NaN"
+        if (DEDX==0 || DEDX_Water==0){
+          doseToWater=0;
+        }
+        else{
+          doseToWater = dose*(DEDX_Water/1.0)/(DEDX/(density*e_SI));
+        }
       }
 
 //G4cout<<"Dose To Water " << doseToWater << G4endl;
@@ -804,14 +816,20 @@ void GateDoseActor::UserSteppingActionInVoxel(const int index, const G4Step* ste
     //For neutrons the dose is neglected - testing with 1.3 MeV photon beam or 150 MeV protons or 1500 MeV carbon ion beam showed that the error induced is < 0.01%
     //		we are systematically missing a little bit of dose of course with this solution
     if (p == G4Gamma::Gamma())  p = G4Electron::Electron();
-    DEDX = emcalc->ComputeTotalDEDX(energy, p, current_material, cut);
-    DEDX_OtherMaterial = emcalc->ComputeTotalDEDX(energy, p, OtherMaterial, cut);
-    //In current implementation, dose deposited directly by neutrons is neglected - the below lines prevent "inf or NaN"
-    if (DEDX==0 || DEDX_OtherMaterial==0){
-      DoseToOtherMaterial=0;
+    if (mIsDEDXTableEnabled) {
+      // tabulated DEDX_OtherMaterial/DEDX, 0 if one of them is 0
+      DoseToOtherMaterial = dose*mDEDXTable->GetDEDXRatio(energy, p, current_material, OtherMaterial)*current_density/Density_OtherMaterial;
     }
-    else{
-      DoseToOtherMaterial = dose*(DEDX_OtherMaterial/(Density_OtherMaterial*e_SI))/(DEDX/(current_density*e_SI));
+    else {
+      DEDX = emcalc->ComputeTotalDEDX(energy, p, current_material, cut);
+      DEDX_OtherMaterial = emcalc->ComputeTotalDEDX(energy, p, OtherMaterial, cut);
+      //In current implementation, dose deposited directly by neutrons is neglected - the below lines prevent "inf or NaN"
+      if (DEDX==0 || DEDX_OtherMaterial==0){
+        DoseToOtherMaterial=0;
+      }
+      else{
+        DoseToOtherMaterial = dose*(DEDX_OtherMaterial/(Density_OtherMaterial*e_SI))/(DEDX/(current_density*e_SI));
+      }
     }
 
     GateDebugMessage("Actor", 2,  "GateDoseActor -- UserSteppingActionInVoxel:\tdose to OtherMaterial = "
@@ -50,6 +50,8 @@ GateDoseActorMessenger::GateDoseActorMessenger(GateDoseActor* sensor)
   pVolumeFilterCmd= 0;
   pMaterialFilterCmd= 0;
   pTestFlagCmd= 0;
+  pEnableDEDXTableCmd= 0;
+  pSetDEDXTableBinsCmd= 0;
   //Dose in regions
   pDoseRegionInputCmd = 0;
   pDoseRegionOutputCmd = 0;
@@ -96,6 +98,8 @@ GateDoseActorMessenger::~GateDoseActorMessenger()
 
   if(pVolumeFilterCmd) delete pVolumeFilterCmd;
   if(pMaterialFilterCmd) delete pMaterialFilterCmd;
+  if(pEnableDEDXTableCmd) delete pEnableDEDXTableCmd;
+  if(pSetDEDXTableBinsCmd) delete pSetDEDXTableBinsCmd;
 
   if(pDoseRegionOutputCmd) delete pDoseRegionOutputCmd;
   if(pDoseRegionInputCmd) delete pDoseRegionInputCmd;
@@ -248,6 +252,18 @@ void GateDoseActorMessenger::BuildCommands(G4String base)
   guid = G4String("Set Test Flag for debug/validation purposes");
   pTestFlagCmd->SetGuidance(guid);
 
+  n = base+"/enableDEDXTable";
+  pEnableDEDXTableCmd = new G4UIcmdWithABool(n, this);
+  guid = G4String("Use tabulated dedx ratios (interpolated in log(energy)) for dose to water/other material");
+  pEnableDEDXTableCmd->SetGuidance(guid);
+
+  n = base+"/setDEDXTableBinsPerDecade";
+  pSetDEDXTableBinsCmd = new G4UIcmdWithAnInteger(n, this);
+  guid = G4String("Set the number of energy bins per decade of the dedx tables (default 50)");
+  pSetDEDXTableBinsCmd->SetGuidance(guid);
+  pSetDEDXTableBinsCmd->SetParameterName("Bins",false);
+  pSetDEDXTableBinsCmd->SetRange("Bins>0");
+
   n = base+"/inputDoseByRegions";
   pDoseRegionInputCmd = new G4UIcmdWithAString(n, this);
   guid = G4String("Image filename to read the region labels.");
@@ -308,6 +324,8 @@ void GateDoseActorMessenger::SetNewValue(G4UIcommand* cmd, G4String newValue)
   if (cmd == pVolumeFilterCmd) pDoseActor->VolumeFilter(newValue);
   if (cmd == pMaterialFilterCmd) pDoseActor->MaterialFilter(newValue);
   if (cmd ==pTestFlagCmd) pDoseActor->setTestFlag(pTestFlagCmd->GetNewBoolValue(newValue));
+  if (cmd == pEnableDEDXTableCmd) pDoseActor->EnableDEDXTable(pEnableDEDXTableCmd->GetNewBoolValue(newValue));
+  if (cmd == pSetDEDXTableBinsCmd) pDoseActor->SetDEDXTableBinsPerDecade(pSetDEDXTableBinsCmd->GetNewIntValue(newValue));
   //Regions
   if (cmd == pDoseRegionInputCmd) pDoseActor->SetDoseByRegionsInputFilename(newValue);
   if (cmd == pDoseRegionOutputCmd) pDoseActor->SetDoseByRegionsOutputFilename(newValue);
@@ -56,6 +56,22 @@ void GateEnergyEfficiency::ProcessOnePulse(const GatePulse* inputPulse,GatePulse
 
 }
 
+void GateEnergyEfficiency::ProcessPulseBatch(const GatePulseList&, std::vector<G4double>& energies,
+                                             std::vector<G4double>&, std::vector<char>& keep)
+{
+   if (!m_efficiency) // default efficiency is 1
+      return;
+   GateVSystem* system = GateSystemListManager::GetInstance()->GetSystem(0);
+   if (!system){
+      G4cerr<<"[GateEnergyEfficiency::ProcessPulseBatch] Problem : no system defined\n";
+      keep.assign(keep.size(),0);
+      return ;
+   }
+   for (size_t i=0; i<energies.size(); ++i)
+      if (keep[i] && !(G4UniformRand() < m_efficiency->Value(energies[i])))
+         keep[i] = 0;
+}
+
 void GateEnergyEfficiency::DescribeMyself(size_t indent)
 {
   G4cout << GateTools::Indent(indent) << "Tabular Efficiency "<< Gateendl;
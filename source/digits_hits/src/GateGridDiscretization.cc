@@ -222,7 +222,7 @@ void GateGridDiscretization::ProcessOnePulse(const GatePulse* inputPulse,GatePul
 
                         if(index_Y_list.at(posListX)==current_indexY){
                             //Check volumeID not to mix indexes beteween differnet volumes created by the repeater
-                            if(outputPulseList.at(posListX)->GetVolumeID()==outputPulse->GetVolumeID()){
+                            if(outputPulseList.at(posListX)->IsInSameVolume(outputPulse)){
                                 outputPulseList.at(posListX)->CentroidMerge(outputPulse);
                                 delete outputPulse;
                                 flagPulseIsAdded=true;
@@ -58,6 +58,7 @@ GatePulseList* GateHitConvertor::ProcessHits(const GateCrystalHitsCollection* hi
 
 
   GatePulseList* pulseList = new GatePulseList(GetObjectName());
+  pulseList->reserve(n_hit);
 
   size_t i;
   for (i=0;i<n_hit;i++) {
@@ -154,6 +155,7 @@ void GateHitConvertor::ProcessOneHit(const GateCrystalHit* hit,GatePulseList* pu
   pulse->SetComptonVolumeName( hit->GetComptonVolumeName() );
   pulse->SetRayleighVolumeName( hit->GetRayleighVolumeName() );
   pulse->SetVolumeID( hit->GetVolumeID() );
+  pulse->SetDetectorAddress( hit->GetDetectorAddress() );
   pulse->SetScannerPos( hit->GetScannerPos() );
   pulse->SetScannerRotAngle( hit->GetScannerRotAngle() );
 #ifdef GATE_USE_OPTICAL
@@ -15,6 +15,7 @@
 // gate
 #include "GateLETActor.hh"
 #include "GateMiscFunctions.hh"
+#include "GateStoppingPowerTable.hh"
 
 // g4
 #include <G4EmCalculator.hh>
@@ -41,6 +42,11 @@ GateLETActor::GateLETActor(G4String name, G4int depth):
   pMessenger = new GateLETActorMessenger(this);
   GateDebugMessageDec("Actor",4,"GateLETActor() -- end\n");
   emcalc = new G4EmCalculator;
+  mWater = 0;
+  mIsDEDXTableEnabled = false;
+  mDEDXTableBinsPerDecade = 50;
+  mElectronicDEDXTable = new GateStoppingPowerTable(emcalc, GateStoppingPowerTable::kElectronicDEDX);
+  mTotalDEDXTable = new GateStoppingPowerTable(emcalc, GateStoppingPowerTable::kTotalDEDX);
 }
 //-----------------------------------------------------------------------------
 
@@ -49,6 +55,8 @@ GateLETActor::GateLETActor(G4String name, G4int depth):
 /// Destructor
 GateLETActor::~GateLETActor()  {
   delete pMessenger;
+  delete mElectronicDEDXTable;
+  delete mTotalDEDXTable;
 }
 //-----------------------------------------------------------------------------
 
@@ -61,7 +69,9 @@ void GateLETActor::Construct() {
 
   // Find G4_WATER. This it needed here because we will used this
   // material for dedx computation for LETtoWater.
-  G4NistManager::Instance()->FindOrBuildMaterial("G4_WATER");
+  mWater = G4NistManager::Instance()->FindOrBuildMaterial("G4_WATER");
+  mElectronicDEDXTable->SetBinsPerDecade(mDEDXTableBinsPerDecade);
+  mTotalDEDXTable->SetBinsPerDecade(mDEDXTableBinsPerDecade);
 
   // Enable callbacks
   EnableBeginOfRunAction(true);
@@ -297,12 +307,16 @@ void GateLETActor::UserSteppingActionInVoxel(const int index, const G4Step* step
 
   // Compute the dedx for the current particle in the current material
   double weightedLET =0;
-  G4double dedx = emcalc->ComputeElectronicDEDX(energy, partname, material);
+  G4double dedx = 0;
+  if (mIsDEDXTableEnabled) dedx = mElectronicDEDXTable->GetDEDX(energy, partname, material);
+  else dedx = emcalc->ComputeElectronicDEDX(energy, partname, material);
   // SPR to water is unity, but is overwritten if LET to water is enabled
   G4double SPR_ToWater =1.0;
   
   if (mIsLETtoWaterEnabled){
-    G4double dedx_Water = emcalc->ComputeTotalDEDX(energy, partname->GetParticleName(), "G4_WATER") ;
+    G4double dedx_Water = 0;
+    if (mIsDEDXTableEnabled) dedx_Water = mTotalDEDXTable->GetDEDX(energy, partname, mWater);
+    else dedx_Water = emcalc->ComputeTotalDEDX(energy, partname, mWater);
     
     if ((dedx > 0) && (dedx_Water >0 ))
     {
@@ -20,6 +20,8 @@ GateLETActorMessenger::GateLETActorMessenger(GateLETActor* sensor)
 {
   pSetLETtoWaterCmd = 0;
   pAveragingTypeCmd = 0;
+  pEnableDEDXTableCmd = 0;
+  pSetDEDXTableBinsCmd = 0;
   BuildCommands(baseName+sensor->GetObjectName());
 }
 //-----------------------------------------------------------------------------
@@ -30,6 +32,8 @@ GateLETActorMessenger::~GateLETActorMessenger()
 {
   if(pSetLETtoWaterCmd) delete pSetLETtoWaterCmd;
   if(pAveragingTypeCmd) delete pAveragingTypeCmd;
+  if(pEnableDEDXTableCmd) delete pEnableDEDXTableCmd;
+  if(pSetDEDXTableBinsCmd) delete pSetDEDXTableBinsCmd;
 }
 //-----------------------------------------------------------------------------
 
@@ -51,6 +55,18 @@ void GateLETActorMessenger::BuildCommands(G4String base)
   pAveragingTypeCmd = new G4UIcmdWithAString(n,this);
   guid = G4String("Sets  averaging method ('DoseAveraged', 'TrackAveraged'). Default is 'DoseAveraged'.");
   pAveragingTypeCmd->SetGuidance(guid);
+
+  n = base+"/enableDEDXTable";
+  pEnableDEDXTableCmd = new G4UIcmdWithABool(n, this);
+  guid = G4String("Use tabulated dedx (interpolated in log(energy)) instead of computing them at each step");
+  pEnableDEDXTableCmd->SetGuidance(guid);
+
+  n = base+"/setDEDXTableBinsPerDecade";
+  pSetDEDXTableBinsCmd = new G4UIcmdWithAnInteger(n, this);
+  guid = G4String("Set the number of energy bins per decade of the dedx tables (default 50)");
+  pSetDEDXTableBinsCmd->SetGuidance(guid);
+  pSetDEDXTableBinsCmd->SetParameterName("Bins",false);
+  pSetDEDXTableBinsCmd->SetRange("Bins>0");
 }
 //-----------------------------------------------------------------------------
 
@@ -62,6 +78,8 @@ void GateLETActorMessenger::SetNewValue(G4UIcommand* cmd, G4String newValue)
   if (cmd == pSetParallelCalculationCmd) pLETActor->SetParallelCalculation(pSetParallelCalculationCmd->GetNewBoolValue(newValue));
 
   if (cmd == pAveragingTypeCmd) pLETActor->SetLETType(newValue);
+  if (cmd == pEnableDEDXTableCmd) pLETActor->EnableDEDXTable(pEnableDEDXTableCmd->GetNewBoolValue(newValue));
+  if (cmd == pSetDEDXTableBinsCmd) pLETActor->SetDEDXTableBinsPerDecade(pSetDEDXTableBinsCmd->GetNewIntValue(newValue));
 
   GateImageActorMessenger::SetNewValue( cmd, newValue);
 }
@@ -0,0 +1,251 @@
+/*!
+ *	\file GateListModeBlockWriter.cc
+ *
+ *	\section LICENCE
+ *
+ *	Copyright (C): OpenGATE Collaboration
+ *	This software is distributed under the terms of the GNU Lesser General
+ *	Public Licence (LGPL) See LICENSE.md for further details
+ */
+
+#include "GateListModeBlockWriter.hh"
+
+#include <cstring>
+
+#include "itk_zlib.h"
+
+G4int GateListModeBlockWriter::m_recordsPerBlock = 65536;
+G4int GateListModeBlockWriter::m_compressionLevel = 1;
+
+const G4double GateListModeBlockWriter::kTimeLSB = 1.0e-12;
+const G4double GateListModeBlockWriter::kEnergyLSB = 1.0e-4;
+const G4double GateListModeBlockWriter::kPositionLSB = 0.1;
+
+namespace
+{
+  const char kFileMagic[ 8 ] = { 'G', 'A', 'T', 'E', 'C', 'L', 'M', '\0' };
+  const char kIndexMagic[ 8 ] = { 'G', 'A', 'T', 'E', 'C', 'L', 'M', 'I' };
+  const unsigned int kFormatVersion = 1;
+  const unsigned int kByteOrderMark = 0x01020304;
+  const size_t kFileHeaderSize = 64;
+  const size_t kBlockHeaderSize = 32;
+
+  template< typename T >
+  inline void PutValue( char*& dest, T const& value )
+  {
+    std::memcpy( dest, &value, sizeof( T ) );
+    dest += sizeof( T );
+  }
+}
+
+GateListModeBlockWriter::GateListModeBlockWriter( char const* recordType,
+                                                  size_t recordSize )
+  : m_recordSize( recordSize ), m_isOpen( false ), m_currentBlock( 0 ),
+    m_stopRequested( false ), m_bytesWritten( 0 ), m_bytesPending( 0 )
+{
+  std::memcpy( m_recordType, recordType, 4 );
+}
+
+GateListModeBlockWriter::~GateListModeBlockWriter()
+{
+  Close();
+}
+
+void GateListModeBlockWriter::Open( G4String const& fileName )
+{
+  if( m_isOpen )
+    {
+      Close();
+    }
+
+  m_file.open( fileName.c_str(), std::ios::out | std::ios::trunc |
+               std::ios::binary );
+  if( !m_file.is_open() )
+    {
+      G4String msg = "Could not open the compact list-mode file '" + fileName
+        + "'";
+      G4Exception( "GateListModeBlockWriter::Open", "Open", FatalException,
+                   msg );
+    }
+
+  // File header
+  char header[ kFileHeaderSize ];
+  std::memset( header, 0, kFileHeaderSize );
+  char* p = header;
+  std::memcpy( p, kFileMagic, 8 ); p += 8;
+  PutValue( p, kFormatVersion );
+  PutValue( p, kByteOrderMark );
+  std::memcpy( p, m_recordType, 4 ); p += 4;
+  PutValue( p, static_cast< unsigned int >( m_recordSize ) );
+  PutValue( p, static_cast< unsigned int >( m_compressionLevel > 0 ? 1 : 0 ) );
+  PutValue( p, static_cast< unsigned int >( m_recordsPerBlock ) );
+  PutValue( p, kTimeLSB );
+  PutValue( p, kEnergyLSB );
+  PutValue( p, kPositionLSB );
+  m_file.write( header, kFileHeaderSize );
+
+  m_index.clear();
+  m_bytesWritten = kFileHeaderSize;
+  m_bytesPending = 0;
+  m_stopRequested = false;
+  m_isOpen = true;
+  NewBlock();
+
+  m_writerThread = std::thread( &GateListModeBlockWriter::WriterLoop, this );
+}
+
+void GateListModeBlockWriter::Close()
+{
+  if( !m_isOpen )
+    {
+      return;
+    }
+
+  // Flush the last (partial) block and wait for the writer thread
+  if( m_currentBlock->nRecords > 0 )
+    {
+      PushCurrentBlock();
+    }
+  else
+    {
+      delete m_currentBlock;
+    }
+  m_currentBlock = 0;
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_stopRequested = true;
+  }
+  m_blockAvailable.notify_one();
+  m_writerThread.join();
+
+  // Block index and trailer
+  unsigned long long indexOffset = m_bytesWritten;
+  for( size_t i = 0; i < m_index.size(); ++i )
+    {
+      m_file.write( reinterpret_cast< char const* >( &m_index[ i ] ),
+                    sizeof( IndexEntry ) );
+    }
+  unsigned long long nBlocks = m_index.size();
+  m_file.write( reinterpret_cast< char const* >( &indexOffset ),
+                sizeof( indexOffset ) );
+  m_file.write( reinterpret_cast< char const* >( &nBlocks ),
+                sizeof( nBlocks ) );
+  m_file.write( kIndexMagic, 8 );
+  m_file.close();
+  m_isOpen = false;
+}
+
+void GateListModeBlockWriter::Append( void const* record, G4double time )
+{
+  Block* block = m_currentBlock;
+  block->data.insert( block->data.end(), static_cast< char const* >( record ),
+                      static_cast< char const* >( record ) + m_recordSize );
+  if( block->nRecords == 0 || time < block->minTime ) block->minTime = time;
+  if( block->nRecords == 0 || time > block->maxTime ) block->maxTime = time;
+  ++block->nRecords;
+
+  if( block->nRecords >= static_cast< unsigned int >( m_recordsPerBlock ) )
+    {
+      PushCurrentBlock();
+      NewBlock();
+    }
+}
+
+void GateListModeBlockWriter::NewBlock()
+{
+  m_currentBlock = new Block;
+  m_currentBlock->data.reserve( m_recordSize * m_recordsPerBlock );
+  m_currentBlock->nRecords = 0;
+  m_currentBlock->minTime = 0.0;
+  m_currentBlock->maxTime = 0.0;
+}
+
+void GateListModeBlockWriter::PushCurrentBlock()
+{
+  std::unique_lock< std::mutex > lock( m_mutex );
+  // Back-pressure: bound the memory held by blocks waiting for the disk
+  m_slotAvailable.wait( lock, [ this ]
+    { return m_pendingBlocks.size() < kMaxPendingBlocks; } );
+  m_bytesPending += m_currentBlock->data.size();
+  m_pendingBlocks.push_back( m_currentBlock );
+  lock.unlock();
+  m_blockAvailable.notify_one();
+}
+
+void GateListModeBlockWriter::WriterLoop()
+{
+  for( ;; )
+    {
+      Block* block = 0;
+      {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        m_blockAvailable.wait( lock, [ this ]
+          { return !m_pendingBlocks.empty() || m_stopRequested; } );
+        if( m_pendingBlocks.empty() )
+          {
+            return; // stop requested and nothing left to write
+          }
+        block = m_pendingBlocks.front();
+      }
+
+      WriteBlock( *block );
+
+      {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_pendingBlocks.pop_front();
+        m_bytesPending -= block->data.size();
+      }
+      m_slotAvailable.notify_one();
+      delete block;
+    }
+}
+
+void GateListModeBlockWriter::WriteBlock( Block const& block )
+{
+  unsigned int rawSize = block.data.size();
+  unsigned int compressed = 0;
+  std::vector< char > packed;
+  char const* payload = &block.data[ 0 ];
+  unsigned int storedSize = rawSize;
+
+  if( m_compressionLevel > 0 )
+    {
+      uLongf packedSize = compressBound( rawSize );
+      packed.resize( packedSize );
+      if( compress2( reinterpret_cast< Bytef* >( &packed[ 0 ] ), &packedSize,
+                     reinterpret_cast< Bytef const* >( &block.data[ 0 ] ),
+                     rawSize, m_compressionLevel ) == Z_OK
+          && packedSize < rawSize )
+        {
+          payload = &packed[ 0 ];
+          storedSize = packedSize;
+          compressed = 1;
+        }
+    }
+
+  IndexEntry entry;
+  entry.offset = m_bytesWritten;
+  entry.nRecords = block.nRecords;
+  entry.reserved = 0;
+  entry.minTime = block.minTime;
+  entry.maxTime = block.maxTime;
+  m_index.push_back( entry );
+
+  char header[ kBlockHeaderSize ];
+  char* p = header;
+  PutValue( p, block.nRecords );
+  PutValue( p, rawSize );
+  PutValue( p, storedSize );
+  PutValue( p, compressed );
+  PutValue( p, block.minTime );
+  PutValue( p, block.maxTime );
+  m_file.write( header, kBlockHeaderSize );
+  m_file.write( payload, storedSize );
+  if( m_file.bad() )
+    {
+      G4Exception( "GateListModeBlockWriter::WriteBlock", "WriteBlock",
+                   FatalException,
+                   "Could not write a list-mode block onto the disk (out of disk space?)" );
+    }
+  m_bytesWritten += kBlockHeaderSize + storedSize;
+}
@@ -76,6 +76,28 @@ void GateLocalBlurring::ProcessOnePulse(const GatePulse* inputPulse,GatePulseLis
   outputPulseList.push_back(outputPulse);
 }
 
+void GateLocalBlurring::ProcessPulseBatch(const GatePulseList& inputPulseList, std::vector<G4double>& energies,
+                                          std::vector<G4double>&, std::vector<char>& keep)
+{
+  // sigma of each pulse, -1 for the volumes which are not blurred
+  m_sigmas.assign(energies.size(),-1.);
+  for (size_t i=0; i<energies.size(); ++i) {
+    if (!keep[i]) continue;
+    im=m_table.find(((inputPulseList[i]->GetVolumeID()).GetBottomCreator())->GetObjectName());
+    if(im == m_table.end()) continue;
+    if((*im).second.resolution < 0 || (*im).second.eref < 0) {
+      G4cerr << 	Gateendl << "[GateLocalBlurring::ProcessPulseBatch]:\n"
+	     <<   "Sorry, but the resolution (" << (*im).second.resolution << ") or the energy of reference ("
+	     << G4BestUnit((*im).second.eref,"Energy") << ") for " << (*im).first << " is invalid\n";
+      G4String msg = "You must set the energy of reference AND the resolution: /gate/digitizer/Singles/localBlurring/" + (*im).first + "/setEnergyOfReference ENERGY or disable the local blurring using: /gate/digitizer/Singles/localBlurring/disable\n";
+      G4Exception( "GateLocalBlurring::ProcessPulseBatch", "ProcessPulseBatch", FatalException, msg );
+    }
+    G4double m_coeff = (*im).second.resolution * sqrt((*im).second.eref);
+    m_sigmas[i] = m_coeff*sqrt(energies[i])/GateConstants::fwhm_to_sigma;
+  }
+  ShootGaussArray(energies,m_sigmas);
+}
+
 void GateLocalBlurring::DescribeMyself(size_t indent)
 {
   for (im=m_table.begin(); im!=m_table.end(); im++)
@@ -82,7 +82,7 @@ void GateLocalClustering::ProcessOnePulse(const GatePulse* inputPulse,GatePulseL
                  else{
                      //for(unsigned int i=0; i<clustersGlobPositions.size();i++){
                      for(unsigned int i=0; i<index4Clusters.size();i++){
-                         if(outputPulse->GetVolumeID() == (outputPulseList.at(index4Clusters.at(i)))->GetVolumeID()){
+                         if(outputPulse->IsInSameVolume(outputPulseList.at(index4Clusters.at(i)))){
                          //dist.push_back(getDistance(outputPulse->GetGlobalPos(),clustersGlobPositions.at(i)));
                            dist.push_back(getDistance(outputPulse->GetGlobalPos(),outputPulseList.at(index4Clusters.at(i))->GetGlobalPos()));
                            index4ClustSameVol.push_back(index4Clusters.at(i));
@@ -155,7 +155,7 @@ GatePulseList* GateLocalClustering::ProcessPulseList(const GatePulseList* inputP
                // One volume name but maybe different volumeID if repeaters are used
                for(unsigned int i=0; i<index4Clusters.size()-1; i++){
                           for(unsigned int k=i+1;k<index4Clusters.size(); k++){
-                                   if(outputPulseList->at(index4Clusters.at(i))->GetVolumeID() == outputPulseList->at(index4Clusters.at(k))->GetVolumeID()){
+                                   if(outputPulseList->at(index4Clusters.at(i))->IsInSameVolume(outputPulseList->at(index4Clusters.at(k)))){
                                        flagM=1;
                                        break;
 
@@ -193,7 +193,7 @@ GatePulseList* GateLocalClustering::ProcessPulseList(const GatePulseList* inputP
                // One volume name but maybe different volumeID if repeaters are used
                for(unsigned int i=0; i<index4Clusters.size()-1; i++){
                    for(unsigned int k=i+1;k<index4Clusters.size(); k++){
-                       if(outputPulseList->at(index4Clusters.at(i))->GetVolumeID() == outputPulseList->at(index4Clusters.at(k))->GetVolumeID()){
+                       if(outputPulseList->at(index4Clusters.at(i))->IsInSameVolume(outputPulseList->at(index4Clusters.at(k)))){
                            flagM=1;
                            break;
 
@@ -6,6 +6,7 @@
 #include "GateMuDatabase.hh"
 #include "GateMiscFunctions.hh"
 #include "GateConfiguration.h"
+#include "GateProfiler.hh"
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -113,6 +114,7 @@ inline double interpolation(double Xa,double Xb,double Ya,double Yb,double x){
 //-----------------------------------------------------------------------------
 void GateMaterialMuHandler::Initialize()
 {
+  GateProfilerPhase phase("muTables");
   if(mDatabaseName == "simulated")
     {
       SimulateMaterialTable();
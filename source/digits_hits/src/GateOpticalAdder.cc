@@ -29,7 +29,7 @@ void GateOpticalAdder::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList
 
     GatePulseIterator iter;
     for (iter=outputPulseList.begin(); iter!= outputPulseList.end() ; ++iter)
-      if ( (*iter)->GetVolumeID()   == inputPulse->GetVolumeID() )
+      if ( (*iter)->IsInSameVolume(inputPulse) )
       {
 //	G4double energy = (*iter)->GetEnergy();
 
@@ -28,6 +28,7 @@
 #include "GateActorManager.hh"
 
 #include "GateMessageManager.hh"
+#include "GateProfiler.hh"
 #include "GateToDigi.hh"
 #include "GateToASCII.hh"
 #include "GateToBinary.hh"
@@ -154,6 +155,15 @@ void GateOutputMgr::AddOutputModule(GateVOutputModule* module)
 //----------------------------------------------------------------------------------
 
 
+//----------------------------------------------------------------------------------
+G4int GateOutputMgr::GetProfilerIndex(size_t iMod)
+{
+  if (!GateProfiler::IsEnabled()) return -1;
+  return GateProfiler::GetInstance()->GetIndex(m_outputModules[iMod], "output", m_outputModules[iMod]->GetName());
+}
+//----------------------------------------------------------------------------------
+
+
 //----------------------------------------------------------------------------------
 void GateOutputMgr::RecordBeginOfEvent(const G4Event* event)
 {
@@ -161,8 +171,10 @@ void GateOutputMgr::RecordBeginOfEvent(const G4Event* event)
 
 
   for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
-    if ( m_outputModules[iMod]->IsEnabled() )
+    if ( m_outputModules[iMod]->IsEnabled() ) {
+      GateProfilerScope scope(GetProfilerIndex(iMod));
       m_outputModules[iMod]->RecordBeginOfEvent(event);
+    }
   }
 }
 //----------------------------------------------------------------------------------
@@ -181,6 +193,7 @@ void GateOutputMgr::RecordEndOfEvent(const G4Event* event)
   for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
     if ( m_outputModules[iMod]->IsEnabled() )
       {
+        GateProfilerScope scope(GetProfilerIndex(iMod));
         m_outputModules[iMod]->RecordEndOfEvent(event);
       }
   }
@@ -204,8 +217,10 @@ void GateOutputMgr::RecordBeginOfRun(const G4Run* run)
     RecordBeginOfAcquisition();
 
   for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
-    if ( m_outputModules[iMod]->IsEnabled() )
+    if ( m_outputModules[iMod]->IsEnabled() ) {
+      GateProfilerScope scope(GetProfilerIndex(iMod));
       m_outputModules[iMod]->RecordBeginOfRun(run);
+    }
   }
 }
 //----------------------------------------------------------------------------------
@@ -220,8 +235,10 @@ void GateOutputMgr::RecordEndOfRun(const G4Run* run)
     G4cout << "GateOutputMgr::RecordEndOfRun\n";
 
   for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
-    if ( m_outputModules[iMod]->IsEnabled() )
+    if ( m_outputModules[iMod]->IsEnabled() ) {
+      GateProfilerScope scope(GetProfilerIndex(iMod));
       m_outputModules[iMod]->RecordEndOfRun(run);
+    }
   }
 }
 //----------------------------------------------------------------------------------
@@ -295,8 +312,10 @@ void GateOutputMgr::RecordStepWithVolume(const GateVVolume * v, const G4Step* st
     G4cout << "GateOutputMgr::RecordStep\n";
 
   for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
-    if ( m_outputModules[iMod]->IsEnabled() )
+    if ( m_outputModules[iMod]->IsEnabled() ) {
+      GateProfilerScope scope(GetProfilerIndex(iMod));
       m_outputModules[iMod]->RecordStepWithVolume(v, step);
+    }
   }
 }
 //----------------------------------------------------------------------------------
@@ -572,8 +591,10 @@ void GateOutputMgr::RecordTracks(GateSteppingAction* mySteppingAction){
 
 
   for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
-    if ( m_outputModules[iMod]->IsEnabled() )
+    if ( m_outputModules[iMod]->IsEnabled() ) {
+      GateProfilerScope scope(GetProfilerIndex(iMod));
       m_outputModules[iMod]->RecordTracks(mySteppingAction);
+    }
   }
   GateMessage("Output", 5, " GateOutputMgr::RecordTracks -- end\n";);
 }
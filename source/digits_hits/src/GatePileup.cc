@@ -14,6 +14,7 @@ See LICENSE.md for further details
 #include "GateOutputVolumeID.hh"
 #include "GatePileupMessenger.hh"
 #include "GateTools.hh"
+#include "GatePulseProcessorChain.hh"
 
 
 GatePileup::GatePileup(GatePulseProcessorChain* itsChain,
@@ -70,9 +71,10 @@ void GatePileup::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outp
     return;
   }
 
+  GateVSystem* system = GetChain()->GetSystem();
   GatePulseIterator iter;
   for (iter = outputPulseList.begin() ; iter != outputPulseList.end() ; ++iter )
-    if ( ((*iter)->GetOutputVolumeID().Top(m_depth) == blockID )
+    if ( (*iter)->IsInSameBlock(inputPulse,m_depth,system)
          &&  (std::abs((*iter)->GetTime()-inputPulse->GetTime())<m_pileup) )
       break;
 
@@ -20,6 +20,7 @@ GatePulse::GatePulse(const void* itsMother)
       m_energy(0),
       m_nPhantomCompton(-1),
       m_nPhantomRayleigh(-1),
+      m_detectorAddress(-1),
       #ifdef GATE_USE_OPTICAL
       m_optical(false),
       #endif
@@ -333,6 +334,23 @@ void GatePulse::ChangeVolumeIDAndOutputVolumeIDValue(size_t depth, G4int copyNo)
     delete volSelector;
     // Finally change the outputVolumeID accordingly
     m_outputVolumeID[depth] = copyNo;
+    m_detectorAddress = -1;
+}
+
+GateDetectorAddress GatePulse::GetBlockAddress(size_t depth, GateVSystem* system) const
+{
+    if (!system || m_detectorAddress<0 || DETECTOR_ADDRESS_SYSTEM(m_detectorAddress)!=system->GetItsNumber())
+        return -1;
+    GateDetectorAddress mask = system->GetDetectorAddressMask(depth);
+    return mask ? (m_detectorAddress & mask) : -1;
+}
+
+G4bool GatePulse::IsInSameBlock(const GatePulse* right, size_t depth, GateVSystem* system) const
+{
+    GateDetectorAddress address = GetBlockAddress(depth,system);
+    GateDetectorAddress rightAddress = right->GetBlockAddress(depth,system);
+    if (address>=0 && rightAddress>=0) return address == rightAddress;
+    return m_outputVolumeID.Top(depth) == right->m_outputVolumeID.Top(depth);
 }
 
 // Reset the global position of the pulse with respect to its volumeID that has been changed previously
@@ -33,47 +33,76 @@ GatePulseAdder::~GatePulseAdder()
 
 
 
-void GatePulseAdder::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList)
+GatePulseList* GatePulseAdder::ProcessPulseList(const GatePulseList* inputPulseList)
 {
-#ifdef GATE_USE_OPTICAL
-  // ignore pulses based on optical photons. These can be added using the opticaladder
-  if (!inputPulse->IsOptical())
-#endif
-  {
-    GatePulseIterator iter;
-    for (iter=outputPulseList.begin(); iter!= outputPulseList.end() ; ++iter)
-      if ( (*iter)->GetVolumeID()   == inputPulse->GetVolumeID() )
-      {
-           if(m_positionPolicy==kTakeEnergyWin){
-                (*iter)->MergePositionEnergyWin(inputPulse);
+  m_outputPulseOfAddress.clear();
+  m_outputPulsesWithoutAddress.clear();
+  return GateVPulseProcessor::ProcessPulseList(inputPulseList);
+}
 
 
 
+GatePulse* GatePulseAdder::FindOutputPulse(const GatePulse* inputPulse,GatePulseList& outputPulseList)
+{
+  // Each volume has at most one output pulse: when the input has an exact address, it can only
+  // be the pulse with the same address, or one of the pulses whose address is not exact
+  GateDetectorAddress address = inputPulse->GetDetectorAddress();
+  if ( (address>=0) && (address & DETECTOR_ADDRESS_EXACT) ) {
+    std::unordered_map<GateDetectorAddress,GatePulse*>::const_iterator it = m_outputPulseOfAddress.find(address);
+    if (it != m_outputPulseOfAddress.end())
+      return it->second;
+    for (size_t i=0; i<m_outputPulsesWithoutAddress.size(); ++i)
+      if ( m_outputPulsesWithoutAddress[i]->IsInSameVolume(inputPulse) )
+        return m_outputPulsesWithoutAddress[i];
+    return 0;
+  }
+
+  GatePulseIterator iter;
+  for (iter=outputPulseList.begin(); iter!= outputPulseList.end() ; ++iter)
+    if ( (*iter)->IsInSameVolume(inputPulse) )
+      return *iter;
+  return 0;
+}
 
-           }
-           else{
-               (*iter)->CentroidMerge( inputPulse );
-           }
 
 
-	if (nVerboseLevel>1)
-	  G4cout << "Merged previous pulse for volume " << inputPulse->GetVolumeID()
-		 << " with new pulse of energy " << G4BestUnit(inputPulse->GetEnergy(),"Energy") <<".\n"
-		 << "Resulting pulse is: \n"
-		 << **iter << Gateendl << Gateendl ;
-	break;
-      }
+void GatePulseAdder::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList)
+{
+#ifdef GATE_USE_OPTICAL
+  // ignore pulses based on optical photons. These can be added using the opticaladder
+  if (!inputPulse->IsOptical())
+#endif
+  {
+    GatePulse* outputPulse = FindOutputPulse(inputPulse,outputPulseList);
+    if (outputPulse)
+    {
+      if(m_positionPolicy==kTakeEnergyWin)
+        outputPulse->MergePositionEnergyWin(inputPulse);
+      else
+        outputPulse->CentroidMerge( inputPulse );
 
-    if ( iter == outputPulseList.end() )
+      if (nVerboseLevel>1)
+        G4cout << "Merged previous pulse for volume " << inputPulse->GetVolumeID()
+               << " with new pulse of energy " << G4BestUnit(inputPulse->GetEnergy(),"Energy") <<".\n"
+               << "Resulting pulse is: \n"
+               << *outputPulse << Gateendl << Gateendl ;
+    }
+    else
     {
-      GatePulse* outputPulse = new GatePulse(*inputPulse);
+      outputPulse = new GatePulse(*inputPulse);
       outputPulse->SetEnergyIniTrack(-1);
       outputPulse->SetEnergyFin(-1);
       if (nVerboseLevel>1)
-	  G4cout << "Created new pulse for volume " << inputPulse->GetVolumeID() << ".\n"
-		 << "Resulting pulse is: \n"
-		 << *outputPulse << Gateendl << Gateendl ;
+        G4cout << "Created new pulse for volume " << inputPulse->GetVolumeID() << ".\n"
+               << "Resulting pulse is: \n"
+               << *outputPulse << Gateendl << Gateendl ;
       outputPulseList.push_back(outputPulse);
+
+      GateDetectorAddress address = outputPulse->GetDetectorAddress();
+      if ( (address>=0) && (address & DETECTOR_ADDRESS_EXACT) )
+        m_outputPulseOfAddress[address] = outputPulse;
+      else
+        m_outputPulsesWithoutAddress.push_back(outputPulse);
     }
   }
 }
@@ -84,7 +84,7 @@ void GatePulseAdderComptPhotIdeal::ProcessOnePulse(const GatePulse* inputPulse,G
                        EmaxDepos=(*(iter+1))->GetEnergyFin()- (*iter)->GetEnergyFin();
                    }
 
-                    if ( (inputPulse->GetVolumeID() == (*iter)->GetVolumeID()) && (inputPulse->GetEventID() == (*iter)->GetEventID()) && inputPulse->GetEnergyIniTrack()<=(EmaxDepos+epsilonEnergy))
+                    if ( inputPulse->IsInSameVolume(*iter) && (inputPulse->GetEventID() == (*iter)->GetEventID()) && inputPulse->GetEnergyIniTrack()<=(EmaxDepos+epsilonEnergy))
                     {
 
                         //first order secondaries
@@ -145,7 +145,7 @@ void GatePulseAdderComptPhotIdealLocal::ProcessOnePulse(const GatePulse* inputPu
                     std::vector<GatePulse>::reverse_iterator iter = primaryPulsesVol.rbegin();
                     while (1){
 
-                        if ( (inputPulse->GetVolumeID() == (*iter).GetVolumeID()) && (inputPulse->GetEventID() == (*iter).GetEventID())  && inputPulse->GetEnergyIniTrack()<=( EDepmaxPrimV.at((EDepmaxPrimV.size()-1- (iter-primaryPulsesVol.rbegin())))+epsilonEnergy) )
+                        if ( inputPulse->IsInSameVolume(&(*iter)) && (inputPulse->GetEventID() == (*iter).GetEventID())  && inputPulse->GetEnergyIniTrack()<=( EDepmaxPrimV.at((EDepmaxPrimV.size()-1- (iter-primaryPulsesVol.rbegin())))+epsilonEnergy) )
                         //if ( (inputPulse->GetVolumeID() == (*iter).GetVolumeID()) && (inputPulse->GetEventID() == (*iter).GetEventID()) )
                         {
 
@@ -67,7 +67,7 @@ void GatePulseAdderCompton::ProcessOnePulse(const GatePulse* inputPulse,GatePuls
 			{
 				if ( inputPulse->GetPDGEncoding() == ( G4Electron::Electron()->GetPDGEncoding() ) )
 				{
-					if ( (inputPulse->GetVolumeID() == (*currentiter)->GetVolumeID()) && (inputPulse->GetEventID() == (*currentiter)->GetEventID()) )
+					if ( inputPulse->IsInSameVolume(*currentiter) && (inputPulse->GetEventID() == (*currentiter)->GetEventID()) )
 					{
 						(*currentiter)->CentroidMergeCompton(inputPulse);
 						if (nVerboseLevel>1)
@@ -150,7 +150,7 @@ inline void GatePulseAdderCompton::PulsePushBack(const GatePulse* inputPulse, Ga
 
 		//compute how many photonic interactions there were in the last volume id
 		while ( (currentiter != outputPulseList.rend()) &&
-			( ((*currentiter)->GetVolumeID() == (*previousiter)->GetVolumeID() )) && ((*currentiter)->GetEventID() == (*previousiter)->GetEventID()) )
+			(*currentiter)->IsInSameVolume(*previousiter) && ((*currentiter)->GetEventID() == (*previousiter)->GetEventID()) )
 		{
 			count++;
 			currentiter++;
@@ -145,14 +145,25 @@ GatePulseList* GateReadout::ProcessPulseList(const GatePulseList* inputPulseList
   final_pulses = (GatePulse**)calloc(n_pulses,sizeof(GatePulse*));
   G4int final_nb_out_pulses = 0;
 
+  // The blocks are found from their detector address (in the system of the chain) with a hash
+  // table. Only the blocks of the pulses without address are compared one by one.
+  GateVSystem* system = this->GetChain()->GetSystem();
+  m_outputPulseOfBlock.clear();
+  m_outputPulsesWithoutAddress.clear();
+
   // Start loop on input pulses
   GatePulseConstIterator iterIn;
   for (iterIn = inputPulseList->begin() ; iterIn != inputPulseList->end() ; ++iterIn)
   {
     GatePulse* inputPulse = *iterIn;
-    const GateOutputVolumeID& blockID = inputPulse->GetOutputVolumeID().Top(m_depth);
+    const GateOutputVolumeID& outputVolumeID = inputPulse->GetOutputVolumeID();
+
+    // Same test as GetOutputVolumeID().Top(m_depth).IsInvalid(), without the copy
+    G4bool isInvalidBlock = outputVolumeID.empty();
+    for (size_t depth=0; !isInvalidBlock && depth<=(size_t)m_depth && depth<outputVolumeID.size(); ++depth)
+      if (outputVolumeID[depth]<0) isInvalidBlock = true;
 
-    if (blockID.IsInvalid())
+    if (isInvalidBlock)
     {
       if (nVerboseLevel>1)
         G4cout << "[GateReadout::ProcessOnePulse]: out-of-block hit for \n"
@@ -161,10 +172,28 @@ GatePulseList* GateReadout::ProcessPulseList(const GatePulseList* inputPulseList
       continue;
     }
 
-    // Loop inside the temporary output list to see if we have one pulse with same blockID as input
-    int this_output_pulse = 0;
-    for (this_output_pulse=0; this_output_pulse<final_nb_out_pulses; this_output_pulse++)
-      if (final_pulses[this_output_pulse]->GetOutputVolumeID().Top(m_depth) == blockID) break;
+    // Look inside the temporary output list to see if we have one pulse with same blockID as input
+    // (each block has at most one output pulse)
+    GateDetectorAddress blockAddress = inputPulse->GetBlockAddress(m_depth,system);
+    int this_output_pulse = final_nb_out_pulses;
+    if (blockAddress>=0)
+    {
+      std::unordered_map<GateDetectorAddress,G4int>::const_iterator it = m_outputPulseOfBlock.find(blockAddress);
+      if (it != m_outputPulseOfBlock.end())
+        this_output_pulse = it->second;
+      else
+        for (size_t i=0; i<m_outputPulsesWithoutAddress.size(); i++)
+          if (final_pulses[m_outputPulsesWithoutAddress[i]]->IsInSameBlock(inputPulse,m_depth,system))
+          {
+            this_output_pulse = m_outputPulsesWithoutAddress[i];
+            break;
+          }
+    }
+    else
+    {
+      for (this_output_pulse=0; this_output_pulse<final_nb_out_pulses; this_output_pulse++)
+        if (final_pulses[this_output_pulse]->IsInSameBlock(inputPulse,m_depth,system)) break;
+    }
 
     // Case: we found an output pulse with same blockID
     if ( this_output_pulse!=final_nb_out_pulses )
@@ -229,6 +258,8 @@ GatePulseList* GateReadout::ProcessPulseList(const GatePulseList* inputPulseList
       final_energy[final_nb_out_pulses] += energy;
       // Store this pulse in the list
       final_pulses[final_nb_out_pulses] = inputPulse;
+      if (blockAddress>=0) m_outputPulseOfBlock[blockAddress] = final_nb_out_pulses;
+      else m_outputPulsesWithoutAddress.push_back(final_nb_out_pulses);
       // Increment the total number of output pulses
       final_nb_out_pulses++;
     }
@@ -375,27 +375,27 @@ void GateSinoAccelToEcat7::FillData()
         ring_1_min = 0;
         ring_1_max = setMaker->GetRingNb() - ringdiff -1;
       }
-      // loop on the azimuthal angle
-      for (view=0;view<sh->num_angles*m_mashing;view++) {
-        // loop on the axial position
-	for (ring_1 = ring_1_min; ring_1 <= ring_1_max; ++ring_1) {
-	  ring_2 = ring_1 + ringdiff;
-	  z = ring_1 + ring_2 - m_zMinSeg[segment_occurance];
-	  // sinoID = ring_1 + ring_2 * setMaker->GetRingNb();
-	  sinoID = setMaker->GetSinogram()->GetSinoID(ring_1,ring_2);
-	  if (sinoID < 0 || sinoID >= (G4int) setMaker->GetSinogram()->GetSinogramNb()) {
-	    G4Exception( "GateToSinoAccel::RecordEndOfRun", "RecordEndOfRun", FatalException, "Wrong 2D sinogram ID");
-	  }
-	  if (nVerboseLevel>2 && view==0) {
-            G4cout << " >> ring difference " << ringdiff << ", slice " << z << Gateendl;
-            G4cout << "    rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
-	  }
-          //  m_system->GetProjectionSetMaker()->GetProjectionSet()->StreamOut( m_dataFile , headID );
-          m_data = setMaker->GetSinogram()->GetSinogram(sinoID);
-	  bin_m_data = view * setMaker->GetRadialElemNb(); // sinogram ordering
-	  bin_sdata = z * sh->num_r_elements + view / m_mashing * nz * sh->num_r_elements; // view ordering
-	  for (elem=0; elem<sh->num_r_elements; elem++) sdata[bin_sdata+elem] += (short int) m_data[bin_m_data+elem];
-	}
+      // loop on the axial position: each 2D sinogram is expanded once, then
+      // its views are added to the slice
+      for (ring_1 = ring_1_min; ring_1 <= ring_1_max; ++ring_1) {
+        ring_2 = ring_1 + ringdiff;
+        z = ring_1 + ring_2 - m_zMinSeg[segment_occurance];
+        // sinoID = ring_1 + ring_2 * setMaker->GetRingNb();
+        sinoID = setMaker->GetSinogram()->GetSinoID(ring_1,ring_2);
+        if (sinoID < 0 || sinoID >= (G4int) setMaker->GetSinogram()->GetSinogramNb()) {
+          G4Exception( "GateToSinoAccel::RecordEndOfRun", "RecordEndOfRun", FatalException, "Wrong 2D sinogram ID");
+        }
+        if (nVerboseLevel>2) {
+          G4cout << " >> ring difference " << ringdiff << ", slice " << z << Gateendl;
+          G4cout << "    rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
+        }
+        m_data = setMaker->GetSinogram()->GetSinogram(sinoID);
+        // loop on the azimuthal angle
+        for (view=0;view<sh->num_angles*m_mashing;view++) {
+          bin_m_data = view * setMaker->GetRadialElemNb(); // sinogram ordering
+          bin_sdata = z * sh->num_r_elements + view / m_mashing * nz * sh->num_r_elements; // view ordering
+          for (elem=0; elem<sh->num_r_elements; elem++) sdata[bin_sdata+elem] += (short int) m_data[bin_m_data+elem];
+        }
       }
       for (ring_1 = ring_1_min; ring_1 <= ring_1_max; ++ring_1) {
         ring_2 = ring_1 + ringdiff;
@@ -498,39 +498,40 @@ void GateSinoToEcat7::FillData(GateSinogram* setSino)
         ring_1_min = 0;
         ring_1_max = setMaker->GetRingNb() - ringdiff -1;
       }
-      // loop on the azimuthal angle
-      for (view=0;view<sh->num_angles*m_mashing;view++) {
-        // loop on the axial position
-	for (ring_1 = ring_1_min; ring_1 <= ring_1_max; ++ring_1) {
-	  ring_2 = ring_1 + ringdiff;
-	  z = ring_1 + ring_2 - m_zMinSeg[segment_occurance];
-	  // sinoID = ring_1 + ring_2 * setMaker->GetRingNb();
-	  sinoID = setSino->GetSinoID(ring_1,ring_2);
-	  if (sinoID < 0 || sinoID >= (G4int) setSino->GetSinogramNb()) {
-	    G4Exception("GateToSinogram::FillData", "FillData", FatalException, "Wrong 2D sinogram ID");
-	  }
-	  if (nVerboseLevel>2 && view==0) {
-            G4cout << " >> ring difference " << ringdiff << ", slice " << z << Gateendl;
-            G4cout << "    rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
-	  }
-          m_data = setSino->GetSinogram(sinoID);
-	  bin_m_data = view * setMaker->GetRadialElemNb(); // sino ordering
+      // loop on the axial position: each 2D sinogram is expanded once, then
+      // its views are added to the slice
+      for (ring_1 = ring_1_min; ring_1 <= ring_1_max; ++ring_1) {
+        ring_2 = ring_1 + ringdiff;
+        z = ring_1 + ring_2 - m_zMinSeg[segment_occurance];
+        // sinoID = ring_1 + ring_2 * setMaker->GetRingNb();
+        sinoID = setSino->GetSinoID(ring_1,ring_2);
+        if (sinoID < 0 || sinoID >= (G4int) setSino->GetSinogramNb()) {
+          G4Exception("GateToSinogram::FillData", "FillData", FatalException, "Wrong 2D sinogram ID");
+        }
+        if (nVerboseLevel>2) {
+          G4cout << " >> ring difference " << ringdiff << ", slice " << z << Gateendl;
+          G4cout << "    rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
+        }
+        m_data = setSino->GetSinogram(sinoID);
+        // loop on the azimuthal angle
+        for (view=0;view<sh->num_angles*m_mashing;view++) {
+          bin_m_data = view * setMaker->GetRadialElemNb(); // sino ordering
           // CC, 10.02.2011 : allows for span 1
           if (m_span == 1) {
             if (m_ecatVersion == 7) {
-	      bin_sdata = (z/2) * sh->num_r_elements + view / m_mashing * nz * sh->num_r_elements; // view ordering
+              bin_sdata = (z/2) * sh->num_r_elements + view / m_mashing * nz * sh->num_r_elements; // view ordering
             } else {
-	      bin_sdata = view / m_mashing * sh->num_r_elements + (z/2) * sh->num_angles * sh->num_r_elements; // sino ordering
+              bin_sdata = view / m_mashing * sh->num_r_elements + (z/2) * sh->num_angles * sh->num_r_elements; // sino ordering
             }
           } else {
             if (m_ecatVersion == 7) {
- 	      bin_sdata = z * sh->num_r_elements + view / m_mashing * nz * sh->num_r_elements; // view ordering
+              bin_sdata = z * sh->num_r_elements + view / m_mashing * nz * sh->num_r_elements; // view ordering
             } else {
-	      bin_sdata = view / m_mashing * sh->num_r_elements + z * sh->num_angles * sh->num_r_elements; // sino ordering
+              bin_sdata = view / m_mashing * sh->num_r_elements + z * sh->num_angles * sh->num_r_elements; // sino ordering
             }
           }
-	  for (elem=0; elem<sh->num_r_elements; elem++) sdata[bin_sdata+elem] += (short int) m_data[bin_m_data+elem];
-	}
+          for (elem=0; elem<sh->num_r_elements; elem++) sdata[bin_sdata+elem] += (short int) m_data[bin_m_data+elem];
+        }
       }
       for (ring_1 = ring_1_min; ring_1 <= ring_1_max; ++ring_1) {
         ring_2 = ring_1 + ringdiff;
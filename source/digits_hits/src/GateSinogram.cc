@@ -26,6 +26,14 @@ See LICENSE.md for further details
 
 // for std::abs
 #include <cmath>
+// for std::sort, std::inplace_merge
+#include <algorithm>
+
+// Ordering of the sparse bins by bin index
+static inline bool SparseBinLess(const GateSinogram::SparseBin& a, const GateSinogram::SparseBin& b)
+{
+  return a.bin < b.bin;
+}
 
 // Reset the matrix and prepare a new acquisition
 void GateSinogram::Reset(size_t ringNumber, size_t crystalNumber, size_t radialElemNb, size_t virtualRingNumber, size_t virtualCrystalPerBlockNumber)
@@ -44,6 +52,14 @@ void GateSinogram::Reset(size_t ringNumber, size_t crystalNumber, size_t radialE
     free(m_randomsNb);
     m_randomsNb=0;
   }
+  if (m_expandedData) {
+    free(m_expandedData);
+    m_expandedData=0;
+  }
+  // Release the memory of the sparse sinograms (clear() would keep their capacity)
+  std::vector<SparseSinogram>().swap(m_sparseData);
+  std::vector<size_t>().swap(m_sparseSortedNb);
+  m_expandedSinoID = -1;
 
   // Store the new number of sinograms
   m_ringNb = ringNumber;
@@ -63,6 +79,23 @@ void GateSinogram::Reset(size_t ringNumber, size_t crystalNumber, size_t radialE
     return;
   }
 
+  if (m_flagSparseStorage) {
+    if (nVerboseLevel > 2) {
+      G4cout << " >> Allocating " << m_sinogramNb << " sparse 2D sinograms of " << m_radialElemNb <<
+                " radial element X " << m_crystalNb/2 << " views each\n";
+    }
+    // Only the (empty) bin buffers are allocated: they grow with the recorded coincidences
+    m_sparseData.resize(m_sinogramNb);
+    m_sparseSortedNb.assign(m_sinogramNb,0);
+    m_expandedData = (SinogramDataType*) calloc( PixelsPerSinogram() , sizeof(SinogramDataType) );
+    if (!m_expandedData) {
+      G4Exception( "GateSinogram::Reset", "Reset", FatalException, "Could not allocate a 2D sinogram buffer (out of memory?)\n");
+    }
+    m_randomsNb = (SinogramDataType*) calloc( m_sinogramNb , sizeof(SinogramDataType) );
+    if (!m_randomsNb) G4Exception( "GateSinogram::Reset", "Reset", FatalException, "Could not allocate a new randoms array (out of memory?)\n");
+    return;
+  }
+
   if (nVerboseLevel > 2) {
     G4cout << " >> Allocating " << m_sinogramNb << " 2D sinograms of " << m_radialElemNb <<
               " radial element X " << m_crystalNb/2 << " views each\n";
@@ -102,8 +135,17 @@ void GateSinogram::ClearData(size_t frameID, size_t gateID, size_t dataID, size_
     G4cout << "    for frame " << m_currentFrameID << ", gate " << m_currentGateID <<
               ", data " << m_currentDataID << ", bed " << m_currentBedID << Gateendl;
   }
-  for (sinoID=0;sinoID<m_sinogramNb;sinoID++)
-    memset(m_data[sinoID],0, BytesPerSinogram() );
+  if (m_flagSparseStorage) {
+    for (sinoID=0;sinoID<m_sparseData.size();sinoID++) {
+      m_sparseData[sinoID].clear();
+      m_sparseSortedNb[sinoID] = 0;
+    }
+    if (m_expandedData) memset(m_expandedData,0, BytesPerSinogram() );
+    m_expandedSinoID = -1;
+  } else {
+    for (sinoID=0;sinoID<m_sinogramNb;sinoID++)
+      memset(m_data[sinoID],0, BytesPerSinogram() );
+  }
   memset(m_randomsNb,0,m_sinogramNb * sizeof(SinogramDataType));
 }
 
@@ -238,6 +280,29 @@ G4int GateSinogram::Fill( G4int ring1ID, G4int ring2ID, G4int crystal1ID, G4int
       G4cout << " >> [GateSinogram::Fill]: binning LOR at (" <<  crystal1ID << "," << ring1ID << ")-(" << crystal2ID  << ","
       << ring2ID << ") into sinogram bin (" << binElemID << "," << binViewID <<
       ") of 2D sinogram (" << ring1ID+ring2ID << "," << ring2ID-ring1ID << ")\n";
+  if (m_flagSparseStorage) {
+    if (signe == 0) {
+      G4cerr <<   "[GateSinogram::Fill]: filling signe not provided\n";
+      return -8;
+    }
+    // Append the increment: it is summed with the other entries of this bin at the next compaction.
+    // Decrements are stored modulo 2^16, as the dense storage does.
+    if (sinoID == m_expandedSinoID) {
+      // The expanded copy of this 2D sinogram is about to become stale
+      memset(m_expandedData,0, BytesPerSinogram() );
+      m_expandedSinoID = -1;
+    }
+    SparseSinogram& sino = m_sparseData[sinoID];
+    SparseBin entry;
+    entry.bin   = (G4int) (binElemID + binViewID * m_radialElemNb);
+    entry.count = (signe > 0) ? 1 : (SinogramDataType)(-1);
+    sino.push_back(entry);
+    size_t sortedNb = m_sparseSortedNb[sinoID];
+    if (sino.size() - sortedNb > std::max(sortedNb,m_sparseCompactionThreshold))
+      CompactSparseSinogram(sinoID);
+    return 0;
+  }
+
   SinogramDataType& dest = m_data[sinoID][ binElemID + binViewID * m_radialElemNb];
 
   if (signe > 0) {
@@ -268,7 +333,55 @@ void GateSinogram::StreamOut(std::ofstream& dest, size_t sinoID, size_t seekID)
     if (sinoID >= m_sinogramNb) G4Exception( "GateSinogram::StreamOut", "StreamOut", FatalException, "SinoID out of range !\n");
     dest.seekp(seekID * BytesPerSinogram(),std::ios::beg);
     if ( dest.bad() ) G4Exception( "GateSinogram::StreamOut", "StreamOut", FatalException, "Could not write a 2D sinogram onto the disk (out of disk space?)!\n");
-    dest.write((const char*)(m_data[sinoID]),BytesPerSinogram() );
+    dest.write((const char*)(GetSinogram(sinoID)),BytesPerSinogram() );
     if ( dest.bad() ) G4Exception( "GateToSinogram:StreamOut", "StreamOut", FatalException, "Could not write a 2D sinogram onto the disk (out of disk space?)!\n");
     dest.flush();
 }
+
+
+
+// Returns a 2D sinogram from the set (expanded into m_expandedData for sparse sinograms)
+GateSinogram::SinogramDataType* GateSinogram::GetSinogram(size_t sinoID)
+{
+  if (!m_flagSparseStorage)
+    return m_data[sinoID];
+
+  if (sinoID >= m_sparseData.size()) G4Exception( "GateSinogram::GetSinogram", "GetSinogram", FatalException, "SinoID out of range !\n");
+
+  // Only the bins set by the previous expansion have to be reset, not the whole buffer
+  if (m_expandedSinoID >= 0) {
+    const SparseSinogram& previous = m_sparseData[m_expandedSinoID];
+    for (size_t i=0;i<previous.size();i++) m_expandedData[previous[i].bin] = 0;
+  }
+  CompactSparseSinogram(sinoID);
+  const SparseSinogram& sino = m_sparseData[sinoID];
+  for (size_t i=0;i<sino.size();i++) m_expandedData[sino[i].bin] = sino[i].count;
+  m_expandedSinoID = sinoID;
+  return m_expandedData;
+}
+
+
+
+/* Sort the unsorted tail of a sparse 2D sinogram, merge it into the sorted head,
+   sum the entries of identical bins and drop the bins whose content is back to zero
+*/
+void GateSinogram::CompactSparseSinogram(size_t sinoID)
+{
+  SparseSinogram& sino = m_sparseData[sinoID];
+  size_t sortedNb = m_sparseSortedNb[sinoID];
+  if (sortedNb == sino.size()) return;
+
+  std::sort(sino.begin()+sortedNb,sino.end(),SparseBinLess);
+  std::inplace_merge(sino.begin(),sino.begin()+sortedNb,sino.end(),SparseBinLess);
+
+  SparseSinogram::iterator dest = sino.begin();
+  SparseSinogram::iterator it = sino.begin();
+  while (it != sino.end()) {
+    SparseBin merged = *it;
+    for (++it ; (it != sino.end()) && (it->bin == merged.bin) ; ++it)
+      merged.count = (SinogramDataType)(merged.count + it->count);
+    if (merged.count) *dest++ = merged;
+  }
+  sino.erase(dest,sino.end());
+  m_sparseSortedNb[sinoID] = sino.size();
+}
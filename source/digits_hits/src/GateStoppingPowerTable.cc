@@ -0,0 +1,186 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#include "GateStoppingPowerTable.hh"
+#include "GateMessageManager.hh"
+
+#include <cmath>
+#include <G4EmCalculator.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4Material.hh>
+#include <G4UnitsTable.hh>
+
+//-----------------------------------------------------------------------------
+GateStoppingPowerTable::GateStoppingPowerTable(G4EmCalculator * calc, DEDXType type, G4double cut)
+  :mEmCalculator(calc), mType(type), mCut(cut), mBinsPerDecade(50)
+{
+  SetEnergyRange(1*keV, 10*GeV);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateStoppingPowerTable::SetBinsPerDecade(G4int n)
+{
+  if (n < 1) GateError("The number of bins per decade of the dedx tables must be positive");
+  mBinsPerDecade = n;
+  SetEnergyRange(mEmin, mEmax);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateStoppingPowerTable::SetEnergyRange(G4double emin, G4double emax)
+{
+  if (emin <= 0 || emax <= emin) GateError("Wrong energy range of the dedx tables");
+  mEmin = emin;
+  mEmax = emax;
+  mLogEmin = std::log(mEmin);
+  mInvLogStep = mBinsPerDecade/std::log(10.);
+  Clear();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateStoppingPowerTable::Clear()
+{
+  mTables.clear();
+  mRatioTables.clear();
+  mLastKey = Key(0, 0);
+  mLastTable = 0;
+  mLastRatioKey = RatioKey(mLastKey, 0);
+  mLastRatioTable = 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4double GateStoppingPowerTable::Compute(G4double energy, const G4ParticleDefinition * p, const G4Material * m)
+{
+  if (mType == kElectronicDEDX) return mEmCalculator->ComputeElectronicDEDX(energy, p, m, mCut);
+  return mEmCalculator->ComputeTotalDEDX(energy, p, m, mCut);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4double GateStoppingPowerTable::ComputeRatio(G4double energy, const G4ParticleDefinition * p,
+                                              const G4Material * m, const G4Material * ref)
+{
+  G4double dedx = Compute(energy, p, m);
+  G4double dedxRef = Compute(energy, p, ref);
+  if (dedx == 0 || dedxRef == 0) return 0;
+  return dedxRef/dedx;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+inline G4double GateStoppingPowerTable::Interpolate(const Table & t, G4double energy) const
+{
+  G4double x = (std::log(energy) - mLogEmin)*mInvLogStep;
+  size_t i = (size_t)x;
+  if (i >= t.size()-1) i = t.size()-2;
+  G4double f = x - i;
+  return t[i] + f*(t[i+1] - t[i]);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const GateStoppingPowerTable::Table &
+GateStoppingPowerTable::GetTable(const G4ParticleDefinition * p, const G4Material * m)
+{
+  Key key(p, m);
+  if (mLastTable && key == mLastKey) return *mLastTable;
+
+  std::map<Key, Table>::iterator it = mTables.find(key);
+  if (it == mTables.end()) {
+    // bins are the energies mEmin*10^(i/mBinsPerDecade), up to mEmax included
+    size_t n = (size_t)std::ceil(std::log10(mEmax/mEmin)*mBinsPerDecade) + 1;
+    Table t(n);
+    for (size_t i = 0; i < n; i++)
+      t[i] = Compute(mEmin*std::pow(10., (G4double)i/mBinsPerDecade), p, m);
+    it = mTables.insert(std::make_pair(key, t)).first;
+    CheckTable(it->second, "dedx", p, m, 0);
+  }
+  mLastKey = key;
+  mLastTable = &it->second;
+  return it->second;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const GateStoppingPowerTable::Table &
+GateStoppingPowerTable::GetRatioTable(const G4ParticleDefinition * p, const G4Material * m, const G4Material * ref)
+{
+  RatioKey key(Key(p, m), ref);
+  if (mLastRatioTable && key == mLastRatioKey) return *mLastRatioTable;
+
+  std::map<RatioKey, Table>::iterator it = mRatioTables.find(key);
+  if (it == mRatioTables.end()) {
+    size_t n = (size_t)std::ceil(std::log10(mEmax/mEmin)*mBinsPerDecade) + 1;
+    Table t(n);
+    for (size_t i = 0; i < n; i++)
+      t[i] = ComputeRatio(mEmin*std::pow(10., (G4double)i/mBinsPerDecade), p, m, ref);
+    it = mRatioTables.insert(std::make_pair(key, t)).first;
+    CheckTable(it->second, "dedx ratio", p, m, ref);
+  }
+  mLastRatioKey = key;
+  mLastRatioTable = &it->second;
+  return it->second;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4double GateStoppingPowerTable::GetDEDX(G4double energy, const G4ParticleDefinition * p, const G4Material * m)
+{
+  if (!InRange(energy)) return Compute(energy, p, m);
+  return Interpolate(GetTable(p, m), energy);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4double GateStoppingPowerTable::GetDEDXRatio(G4double energy, const G4ParticleDefinition * p,
+                                              const G4Material * m, const G4Material * ref)
+{
+  if (!InRange(energy)) return ComputeRatio(energy, p, m, ref);
+  return Interpolate(GetRatioTable(p, m, ref), energy);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Compares the interpolation with G4EmCalculator in the middle of the bins,
+// where the interpolation error is the largest.
+void GateStoppingPowerTable::CheckTable(const Table & t, const G4String & name,
+                                        const G4ParticleDefinition * p, const G4Material * m,
+                                        const G4Material * ref)
+{
+  if (GateMessageManager::GetMessageLevel("Actor") < 2) return;
+  G4double maxDeviation = 0;
+  G4double maxEnergy = 0;
+  for (size_t i = 0; i+1 < t.size(); i++) {
+    G4double energy = mEmin*std::pow(10., (i+0.5)/mBinsPerDecade);
+    if (!InRange(energy)) break;
+    G4double exact = ref ? ComputeRatio(energy, p, m, ref) : Compute(energy, p, m);
+    if (exact == 0) continue;
+    G4double deviation = std::fabs(Interpolate(t, energy)/exact - 1);
+    if (deviation > maxDeviation) { maxDeviation = deviation; maxEnergy = energy; }
+  }
+  GateMessage("Actor", 2, "Table of " << name << " for " << p->GetParticleName()
+              << " in " << m->GetName() << (ref ? " to "+ref->GetName() : G4String(""))
+              << ": " << t.size() << " bins, max relative deviation "
+              << maxDeviation << " at " << G4BestUnit(maxEnergy, "Energy") << Gateendl);
+}
+//-----------------------------------------------------------------------------
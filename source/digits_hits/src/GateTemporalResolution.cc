@@ -76,6 +76,24 @@ void GateTemporalResolution::ProcessOnePulse(const GatePulse* inputPulse,GatePul
 }
 
 
+void GateTemporalResolution::ProcessPulseBatch(const GatePulseList&, std::vector<G4double>&,
+                                               std::vector<G4double>& times, std::vector<char>& keep)
+{
+  if(m_timeResolution < 0 ) {
+    G4cerr << 	Gateendl << "[GateTemporalResolution::ProcessPulseBatch]:\n"
+      	   <<   "Sorry, but the resolution (" << GetTimeResolution() << ") is invalid\n";
+    G4Exception( "GateTemporalResolution::ProcessPulseBatch", "ProcessPulseBatch", FatalException,
+			"You must choose a temporal resolution >= 0 /gate/digitizer/Singles/Singles/timeResolution/setTimeResolution TIME\n or disable the temporal resolution using:\n\t/gate/digitizer/Singles/Singles/timeResolution/disable\n");
+  }
+
+  G4double sigma =  m_timeResolution / GateConstants::fwhm_to_sigma;
+  m_sigmas.assign(times.size(),-1.);
+  for (size_t i=0; i<times.size(); ++i)
+    if (keep[i]) m_sigmas[i] = sigma;
+  ShootGaussArray(times,m_sigmas);
+}
+
+
 void GateTemporalResolution::DescribeMyself(size_t indent)
 {
   G4cout << GateTools::Indent(indent) << "Temporal resolution: " << G4BestUnit(m_timeResolution,"Time") << Gateendl;
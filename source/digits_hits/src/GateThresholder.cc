@@ -63,6 +63,16 @@ void GateThresholder::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList&
 
 
 
+void GateThresholder::ProcessPulseBatch(const GatePulseList&, std::vector<G4double>& energies,
+                                        std::vector<G4double>&, std::vector<char>& keep)
+{
+  for (size_t i=0; i<energies.size(); ++i)
+    if ( energies[i]==0 || energies[i] < m_threshold )
+      keep[i] = 0;
+}
+
+
+
 void GateThresholder::DescribeMyself(size_t indent)
 {
   G4cout << GateTools::Indent(indent) << "Threshold: " << G4BestUnit(m_threshold,"Energy") << Gateendl;
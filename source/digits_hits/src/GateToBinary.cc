@@ -13,18 +13,24 @@
 #ifdef G4ANALYSIS_USE_FILE
 
 #include <limits>
+#include <cmath>
+#include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
 
 #include "GateToBinaryMessenger.hh"
 #include "GateOutputMgr.hh"
 #include "GateVGeometryVoxelStore.hh"
+#include "GateSystemListManager.hh"
+#include "GateVSystem.hh"
 #include "G4DigiManager.hh"
 
 // 0x79000000 equivalent to 2,030,043,136 bytes
 #define LIMIT_SIZE 0x79000000
 
 G4int GateToBinary::VOutputChannel::m_outputFileSizeLimit = LIMIT_SIZE;
+G4bool GateToBinary::m_compactFormat = false;
+std::vector< G4int > GateToBinary::m_crystalIDFactors;
 
 GateToBinary::GateToBinary( G4String const& name, GateOutputMgr* outputMgr,
                             DigiMode digiMode )
@@ -73,6 +79,27 @@ void GateToBinary::RecordBeginOfAcquisition()
                           std::ios::out | std::ios::binary );
     }
 
+  if( m_compactFormat )
+    {
+      // Factors of the linear crystal ID, with all the levels of the system
+      m_crystalIDFactors.clear();
+      GateVSystem* system = GateSystemListManager::GetInstance()->GetSystem( 0 );
+      if( system )
+        {
+          std::vector< G4bool > enableList( system->GetTreeDepth(), true );
+          for( size_t lvl = 0; lvl < system->GetTreeDepth(); ++lvl )
+            {
+              m_crystalIDFactors.push_back(
+                                           system->ComputeNofSubCrystalsAtLevel( lvl, enableList ) );
+            }
+        }
+      else if( nVerboseLevel > 0 )
+        {
+          std::cout << "GateToBinary: no system defined, crystal IDs of the "
+                    << "compact format are set to -1\n";
+        }
+    }
+
   for( size_t i = 0; i < m_outputChannelVector.size(); ++i )
     {
       m_outputChannelVector[ i ]->OpenFile( m_fileName );
@@ -419,11 +446,18 @@ void GateToBinary::VOutputChannel::OpenFile(
     }
 
   G4String fileName = aFileBaseName + m_collectionName + fileCounterSuffix
-    + ".dat";
+    + ( m_compactFormat ? ".clm" : ".dat" );
   if( m_outputFlag )
     {
-      m_outputFile.open( fileName.c_str(), std::ios::out |
-                         std::ios::binary );
+      if( m_compactFormat )
+        {
+          m_compactWriter->Open( fileName );
+        }
+      else
+        {
+          m_outputFile.open( fileName.c_str(), std::ios::out |
+                             std::ios::binary );
+        }
     }
   m_fileBaseName = aFileBaseName;
   ++m_fileCounter;
@@ -434,12 +468,23 @@ void GateToBinary::VOutputChannel::CloseFile()
 {
   if( m_outputFlag )
     {
-      m_outputFile.close();
+      if( m_compactWriter->IsOpen() )
+        {
+          m_compactWriter->Close();
+        }
+      else
+        {
+          m_outputFile.close();
+        }
     }
 }
 
 G4bool GateToBinary::VOutputChannel::ExceedsSize()
 {
+  if( m_compactWriter->IsOpen() )
+    {
+      return m_compactWriter->GetBytesWritten() > m_outputFileSizeLimit;
+    }
   G4int size = m_outputFile.tellp();
   //std::cout << "size: " << size << " B\n";
   return size > m_outputFileSizeLimit;
@@ -489,6 +534,19 @@ void GateToBinary::CoincidenceOutputChannel::RecordDigitizer()
                       OpenFile( m_fileBaseName );
                     }
                 }
+
+              if( m_compactFormat )
+                {
+                  char record[ 2 * kCompactRecordSize ];
+                  GateCoincidenceDigi* digi = (*CDC)[ iDigi ];
+                  PackCompactRecord( digi->GetPulse( 0 ), record );
+                  PackCompactRecord( digi->GetPulse( 1 ),
+                                     record + kCompactRecordSize );
+                  m_compactWriter->Append( record,
+                                           digi->GetPulse( 0 ).GetTime()/s );
+                  continue;
+                }
+
               // For the 2 pulses
               G4int runID( 0 ), eventID( 0 ), sourceID( 0 );
               G4double posX( 0.0 ), posY( 0.0 ), posZ( 0.0 ), time( 0.0 );
@@ -692,6 +750,15 @@ void GateToBinary::SingleOutputChannel::RecordDigitizer()
                     }
                 }
 
+              if( m_compactFormat )
+                {
+                  char record[ kCompactRecordSize ];
+                  PackCompactRecord( (*SDC)[ iDigi ]->GetPulse(), record );
+                  m_compactWriter->Append( record,
+                                           (*SDC)[ iDigi ]->GetTime()/s );
+                  continue;
+                }
+
               G4int runID( 0 ), eventID( 0 ), sourceID( 0 );
               G4double sourcePosX( 0.0 ), sourcePosY( 0.0 ), sourcePosZ( 0.0 );
               G4double posX( 0.0 ), posY( 0.0 ), posZ( 0.0 ), time( 0.0 );
@@ -854,6 +921,73 @@ void GateToBinary::SingleOutputChannel::RecordDigitizer()
     }
 }
 
+G4int GateToBinary::ComputeCrystalID( GateOutputVolumeID const& volumeID )
+{
+  if( m_crystalIDFactors.empty() )
+    {
+      return -1;
+    }
+  G4int crystalID = 0;
+  for( size_t lvl = 0;
+       lvl < volumeID.size() && lvl < m_crystalIDFactors.size(); ++lvl )
+    {
+      if( volumeID[ lvl ] >= 0 )
+        {
+          crystalID += volumeID[ lvl ] * m_crystalIDFactors[ lvl ];
+        }
+    }
+  return crystalID;
+}
+
+namespace
+{
+  // Quantize a value on an integer field, saturating at the field limits
+  template< typename T >
+  inline T Quantize( G4double value, G4double lsb )
+  {
+    G4double q = std::floor( value / lsb + 0.5 );
+    if( q < static_cast< G4double >( std::numeric_limits< T >::min() ) )
+      {
+        return std::numeric_limits< T >::min();
+      }
+    if( q > static_cast< G4double >( std::numeric_limits< T >::max() ) )
+      {
+        return std::numeric_limits< T >::max();
+      }
+    return static_cast< T >( q );
+  }
+
+  template< typename T >
+  inline void Put( char*& dest, T value )
+  {
+    std::memcpy( dest, &value, sizeof( T ) );
+    dest += sizeof( T );
+  }
+}
+
+void GateToBinary::PackCompactRecord( GatePulse const& pulse, char* dest )
+{
+  G4double const positionLSB = GateListModeBlockWriter::kPositionLSB;
+  G4ThreeVector const& pos = pulse.GetGlobalPos();
+
+  Put( dest, Quantize< unsigned long long >( pulse.GetTime()/s,
+                                             GateListModeBlockWriter::kTimeLSB ) );
+  Put( dest, static_cast< G4int >( pulse.GetEventID() ) );
+  Put( dest, static_cast< unsigned int >(
+                                         ComputeCrystalID( pulse.GetOutputVolumeID() ) ) );
+  Put( dest, Quantize< short >( pos.x()/mm, positionLSB ) );
+  Put( dest, Quantize< short >( pos.y()/mm, positionLSB ) );
+  Put( dest, Quantize< short >( pos.z()/mm, positionLSB ) );
+  Put( dest, Quantize< unsigned short >( pulse.GetEnergy()/MeV,
+                                         GateListModeBlockWriter::kEnergyLSB ) );
+  Put( dest, Quantize< unsigned short >( pulse.GetRunID(), 1.0 ) );
+  Put( dest, Quantize< unsigned short >( pulse.GetSourceID(), 1.0 ) );
+  Put( dest, Quantize< unsigned char >( pulse.GetNPhantomCompton(), 1.0 ) );
+  Put( dest, Quantize< unsigned char >( pulse.GetNCrystalCompton(), 1.0 ) );
+  Put( dest, Quantize< unsigned char >( pulse.GetNPhantomRayleigh(), 1.0 ) );
+  Put( dest, Quantize< unsigned char >( pulse.GetNCrystalRayleigh(), 1.0 ) );
+}
+
 /*!
  * \brief Truncates or pads a string with '\0' for a fixed size
  *
@@ -72,11 +72,34 @@ GateToBinaryMessenger::GateToBinaryMessenger( GateToBinary* gateToBinary )
   m_setOutFileSizeLimitCmd->SetGuidance(
                                         "Set the limit for the size (bytes) of the output binary data files" );
   m_setOutFileSizeLimitCmd->SetParameterName( "size", false );
+
+  cmdName = GetDirectoryName() + "setCompactFormat";
+  m_compactFormatCmd = new G4UIcmdWithABool( cmdName, this );
+  m_compactFormatCmd->SetGuidance(
+                                  "Write singles and coincidences as packed fixed-width records in compressed, indexed blocks (.clm files)" );
+  m_compactFormatCmd->SetGuidance( "1. true/false" );
+
+  cmdName = GetDirectoryName() + "setCompressionLevel";
+  m_compressionLevelCmd = new G4UIcmdWithAnInteger( cmdName, this );
+  m_compressionLevelCmd->SetGuidance(
+                                     "Set the zlib compression level of the compact format blocks (0: no compression, 1-9)" );
+  m_compressionLevelCmd->SetParameterName( "level", false );
+  m_compressionLevelCmd->SetRange( "level>=0 && level<=9" );
+
+  cmdName = GetDirectoryName() + "setRecordsPerBlock";
+  m_recordsPerBlockCmd = new G4UIcmdWithAnInteger( cmdName, this );
+  m_recordsPerBlockCmd->SetGuidance(
+                                    "Set the number of records per compressed block of the compact format" );
+  m_recordsPerBlockCmd->SetParameterName( "number", false );
+  m_recordsPerBlockCmd->SetRange( "number>0" );
 }
 
 GateToBinaryMessenger::~GateToBinaryMessenger()
 {
   delete m_setOutFileSizeLimitCmd;
+  delete m_compactFormatCmd;
+  delete m_compressionLevelCmd;
+  delete m_recordsPerBlockCmd;
   delete m_coincidenceMaskCmd;
   delete m_singleMaskCmd;
   delete m_outFileHitsCmd;
@@ -130,6 +153,21 @@ void GateToBinaryMessenger::SetNewValue( G4UIcommand* command,
       GateToBinary::VOutputChannel::SetOutputFileSizeLimit(
                                                            m_setOutFileSizeLimitCmd->GetNewIntValue( newValue ) );
     }
+  else if( command == m_compactFormatCmd )
+    {
+      GateToBinary::SetCompactFormat(
+                                     m_compactFormatCmd->GetNewBoolValue( newValue ) );
+    }
+  else if( command == m_compressionLevelCmd )
+    {
+      GateListModeBlockWriter::SetCompressionLevel(
+                                                   m_compressionLevelCmd->GetNewIntValue( newValue ) );
+    }
+  else if( command == m_recordsPerBlockCmd )
+    {
+      GateListModeBlockWriter::SetRecordsPerBlock(
+                                                  m_recordsPerBlockCmd->GetNewIntValue( newValue ) );
+    }
   else if( command == m_setFileNameCmd )
     {
       m_gateToBinary->SetFileName( newValue );
@@ -106,6 +106,8 @@ GateToRoot::GateToRoot(const G4String& name, GateOutputMgr* outputMgr,DigiMode d
   , m_rootHitFlag(digiMode==kruntimeMode)
   , m_rootNtupleFlag(true)
   , m_saveRndmFlag(true)
+  , m_compressionLevel(-1)
+  , m_implicitMTThreads(0)
   , m_fileName(" ") // All default output file from all output modules are set to " ".
                     // They are then checked in GateApplicationMgr::StartDAQ, using
                     // the VOutputModule pure virtual method GiveNameOfFile()
@@ -308,6 +310,17 @@ void GateToRoot::RecordBeginOfAcquisition()
         }
       ////
       //////////
+      // Let ROOT compress and write the baskets in parallel with the simulation
+      if (m_implicitMTThreads > 0) {
+#ifdef R__USE_IMT
+        if (!ROOT::IsImplicitMTEnabled())
+          ROOT::EnableImplicitMT(m_implicitMTThreads);
+#else
+        G4cout << "GateToRoot: ROOT was built without implicit multi-threading, "
+               << "the baskets are written by the simulation thread.\n";
+#endif
+      }
+
       // Open the output file
       if (nVerboseLevel > 0) G4cout << "GateToRoot: ROOT: files creation...\n";
       switch (m_digiMode) {
@@ -364,6 +377,9 @@ void GateToRoot::RecordBeginOfAcquisition()
           G4String msg = "Could not open the requested output ROOT file '" + m_fileName + ".root'!";
           G4Exception( "GateToRoot::RecordBeginOfAcquisition", "RecordBeginOfAcquisition", FatalException, msg );
 	}
+      if (m_compressionLevel >= 0)
+        m_hfile->SetCompressionLevel(m_compressionLevel);
+
       //! We book histos and ntuples only once per acquisition
       Book();
 
@@ -713,21 +729,18 @@ void GateToRoot::RecordEndOfEvent(const G4Event* event)
    for (G4int iHit=0;iHit<NbHits;iHit++) {
  
       GateCrystalHit* aHit = (*CHC)[iHit];
-      G4String processName = aHit->GetProcess();
-      G4int PDGEncoding  =   aHit->GetPDGEncoding();
 
       if (nVerboseLevel > 2)
         G4cout
-          << "GateToRoot::RecordEndOfEvent : CrystalHitsCollection: processName : <" << processName
-          << ">    Particls PDG code : " << PDGEncoding << Gateendl;
+          << "GateToRoot::RecordEndOfEvent : CrystalHitsCollection: processName : <" << aHit->GetProcess()
+          << ">    Particls PDG code : " << aHit->GetPDGEncoding() << Gateendl;
 
-      if (aHit->GoodForAnalysis()) {
-  m_hitBuffer.Fill(aHit);
+      if (aHit->GoodForAnalysis() && m_rootHitFlag) {
+	m_hitBuffer.Fill(aHit);
 	if (nVerboseLevel > 1)
 	  G4cout << "GateToRoot::RecordEndOfEvent : m_treeHit->Fill\n";
 
-
-	if (m_rootHitFlag) m_treeHit->Fill();
+	m_treeHit->Fill();
       }
     }
 
@@ -99,6 +99,41 @@ GateToRootMessenger::GateToRootMessenger(GateToRoot* gateToRoot)
     SingleMaskCmd->SetParameter(MaskParam);
   }
 
+  cmdName = GetDirectoryName()+"setHitMask";
+  HitMaskCmd = new G4UIcommand(cmdName,this);
+  HitMaskCmd->SetGuidance("Set the mask for the hit ROOT output: masked columns are neither booked nor computed");
+  HitMaskCmd->SetGuidance("Sequence of 0 / 1, columns beyond the sequence are kept");
+
+  m_hitMaskLength = 29;
+  for (G4int iMask=0; iMask<m_hitMaskLength; iMask++) {
+    G4UIparameter* MaskParam = new G4UIparameter("mask",'b',true);
+    MaskParam->SetDefaultValue(true);
+    HitMaskCmd->SetParameter(MaskParam);
+  }
+
+  cmdName = GetDirectoryName()+"setBasketSize";
+  BasketSizeCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  BasketSizeCmd->SetGuidance("Set the basket size of the tree branches in bytes (0: ROOT default)");
+  BasketSizeCmd->SetParameterName("Size",false);
+  BasketSizeCmd->SetRange("Size>=0");
+
+  cmdName = GetDirectoryName()+"setCompressionLevel";
+  CompressionLevelCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  CompressionLevelCmd->SetGuidance("Set the compression level of the output ROOT file (0: none, 1-9, -1: ROOT default)");
+  CompressionLevelCmd->SetParameterName("Level",false);
+  CompressionLevelCmd->SetRange("Level>=-1 && Level<=9");
+
+  cmdName = GetDirectoryName()+"setAutoSave";
+  AutoSaveCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  AutoSaveCmd->SetGuidance("Set the auto-save period of the trees (>0: bytes, <0: entries, 0: no auto-save)");
+  AutoSaveCmd->SetParameterName("Period",false);
+
+  cmdName = GetDirectoryName()+"setImplicitMT";
+  ImplicitMTCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  ImplicitMTCmd->SetGuidance("Set the number of ROOT threads compressing and writing the baskets (0: disabled)");
+  ImplicitMTCmd->SetParameterName("Threads",false);
+  ImplicitMTCmd->SetRange("Threads>=0");
+
 }
 //--------------------------------------------------------------------------
 
@@ -114,6 +149,11 @@ GateToRootMessenger::~GateToRootMessenger()
   delete SetFileNameCmd;
   delete CoincidenceMaskCmd;
   delete SingleMaskCmd;
+  delete HitMaskCmd;
+  delete BasketSizeCmd;
+  delete CompressionLevelCmd;
+  delete AutoSaveCmd;
+  delete ImplicitMTCmd;
   delete SaveRndmCmd;
   for (size_t i = 0; i<OutputChannelCmdList.size() ; ++i)
     delete OutputChannelCmdList[i];
@@ -179,7 +219,27 @@ void GateToRootMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
       //      G4cout << "[GateToASCIIMessenger::SetNewValue] iMask: " << iMask << " maskVector[iMask]: " << maskVector[iMask] << Gateendl;
     }
     GateSingleDigi::SetSingleASCIIMask( maskVector );
-  
+
+  } else if (command == HitMaskCmd) {
+
+    std::vector<G4bool> maskVector;
+    std::istringstream is(newValue);
+    G4int tempIntBool;
+    for (G4int iMask=0; iMask<m_hitMaskLength; iMask++) {
+      is >> tempIntBool; // NB: is >> bool does not work, so we put is to an integer and we copy the integer to the bool
+      maskVector.push_back(tempIntBool != 0);
+    }
+    GateRootDefs::SetHitMask( maskVector );
+
+  } else if (command == BasketSizeCmd) {
+    GateRootDefs::SetBasketSize(BasketSizeCmd->GetNewIntValue(newValue));
+  } else if (command == CompressionLevelCmd) {
+    m_gateToRoot->SetCompressionLevel(CompressionLevelCmd->GetNewIntValue(newValue));
+  } else if (command == AutoSaveCmd) {
+    GateRootDefs::SetAutoSave(AutoSaveCmd->GetNewIntValue(newValue));
+  } else if (command == ImplicitMTCmd) {
+    m_gateToRoot->SetImplicitMTThreads(ImplicitMTCmd->GetNewIntValue(newValue));
+
   } else {
     GateOutputModuleMessenger::SetNewValue(command,newValue);
   }
@@ -387,7 +387,7 @@ void GateToSinoAccel::Describe(size_t indent)
   G4cout << GateTools::Indent(indent) << " >> Number of crystals per crystal ring " << m_crystalNb << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Number of crystal rings             " << m_ringNb << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Number of radial sinogram bins      " << m_radialElemNb << Gateendl;
-  G4cout << GateTools::Indent(indent) << " >> Filled?                             " << ( m_sinogram->GetData() ? "Yes" : "No" ) << Gateendl;
+  G4cout << GateTools::Indent(indent) << " >> Filled?                             " << ( m_sinogram->IsAllocated() ? "Yes" : "No" ) << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Attached to system:                 " << m_system->GetObjectName() << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Input data                          " << m_inputDataChannel;
 }
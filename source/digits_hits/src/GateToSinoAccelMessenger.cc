@@ -72,6 +72,18 @@ GateToSinoAccelMessenger::GateToSinoAccelMessenger(GateToSinoAccel* gateToSinoAc
   SetAxialCrystalResolCmd->SetRange("Number>=0.");
   SetAxialCrystalResolCmd->SetUnitCategory("Length");
 
+  cmdName = GetDirectoryName()+"SparseStorage";
+  SparseStorageCmd = new G4UIcmdWithABool(cmdName,this);
+  SparseStorageCmd->SetGuidance("Store the 2D sinograms as sparse bin buffers: memory grows with the number of coincidences instead of the number of ring pairs");
+  SparseStorageCmd->SetParameterName("flag",true);
+  SparseStorageCmd->SetDefaultValue(true);
+
+  cmdName = GetDirectoryName()+"setSparseCompactionThreshold";
+  SetSparseCompactionThresholdCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  SetSparseCompactionThresholdCmd->SetGuidance("Set the minimum number of new entries a sparse 2D sinogram buffers before they are sorted and merged (1024 by default): larger values use more memory and compact less often");
+  SetSparseCompactionThresholdCmd->SetParameterName("Number",false);
+  SetSparseCompactionThresholdCmd->SetRange("Number>=0");
+
 }
 GateToSinoAccelMessenger::~GateToSinoAccelMessenger()
 {
@@ -82,6 +94,8 @@ GateToSinoAccelMessenger::~GateToSinoAccelMessenger()
   delete SetTangCrystalResolCmd;
   delete SetAxialCrystalResolCmd;
   delete SetInputDataCmd;
+  delete SparseStorageCmd;
+  delete SetSparseCompactionThresholdCmd;
 }
 
 void GateToSinoAccelMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
@@ -100,6 +114,10 @@ void GateToSinoAccelMessenger::SetNewValue(G4UIcommand* command,G4String newValu
     { m_gateToSinoAccel->SetAxialCrystalResolution(SetAxialCrystalResolCmd->GetNewDoubleValue(newValue)); }
   else if (command == SetInputDataCmd)
     { m_gateToSinoAccel->SetOutputDataName(newValue); }
+  else if (command == SparseStorageCmd)
+    { m_gateToSinoAccel->SparseStorage(SparseStorageCmd->GetNewBoolValue(newValue)); }
+  else if (command == SetSparseCompactionThresholdCmd)
+    { m_gateToSinoAccel->SetSparseCompactionThreshold(SetSparseCompactionThresholdCmd->GetNewIntValue(newValue)); }
   else
     { GateOutputModuleMessenger::SetNewValue(command,newValue); }
 }
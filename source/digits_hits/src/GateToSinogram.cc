@@ -74,6 +74,10 @@ GateToSinogram::GateToSinogram(const G4String& name, GateOutputMgr* outputMgr,Ga
   , m_virtualRingPerBlockNb(0)
   , m_virtualCrystalPerBlockNb(0)
 
+  , m_flagSparseStorage(false)
+  , m_sparseCompactionThreshold(1024)
+  , m_maxRingDifference(-1)
+
 {
   m_isEnabled = false; // Keep this flag false: all output are disabled by default
   m_sinogram = new GateSinogram();
@@ -194,7 +198,25 @@ void GateToSinogram::RecordBeginOfAcquisition()
     G4cout << "    Crystal location blurring in axial direction: " << m_axialCrystalResolution/mm << " mm\n";
   }
 
+  if (m_maxRingDifference >= (G4int) m_ringNb) {
+    G4cerr  <<  Gateendl << " !!! [GateToSinogram::RecordBeginOfAcquisition]:\n"
+	    <<   "Sorry, but the maximum ring difference (" << m_maxRingDifference << ") should be smaller than " << m_ringNb << Gateendl;
+    G4Exception( "GateToSinogram::RecordBeginOfAcquisition", "RecordBeginOfAcquisition", FatalException, "You must change this parameter then restart the simulation\n");
+  }
+  if (nVerboseLevel > 1) {
+    G4cout << "    Maximum ring difference written:   " << GetMaxRingDifference() << Gateendl;
+    G4cout << "    Sparse sinogram storage:           " << ( m_flagSparseStorage ? "Yes" : "No" ) << Gateendl;
+    if (m_flagSparseStorage)
+      G4cout << "    Sparse sinogram compaction threshold: " << m_sparseCompactionThreshold << Gateendl;
+  }
+
   // Prepare the sinogram
+  m_sinogram->SetSparseStorage(m_flagSparseStorage);
+  m_sinoDelayeds->SetSparseStorage(m_flagSparseStorage);
+  m_sinoScatters->SetSparseStorage(m_flagSparseStorage);
+  m_sinogram->SetSparseCompactionThreshold(m_sparseCompactionThreshold);
+  m_sinoDelayeds->SetSparseCompactionThreshold(m_sparseCompactionThreshold);
+  m_sinoScatters->SetSparseCompactionThreshold(m_sparseCompactionThreshold);
   m_sinogram->Reset(m_ringNb,m_crystalNb,m_radialElemNb,m_virtualRingPerBlockNb,m_virtualCrystalPerBlockNb);
 
   // 07.02.2006, C. Comtat, Store randoms and scatters sino
@@ -253,10 +275,7 @@ void GateToSinogram::RecordBeginOfRun(const G4Run * r)
 void GateToSinogram::RecordEndOfRun(const G4Run * r)
 {
   G4String         frameFileName;
-  std::ofstream    m_dataFile,m_infoFile,m_dimFile;
   char             ctemp[512];
-  G4int            aringdiff,nseg,seg,ringdiff,ring_1_min,ring_1_max,ring_1,ring_2,sinoID;
-  size_t           seekID;
 
   if (nVerboseLevel>0) {
     G4cout << " >> entering [GateToSinogram::RecordEndOfRun]\n";
@@ -271,159 +290,18 @@ void GateToSinogram::RecordEndOfRun(const G4Run * r)
   if (m_flagIsRawOutputEnabled) {
     sprintf(ctemp,"%s_%0d",m_fileName.c_str(),r->GetRunID()+1);
     frameFileName = ctemp;
-    G4cout << "    sinograms " <<  m_sinogram->GetCurrentFrameID()<< ",1,"
-                               <<  m_sinogram->GetCurrentGateID() << ","
-                               <<  m_sinogram->GetCurrentDataID() << ","
-			       <<  m_sinogram->GetCurrentBedID()  <<
-              " written to the raw file " << frameFileName << ".ima\n";
-    m_dataFile.open((frameFileName+".ima").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-    seekID = 0;
-    for (aringdiff=0 ; aringdiff<(G4int)m_ringNb; aringdiff++) {
-      if (aringdiff == 0) nseg = 1;
-      else nseg = 2;
-      for (seg=0 ; seg<nseg; seg++) {
-        if (seg == 0) { /* Positive ring difference */
-	  ringdiff = aringdiff;
-	  ring_1_min = 0;
-	  ring_1_max = m_ringNb - ringdiff - 1;
-	} else { /* Negative ring difference */
-	  ringdiff = -aringdiff;
-	  ring_1_min = -ringdiff;
-	  ring_1_max = m_ringNb - 1;
-	}
-	for (ring_1 = ring_1_min; ring_1 <= ring_1_max ; ++ring_1) {
-	  ring_2 = ring_1 + ringdiff;
-	  sinoID = m_sinogram->GetSinoID(ring_1,ring_2);
-	  if (sinoID < 0 || (unsigned)sinoID >= m_sinogram->GetSinogramNb()) {
-	    G4Exception( "GateToSinogram::RecordEndOfRun", "RecordEndOfRun", FatalException, "Wrong 2D sinogram ID\n");
-          }
-	  if (nVerboseLevel>2) {
-            G4cout << " >> rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
-	  }
-	  m_sinogram->StreamOut( m_dataFile , sinoID, seekID );
-	  seekID++;
-        }
-      }
-    }
-    m_dataFile.close();
-    m_infoFile.open((frameFileName+".info").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-    m_infoFile << m_sinogram->GetSinogramNb() << " 2D sinograms\n";
-    m_infoFile << " [RadialPosition;AzimuthalAngle;AxialPosition;RingDifference]\n";
-    m_infoFile << " RingDifference varies as 0,+1,-1,+2,-2, ...,+" << m_ringNb-1 << ",-" << m_ringNb-1 << Gateendl;
-    m_infoFile << " AxialPosition varies as |RingDifference|,...," << 2*m_ringNb-2 << "-|RingDifference| per increment of 2\n";
-    m_infoFile << " AzimuthalAngle varies as 0,...," << m_crystalNb/2-1 << " per increment of 1\n";
-    m_infoFile << " RadialPosition varies as 0,...," << m_radialElemNb-1 << " per increment of 1\n";
-    m_infoFile << " Date type : unsigned short integer (U" << 8*sizeof(unsigned short) << ")\n";
-    m_infoFile.close();
-    m_dimFile.open((frameFileName+".dim").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-    m_dimFile << " " << m_radialElemNb << " " << m_crystalNb/2 << " " << m_ringNb*m_ringNb << Gateendl;
-    m_dimFile << "-type U" << 8*sizeof(unsigned short) << Gateendl << "-dx 1.0\n" << "-dy 1.0\n" << "-dz 1.0";
-    m_dimFile.close();
+    StreamOutSinogramSet(m_sinogram,frameFileName,"2D sinograms");
 
     // 07.02.2006, C. Comtat, Store randoms and scatters sino
     if (m_flagStoreDelayeds) {
       sprintf(ctemp,"%s_%0d_del",m_fileName.c_str(),r->GetRunID()+1);
       frameFileName = ctemp;
-      G4cout << "    sinograms " << m_sinoDelayeds->GetCurrentFrameID()<< ",1,"
-                                 << m_sinoDelayeds->GetCurrentGateID() << ","
-                                 << m_sinoDelayeds->GetCurrentDataID() << ","
-	  			 << m_sinoDelayeds->GetCurrentBedID()  <<
-                " written to the raw file " << frameFileName << ".ima\n";
-      m_dataFile.open((frameFileName+".ima").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-      seekID = 0;
-      for (aringdiff=0 ; aringdiff<(G4int)m_ringNb; aringdiff++) {
-        if (aringdiff == 0) nseg = 1;
-        else nseg = 2;
-        for (seg=0 ; seg<nseg; seg++) {
-          if (seg == 0) { /* Positive ring difference */
-	    ringdiff = aringdiff;
-	    ring_1_min = 0;
-	    ring_1_max = m_ringNb - ringdiff - 1;
-	  } else { /* Negative ring difference */
-	    ringdiff = -aringdiff;
-	    ring_1_min = -ringdiff;
-	    ring_1_max = m_ringNb - 1;
-	  }
-	  for (ring_1 = ring_1_min; ring_1 <= ring_1_max ; ++ring_1) {
-	    ring_2 = ring_1 + ringdiff;
-	    sinoID = m_sinoDelayeds->GetSinoID(ring_1,ring_2);
-	    if (sinoID < 0 || (unsigned)sinoID >= m_sinoDelayeds->GetSinogramNb()) {
-	      G4Exception( "GateToSinogram::RecordEndOfRun", "RecordEndOfRun", FatalException, "Wrong 2D sinogram ID\n");
-            }
-	    if (nVerboseLevel>2) {
-              G4cout << " >> rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
-	    }
-	    m_sinoDelayeds->StreamOut( m_dataFile , sinoID, seekID );
-	    seekID++;
-          }
-        }
-      }
-      m_dataFile.close();
-      m_infoFile.open((frameFileName+".info").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-      m_infoFile << m_sinoDelayeds->GetSinogramNb() << " 2D delayed coincidences sinograms\n";
-      m_infoFile << " [RadialPosition;AzimuthalAngle;AxialPosition;RingDifference]\n";
-      m_infoFile << " RingDifference varies as 0,+1,-1,+2,-2, ...,+" << m_ringNb-1 << ",-" << m_ringNb-1 << Gateendl;
-      m_infoFile << " AxialPosition varies as |RingDifference|,...," << 2*m_ringNb-2 << "-|RingDifference| per increment of 2\n";
-      m_infoFile << " AzimuthalAngle varies as 0,...," << m_crystalNb/2-1 << " per increment of 1\n";
-      m_infoFile << " RadialPosition varies as 0,...," << m_radialElemNb-1 << " per increment of 1\n";
-      m_infoFile << " Date type : unsigned short integer (U" << 8*sizeof(unsigned short) << ")\n";
-      m_infoFile.close();
-      m_dimFile.open((frameFileName+".dim").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-      m_dimFile << " " << m_radialElemNb << " " << m_crystalNb/2 << " " << m_ringNb*m_ringNb << Gateendl;
-      m_dimFile << "-type U" << 8*sizeof(unsigned short) << Gateendl << "-dx 1.0\n" << "-dy 1.0\n" << "-dz 1.0";
-      m_dimFile.close();
+      StreamOutSinogramSet(m_sinoDelayeds,frameFileName,"2D delayed coincidences sinograms");
     }
     if (m_flagStoreScatters) {
       sprintf(ctemp,"%s_%0d_sct",m_fileName.c_str(),r->GetRunID()+1);
       frameFileName = ctemp;
-      G4cout << "    sinograms " << m_sinoScatters->GetCurrentFrameID()<< ",1,"
-                                 << m_sinoScatters->GetCurrentGateID() << ","
-                                 << m_sinoScatters->GetCurrentDataID() << ","
-	  			 << m_sinoScatters->GetCurrentBedID()  <<
-                " written to the raw file " << frameFileName << ".ima\n";
-      m_dataFile.open((frameFileName+".ima").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-      seekID = 0;
-      for (aringdiff=0 ; aringdiff<(G4int)m_ringNb; aringdiff++) {
-        if (aringdiff == 0) nseg = 1;
-        else nseg = 2;
-        for (seg=0 ; seg<nseg; seg++) {
-          if (seg == 0) { /* Positive ring difference */
-	    ringdiff = aringdiff;
-	    ring_1_min = 0;
-	    ring_1_max = m_ringNb - ringdiff - 1;
-	  } else { /* Negative ring difference */
-	    ringdiff = -aringdiff;
-	    ring_1_min = -ringdiff;
-	    ring_1_max = m_ringNb - 1;
-	  }
-	  for (ring_1 = ring_1_min; ring_1 <= ring_1_max ; ++ring_1) {
-	    ring_2 = ring_1 + ringdiff;
-	    sinoID = m_sinoScatters->GetSinoID(ring_1,ring_2);
-	    if (sinoID < 0 || (unsigned)sinoID >= m_sinoScatters->GetSinogramNb()) {
-	      G4Exception( "GateToSinogram::RecordEndOfRun", "RecordEndOfRun", FatalException, "Wrong 2D sinogram ID\n");
-            }
-	    if (nVerboseLevel>2) {
-              G4cout << " >> rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
-	    }
-	    m_sinoScatters->StreamOut( m_dataFile , sinoID, seekID );
-	    seekID++;
-          }
-        }
-      }
-      m_dataFile.close();
-      m_infoFile.open((frameFileName+".info").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-      m_infoFile << m_sinoScatters->GetSinogramNb() << " 2D true scattered coincidences sinograms\n";
-      m_infoFile << " [RadialPosition;AzimuthalAngle;AxialPosition;RingDifference]\n";
-      m_infoFile << " RingDifference varies as 0,+1,-1,+2,-2, ...,+" << m_ringNb-1 << ",-" << m_ringNb-1 << Gateendl;
-      m_infoFile << " AxialPosition varies as |RingDifference|,...," << 2*m_ringNb-2 << "-|RingDifference| per increment of 2\n";
-      m_infoFile << " AzimuthalAngle varies as 0,...," << m_crystalNb/2-1 << " per increment of 1\n";
-      m_infoFile << " RadialPosition varies as 0,...," << m_radialElemNb-1 << " per increment of 1\n";
-      m_infoFile << " Date type : unsigned short integer (U" << 8*sizeof(unsigned short) << ")\n";
-      m_infoFile.close();
-      m_dimFile.open((frameFileName+".dim").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
-      m_dimFile << " " << m_radialElemNb << " " << m_crystalNb/2 << " " << m_ringNb*m_ringNb << Gateendl;
-      m_dimFile << "-type U" << 8*sizeof(unsigned short) << Gateendl << "-dx 1.0\n" << "-dy 1.0\n" << "-dz 1.0";
-      m_dimFile.close();
+      StreamOutSinogramSet(m_sinoScatters,frameFileName,"2D true scattered coincidences sinograms");
     }
 
   }
@@ -432,6 +310,74 @@ void GateToSinogram::RecordEndOfRun(const G4Run * r)
 }
 
 
+/* Writes a set of 2D sinograms (raw data, info and dim files), segment by segment
+
+   sinogram:        the 2D sinograms to write
+   frameFileName:   the output file name, without extension
+   description:     the description of the data, written in the info file
+
+   The 2D sinograms are written one after the other in the segment order (ring difference
+   0,+1,-1,+2,-2,...), up to the maximum ring difference, so that only one 2D sinogram
+   has to be expanded at a time when the sparse storage is used.
+*/
+void GateToSinogram::StreamOutSinogramSet(GateSinogram* sinogram, const G4String& frameFileName, const G4String& description)
+{
+  std::ofstream    m_dataFile,m_infoFile,m_dimFile;
+  G4int            aringdiff,nseg,seg,ringdiff,ring_1_min,ring_1_max,ring_1,ring_2,sinoID;
+  size_t           seekID;
+  G4int            maxRingDiff = GetMaxRingDifference();
+
+  G4cout << "    sinograms " << sinogram->GetCurrentFrameID()<< ",1,"
+                             << sinogram->GetCurrentGateID() << ","
+                             << sinogram->GetCurrentDataID() << ","
+                             << sinogram->GetCurrentBedID()  <<
+            " written to the raw file " << frameFileName << ".ima\n";
+  m_dataFile.open((frameFileName+".ima").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
+  seekID = 0;
+  for (aringdiff=0 ; aringdiff<=maxRingDiff; aringdiff++) {
+    if (aringdiff == 0) nseg = 1;
+    else nseg = 2;
+    for (seg=0 ; seg<nseg; seg++) {
+      if (seg == 0) { /* Positive ring difference */
+        ringdiff = aringdiff;
+        ring_1_min = 0;
+        ring_1_max = m_ringNb - ringdiff - 1;
+      } else { /* Negative ring difference */
+        ringdiff = -aringdiff;
+        ring_1_min = -ringdiff;
+        ring_1_max = m_ringNb - 1;
+      }
+      for (ring_1 = ring_1_min; ring_1 <= ring_1_max ; ++ring_1) {
+        ring_2 = ring_1 + ringdiff;
+        sinoID = sinogram->GetSinoID(ring_1,ring_2);
+        if (sinoID < 0 || (unsigned)sinoID >= sinogram->GetSinogramNb()) {
+          G4Exception( "GateToSinogram::StreamOutSinogramSet", "StreamOutSinogramSet", FatalException, "Wrong 2D sinogram ID\n");
+        }
+        if (nVerboseLevel>2) {
+          G4cout << " >> rings " << ring_1 << "," << ring_2  << " give sino ID " << sinoID << Gateendl;
+        }
+        sinogram->StreamOut( m_dataFile , sinoID, seekID );
+        seekID++;
+      }
+    }
+  }
+  m_dataFile.close();
+  m_infoFile.open((frameFileName+".info").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
+  m_infoFile << seekID << " " << description << Gateendl;
+  m_infoFile << " [RadialPosition;AzimuthalAngle;AxialPosition;RingDifference]\n";
+  m_infoFile << " RingDifference varies as 0,+1,-1,+2,-2, ...,+" << maxRingDiff << ",-" << maxRingDiff << Gateendl;
+  m_infoFile << " AxialPosition varies as |RingDifference|,...," << 2*m_ringNb-2 << "-|RingDifference| per increment of 2\n";
+  m_infoFile << " AzimuthalAngle varies as 0,...," << m_crystalNb/2-1 << " per increment of 1\n";
+  m_infoFile << " RadialPosition varies as 0,...," << m_radialElemNb-1 << " per increment of 1\n";
+  m_infoFile << " Date type : unsigned short integer (U" << 8*sizeof(unsigned short) << ")\n";
+  m_infoFile.close();
+  m_dimFile.open((frameFileName+".dim").c_str(),std::ios::out | std::ios::trunc | std::ios::binary);
+  m_dimFile << " " << m_radialElemNb << " " << m_crystalNb/2 << " " << seekID << Gateendl;
+  m_dimFile << "-type U" << 8*sizeof(unsigned short) << Gateendl << "-dx 1.0\n" << "-dy 1.0\n" << "-dz 1.0";
+  m_dimFile.close();
+}
+
+
 // Update the target sinogram with regards to the digis acquired for this event
 void GateToSinogram::RecordEndOfEvent(const G4Event* )
 {
@@ -657,7 +603,9 @@ void GateToSinogram::Describe(size_t indent)
   G4cout << GateTools::Indent(indent) << " >> Number of crystals per crystal ring: " << m_crystalNb << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Number of crystal rings:             " << m_ringNb << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Number of radial sinogram bins:      " << m_radialElemNb << Gateendl;
-  G4cout << GateTools::Indent(indent) << " >> Filled ?                             " << ( m_sinogram->GetData() ? "Yes" : "No" ) << Gateendl;
+  G4cout << GateTools::Indent(indent) << " >> Maximum ring difference written:     " << GetMaxRingDifference() << Gateendl;
+  G4cout << GateTools::Indent(indent) << " >> Sparse storage ?                     " << ( m_flagSparseStorage ? "Yes" : "No" ) << Gateendl;
+  G4cout << GateTools::Indent(indent) << " >> Filled ?                             " << ( m_sinogram->IsAllocated() ? "Yes" : "No" ) << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Attached to system:                  " << m_system->GetObjectName() << Gateendl;
   G4cout << GateTools::Indent(indent) << " >> Input data:                          " << m_inputDataChannel;
 }
@@ -109,6 +109,24 @@ GateToSinogramMessenger::GateToSinogramMessenger(GateToSinogram* gateToSinogram)
   SetVirtualCrystalCmd->SetRange("Number>=0");
   SetVirtualCrystalCmd->SetDefaultValue(0);
 
+  cmdName = GetDirectoryName()+"SparseStorage";
+  SparseStorageCmd = new G4UIcmdWithABool(cmdName,this);
+  SparseStorageCmd->SetGuidance("Store the 2D sinograms as sparse bin buffers: memory grows with the number of coincidences instead of the number of ring pairs");
+  SparseStorageCmd->SetParameterName("flag",true);
+  SparseStorageCmd->SetDefaultValue(true);
+
+  cmdName = GetDirectoryName()+"setSparseCompactionThreshold";
+  SetSparseCompactionThresholdCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  SetSparseCompactionThresholdCmd->SetGuidance("Set the minimum number of new entries a sparse 2D sinogram buffers before they are sorted and merged (1024 by default): larger values use more memory and compact less often");
+  SetSparseCompactionThresholdCmd->SetParameterName("Number",false);
+  SetSparseCompactionThresholdCmd->SetRange("Number>=0");
+
+  cmdName = GetDirectoryName()+"setMaxRingDifference";
+  SetMaxRingDiffCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  SetMaxRingDiffCmd->SetGuidance("Set the maximum absolute ring difference written in the raw output (-1 for all ring differences)");
+  SetMaxRingDiffCmd->SetParameterName("Number",false);
+  SetMaxRingDiffCmd->SetRange("Number>=-1");
+
 }
 GateToSinogramMessenger::~GateToSinogramMessenger()
 {
@@ -127,6 +145,10 @@ GateToSinogramMessenger::~GateToSinogramMessenger()
   // C. Comtat, February 2011: Required to simulate Biograph output sinograms with virtual crystals
   delete SetVirtualRingCmd;
   delete SetVirtualCrystalCmd;
+
+  delete SparseStorageCmd;
+  delete SetSparseCompactionThresholdCmd;
+  delete SetMaxRingDiffCmd;
 }
 
 
@@ -164,6 +186,13 @@ void GateToSinogramMessenger::SetNewValue(G4UIcommand* command,G4String newValue
  else if (command == SetVirtualCrystalCmd)
     { m_gateToSinogram->SetVirtualCrystalPerBlockNb(SetVirtualCrystalCmd->GetNewIntValue(newValue)) ; }
 
+  else if (command == SparseStorageCmd)
+    { m_gateToSinogram->SparseStorage(SparseStorageCmd->GetNewBoolValue(newValue)) ; }
+  else if (command == SetSparseCompactionThresholdCmd)
+    { m_gateToSinogram->SetSparseCompactionThreshold(SetSparseCompactionThresholdCmd->GetNewIntValue(newValue)) ; }
+  else if (command == SetMaxRingDiffCmd)
+    { m_gateToSinogram->SetMaxRingDifference(SetMaxRingDiffCmd->GetNewIntValue(newValue)) ; }
+
 
   else
     { GateOutputModuleMessenger::SetNewValue(command,newValue); }
@@ -63,6 +63,16 @@ void GateUpholder::ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& ou
 
 
 
+void GateUpholder::ProcessPulseBatch(const GatePulseList&, std::vector<G4double>& energies,
+                                     std::vector<G4double>&, std::vector<char>& keep)
+{
+  for (size_t i=0; i<energies.size(); ++i)
+    if ( energies[i]==0 || energies[i] > m_uphold )
+      keep[i] = 0;
+}
+
+
+
 void GateUpholder::DescribeMyself(size_t indent)
 {
   G4cout << GateTools::Indent(indent) << "Uphold: " << G4BestUnit(m_uphold,"Energy") << Gateendl;
@@ -19,6 +19,8 @@ See LICENSE.md for further details
 
 
 #include "GateSteppingVerbose.hh"
+#include "GateProfiler.hh"
+#include "GateDigitizer.hh"
 #include "G4SteppingManager.hh"
 #include "G4SliceTimer.hh"
 
@@ -90,6 +92,8 @@ void GateUserActions::BeginOfRunAction(const G4Run* run)
   mTimer->Start();
 
   mCurrentRun = run;
+  GateProfiler::GetInstance()->BeginOfRun(run);
+  GateDigitizer::GetInstance()->CompileChains();
   GateActorManager::GetInstance()->BeginOfRunAction(run);
 
   // Prepare the visualization
@@ -116,6 +120,7 @@ void GateUserActions::EndOfRunAction(const G4Run* run)
   }
   mTimer->Stop();
   GateMessage("Core",1,"Run "<<mRunNumber - 1<<"  ---  Elapsed time = "<<mTimer->GetUserElapsed()<< Gateendl);
+  GateProfiler::GetInstance()->EndOfRun(run);
 }
 //-----------------------------------------------------------------------------
 
@@ -38,6 +38,8 @@ GateVActor::GateVActor(G4String name, G4int depth)
   EnableSaveEveryNEvents(0);
   EnableSaveEveryNSeconds(0);
   mNumOfFilters = 0;
+  ResetStepCounters();
+  SetProfilerIndices(-1, -1);
   mOverWriteFilesFlag = true;
   pFilterManager = new GateFilterManager(GetObjectName()+"_filter");
   GateDebugMessageDec("Actor",4,"GateVActor() -- end\n");
@@ -55,6 +55,9 @@ private:
   G4UIcmdWithoutParameter * NoOutputCmd;
   G4UIcmdWithAString * TimeStudyCmd;
   G4UIcmdWithAString * TimeStudyForStepsCmd;
+  G4UIcmdWithAString * ProfilingCmd;
+  G4UIcmdWithAnInteger * ProfilingSamplingPeriodCmd;
+  G4UIcmdWithAString * SharedMemoryDirectoryCmd;
   //G4UIcmdWithoutParameter * EnableSuccessiveSourceMode;
   G4UIcmdWithAString *      ReadTimeSlicesInAFileCmd;
   G4UIcmdWithADouble *      SetTotalNumberOfPrimariesCmd;
@@ -46,6 +46,7 @@ public:
   // Set acceptable kinetic energy range.
   //
  
+  virtual G4String GetSignature() const;
   virtual void show();
 
 private:
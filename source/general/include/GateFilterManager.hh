@@ -24,6 +24,7 @@ See LICENSE.md for further details
 #include "globals.hh"
 #include "G4String.hh"
 #include <vector>
+#include <map>
 
 #include "G4Step.hh"
 #include "G4Track.hh"
@@ -39,14 +40,35 @@ public:
   virtual G4bool Accept(const G4Step*) const;
   virtual G4bool Accept(const G4Track*) const;
 
-  void AddFilter(GateVFilter* filter){theFilters.push_back(filter);}
+  void AddFilter(GateVFilter* filter){theFilters.push_back(filter);mSharedResultGeneration=0;}
   G4int GetNumberOfFilters(){return theFilters.size();}
   void show();
 
+  // Concatenated signatures of the filters, empty if one of them can't be shared
+  G4String GetSignature() const;
+  // Forget the results of the last steps and the sharing groups (at the
+  // beginning of each run: the filter parameters may have changed)
+  static void ResetSharedResults();
+
 protected:
   G4String mFilterName;
   std::vector<GateVFilter*> theFilters;
 
+  // Result of the filter chain for the last step, shared by all the
+  // managers with the same signature
+  struct SharedResult {
+    G4int eventID;
+    G4int trackID;
+    G4int stepNumber;
+    G4bool accepted;
+  };
+  void ResolveSharedResult() const;
+  mutable SharedResult * mSharedResult;
+  // Generation of theSharedResults at which mSharedResult was resolved
+  mutable unsigned long mSharedResultGeneration;
+  static std::map<G4String, SharedResult> theSharedResults;
+  static unsigned long theSharedResultsGeneration;
+
 private:
   
 };
@@ -35,6 +35,7 @@ public:
     double mH2;
     double md1;
     G4String mName;
+    GateHounsfieldMaterialProperties * mProperties; // generated materials only
   };
   typedef std::vector<mMaterials> GateMaterialsVector;
   typedef GateMaterialsVector::iterator iterator;
@@ -46,7 +47,7 @@ public:
   void AddMaterial(double H1, double H2, G4String name);
   void WriteMaterialDatabase(G4String filename);
   void WriteMaterialtoHounsfieldLink(G4String filename);
-  void WriteMaterial(G4Material * m, std::ofstream & os);
+  void WriteMaterial(const mMaterials & m, std::ofstream & os);
   int GetNumberOfMaterials() { return mMaterialsVector.size(); }
   void Reset();
   void MapLabelToMaterial(LabelToMaterialNameType & m);
@@ -31,14 +31,19 @@ public:
   void SetOutputMaterialDatabaseFilename(G4String filename) { mOutputMaterialDatabaseFilename = filename; }
   void SetOutputHUMaterialFilename(G4String filename) { mOutputHUMaterialFilename = filename; }
   void SetDensityTolerance(double tol) { mDensityTol = tol; }
+  void SetCacheDirectory(G4String dirname) { mCacheDirectory = dirname; }
   
 protected:
+  G4String ComputeCacheKey();
+  bool CopyFile(const G4String & from, const G4String & to);
+
   GateHounsfieldToMaterialsBuilderMessenger * pMessenger;
   G4String mMaterialTableFilename;
   G4String mDensityTableFilename;
   G4String mOutputMaterialDatabaseFilename;
   G4String mOutputHUMaterialFilename;
   double mDensityTol;
+  G4String mCacheDirectory;
 
 };
 
@@ -39,6 +39,7 @@ protected:
   G4UIcmdWithAString * pSetOutputMaterialDatabaseFilename;
   G4UIcmdWithAString * pSetOutputHUMaterialFilename;
   G4UIcmdWithADoubleAndUnit * pSetDensityTolerance;
+  G4UIcmdWithAString * pSetCacheDirectory;
 };
 
 #endif
@@ -56,6 +56,9 @@ public:
 
   /// Allocates the data
   virtual void Allocate();
+  /// Frees the data, keeps the geometry (resolution, voxel size, origin...)
+  inline void ReleaseData() { std::vector<PixelType>().swap(data); }
+  inline bool IsAllocated() const { return !data.empty(); }
 
   // Access to the image values
   /// Returns the value of the image at voxel of index provided
@@ -29,6 +29,8 @@ public:
   virtual G4bool Accept(const G4Step*);
   virtual G4bool Accept(const G4Track*);
   void Add(const G4String& materialName);
+  virtual G4String GetSignature() const;
+  virtual void CountSharedAccept() { nFilteredParticles++; }
   virtual void show();
 
 private:
@@ -36,6 +38,11 @@ private:
  GateMaterialFilterMessenger * pMatMessenger;
  
  int nFilteredParticles;
+
+ // accepted flag of each material, indexed by G4Material::GetIndex()
+ G4bool IsAccepted(const G4Material * material);
+ void UpdateAcceptedMaterials();
+ std::vector<char> theAcceptedMaterials;
 };
 
 MAKE_AUTO_CREATOR_FILTER(materialFilter,GateMaterialFilter)
@@ -25,6 +25,7 @@ See LICENSE.md for further details
 
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include <map>
 
 class  GateParticleFilter :
   public GateVFilter
@@ -45,6 +46,8 @@ public:
   void AddDirectParent(const G4String &particleName);
   // add the particle into acceptable particle list.
   //
+  virtual G4String GetSignature() const;
+  virtual void CountSharedAccept() { nFilteredParticles++; }
   virtual void show();
 
 private:
@@ -57,6 +60,14 @@ private:
   GateParticleFilterMessenger *pPartMessenger;
 
   int nFilteredParticles;
+
+  // The name, Z, A and PDG tests only depend on the particle definition:
+  // their result is stored for each definition met
+  G4bool AcceptDefinition(const G4ParticleDefinition * def) const;
+  void ClearDefinitionCache();
+  std::map<const G4ParticleDefinition*, G4bool> theAcceptedDefinitions;
+  const G4ParticleDefinition * pLastDefinition;
+  G4bool mLastDefinitionAccepted;
 };
 
 MAKE_AUTO_CREATOR_FILTER(particleFilter, GateParticleFilter)
@@ -0,0 +1,172 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*
+  \class  GateProfiler
+  Opt-in instrumentation of the hot paths: number of calls and cumulative
+  cycles of each actor, filter, output module and digitizer stage.
+
+  The cycles are read from the time stamp counter (std::chrono on other
+  architectures). Every call is counted, but only one call every
+  "sampling period" is timed, and the cycles are extrapolated to all the
+  calls. The report (JSON, or CSV if the file name ends with .csv) is
+  written at the end of each run with the totals since the beginning of
+  the simulation. The times of the nested entries (e.g. the digitizer
+  stages called by the "digi" output module) are included in the time
+  of their caller.
+
+  The startup phases (material databases, geometry, images, physics,
+  actors, ...) are always recorded, with their wall time and the peak
+  resident memory at their end. A summary is printed after the
+  initialization, and they are added to the report when it is enabled.
+*/
+
+#ifndef GATEPROFILER_HH
+#define GATEPROFILER_HH
+
+#include "globals.hh"
+#include <vector>
+#include <map>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+class G4Run;
+
+//-----------------------------------------------------------------------------
+class GateProfiler
+{
+public:
+  static GateProfiler* GetInstance() {
+    if (instance == 0) instance = new GateProfiler();
+    return instance;
+  }
+
+  // Checked before any other call, so that the cost is a test when disabled
+  static bool IsEnabled() { return mIsEnabled; }
+
+  void Enable(const G4String & filename);
+  void SetSamplingPeriod(G4int n);
+
+  // Index of the counters of an entry, created at the first call
+  G4int GetIndex(const G4String & category, const G4String & name);
+  // Same, for an object whose name is only read at the first call
+  G4int GetIndex(const void * object, const G4String & category, const G4String & name);
+
+  // Counts a call, returns true if it has to be timed
+  inline bool Count(G4int index) {
+    Entry & e = mEntries[index];
+    return (e.calls++ % mSamplingPeriod) == 0;
+  }
+  inline void AddCycles(G4int index, unsigned long long cycles) {
+    mEntries[index].sampledCalls++;
+    mEntries[index].cycles += cycles;
+  }
+
+  static inline unsigned long long ReadCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+      (std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  void BeginOfRun(const G4Run*);
+  void EndOfRun(const G4Run*);
+
+  // Startup phases, which may be nested. The calls of a phase with the
+  // same name and parent are accumulated.
+  void BeginPhase(const G4String & name);
+  void EndPhase();
+  // Prints the phases, and writes the report if enabled
+  void EndOfInitialization();
+
+  // Peak resident set size of the process, in kB
+  static long GetPeakRSS();
+  // Current resident set size of the process, in kB (0 if unknown)
+  static long GetCurrentRSS();
+
+protected:
+  GateProfiler();
+
+  void WriteReport(const G4Run*);
+
+  struct Phase {
+    G4String name;  // with the names of the parents, separated by '/'
+    G4int depth;
+    unsigned long long calls;
+    double seconds;
+    long peakRSS;
+  };
+  std::vector<Phase> mPhases;
+  std::map<G4String, G4int> mIndexOfPhase;
+  std::vector<std::pair<G4int, std::chrono::steady_clock::time_point> > mOpenPhases;
+  double mSecondsToFirstRun;
+
+  struct Entry {
+    G4String category;
+    G4String name;
+    unsigned long long calls;
+    unsigned long long sampledCalls;
+    unsigned long long cycles;
+  };
+  std::vector<Entry> mEntries;
+  std::map<std::pair<G4String, G4String>, G4int> mIndexOfName;
+  std::map<const void*, G4int> mIndexOfObject;
+
+  G4String mFilename;
+  unsigned long long mSamplingPeriod;
+
+  // calibration of the cycles with the wall clock over the runs
+  unsigned long long mCyclesOfRuns;
+  double mSecondsOfRuns;
+  unsigned long long mRunStartCycles;
+  std::chrono::steady_clock::time_point mRunStartTime;
+
+  static bool mIsEnabled;
+  static GateProfiler * instance;
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Records a startup phase during its scope
+class GateProfilerPhase
+{
+public:
+  GateProfilerPhase(const G4String & name) { GateProfiler::GetInstance()->BeginPhase(name); }
+  ~GateProfilerPhase() { GateProfiler::GetInstance()->EndPhase(); }
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Counts (and times one call every sampling period) the scope of an entry
+class GateProfilerScope
+{
+public:
+  GateProfilerScope(G4int index):mIndex(-1) {
+    if (GateProfiler::IsEnabled() && index >= 0 && GateProfiler::GetInstance()->Count(index)) {
+      mIndex = index;
+      mStart = GateProfiler::ReadCycles();
+    }
+  }
+  ~GateProfilerScope() {
+    if (mIndex >= 0) GateProfiler::GetInstance()->AddCycles(mIndex, GateProfiler::ReadCycles() - mStart);
+  }
+
+protected:
+  G4int mIndex;
+  unsigned long long mStart;
+};
+//-----------------------------------------------------------------------------
+
+#endif /* end #define GATEPROFILER_HH */
@@ -21,6 +21,8 @@ See LICENSE.md for further details
 #include "G4SystemOfUnits.hh"
 #include "G4ThreeVector.hh"
 
+#include <vector>
+
 #include "TROOT.h"
 #include "TTree.h"
 
@@ -42,6 +44,9 @@ class GateCoincidenceDigi;
     - The GateRootDefs namespace is a collection of data and functions providing 
       some general-purpose definitions to the ROOT-based classes:
       - Methods allowing to change the output-ID names
+      - Column mask of the hit tree (the singles and coincidences trees use
+        the ASCII masks of GateSingleDigi and GateCoincidenceDigi)
+      - I/O settings shared by all the trees: basket size and auto-save
 */      
 
 namespace GateRootDefs
@@ -49,6 +54,20 @@ namespace GateRootDefs
   void SetDefaultOutputIDNames();
   void SetOutputIDName(char * anOutputIDName, size_t depth);
   G4bool GetRecordSeptalFlag(); // HDS : record septal penetration
+
+  //! Set the mask of the hit tree columns (see GateRootHitBuffer::Fill for the indices)
+  void SetHitMask(const std::vector<G4bool>& aMask);
+  //! Columns beyond the end of the mask are enabled
+  G4bool GetHitMask(G4int index);
+
+  //! Basket size of the branches in bytes (0: ROOT default)
+  void SetBasketSize(G4int aSize);
+  G4int GetBasketSize();
+  //! Auto-save period of the trees (>0: bytes, <0: entries, 0: no auto-save)
+  void SetAutoSave(Long64_t anAutoSave);
+  Long64_t GetAutoSave();
+  //! Apply the basket size and auto-save settings to a tree whose branches are booked
+  void ConfigureTree(TTree* aTree);
 }
 
 /*! \class  GateRootHitBuffer
@@ -73,6 +73,7 @@ private :
   GateDetectorConstruction* det;
   GateRunManagerMessenger* pMessenger;
   bool mIsGateInitializationCalled;
+  bool mIsStartupSummaryPending;
   GateHounsfieldToMaterialsBuilder * mHounsfieldToMaterialsBuilder;
   bool mGlobalOutputFlag;
   G4VUserPhysicsList * mUserPhysicList;
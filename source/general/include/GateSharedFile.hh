@@ -0,0 +1,71 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*
+  \class  GateSharedFile
+  Read-only mapping of a prepared file, shared by the processes of a node.
+
+  The files are in a directory set by the user (typically in /dev/shm, so
+  that they stay in memory). Their names contain a key of their content:
+  the first process writes the file (under a temporary name, then renamed)
+  and the next ones only map it, so that all the processes share the same
+  physical pages.
+*/
+
+#ifndef GATESHAREDFILE_HH
+#define GATESHAREDFILE_HH
+
+#include "globals.hh"
+#include <functional>
+#include <ostream>
+
+//-----------------------------------------------------------------------------
+class GateSharedFile
+{
+public:
+  GateSharedFile();
+  ~GateSharedFile();
+
+  // Directory of the shared files, no sharing if empty
+  static void SetDirectory(const G4String & dir) { mDirectory = dir; }
+  static const G4String & GetDirectory() { return mDirectory; }
+  static bool IsEnabled() { return mDirectory != ""; }
+
+  // Keys of a buffer and of the content of a file (FNV-1a, 16 hex digits)
+  static G4String ComputeKey(const void * data, size_t size);
+  static G4String ComputeFileKey(const G4String & filename);
+  // Key of several buffers: UpdateKey is called on each of them, starting
+  // from the default, and the result is given to KeyToString
+  static unsigned long long UpdateKey(const void * data, size_t size,
+                                      unsigned long long h = 14695981039346656037ULL);
+  static G4String KeyToString(unsigned long long h);
+
+  // Maps the file name in the directory. If it does not exist yet, it is
+  // first written by the function. Returns false (with a warning) if it
+  // can't be written or mapped.
+  bool Map(const G4String & name, const std::function<bool(std::ostream &)> & write);
+  void Unmap();
+
+  const void * GetData() const { return mData; }
+  size_t GetSize() const { return mSize; }
+
+protected:
+  GateSharedFile(const GateSharedFile &);
+  GateSharedFile & operator=(const GateSharedFile &);
+
+  bool MapFile(const G4String & filename);
+
+  void * mData;
+  size_t mSize;
+
+  static G4String mDirectory;
+};
+//-----------------------------------------------------------------------------
+
+#endif /* end #define GATESHAREDFILE_HH */
@@ -37,6 +37,12 @@ public:
   virtual G4bool Accept(const G4Step*);
   virtual G4bool Accept(const G4Track*);
 
+  // Settings of the filter: filters with the same non empty signature accept
+  // the same steps, so that their result is computed once per step for all
+  // the actors using them. Empty (default) if the result can't be shared.
+  virtual G4String GetSignature() const { return ""; }
+  // Called instead of Accept when a shared result accepted the step
+  virtual void CountSharedAccept() {}
  
   virtual void show();
 
@@ -25,6 +25,8 @@ See LICENSE.md for further details
 #include "GateVVolume.hh"
 #include "G4LogicalVolume.hh"
 
+#include <set>
+
 class  GateVolumeFilter : 
   public GateVFilter
 {
@@ -39,6 +41,7 @@ public:
 
   void addVolume(G4String volName);
 
+  virtual G4String GetSignature() const;
   virtual void show();
 
   void Initialize();
@@ -48,6 +51,7 @@ private:
   std::vector<G4String> theTempoListOfVolumeName;
   std::vector<GateVVolume *> theListOfVolume;
   std::vector<G4LogicalVolume*> theListOfLogicalVolume;
+  std::set<const G4LogicalVolume*> theSetOfLogicalVolume;
 
   bool IsInitialized;
 
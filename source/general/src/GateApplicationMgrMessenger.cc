@@ -9,6 +9,8 @@
 #include "GateApplicationMgrMessenger.hh"
 #include "GateApplicationMgr.hh"
 #include "GateSourceMgr.hh"
+#include "GateProfiler.hh"
+#include "GateSharedFile.hh"
 
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithABool.hh"
@@ -127,6 +129,19 @@ GateApplicationMgrMessenger::GateApplicationMgrMessenger()
   TimeStudyForStepsCmd = new G4UIcmdWithAString("/gate/application/enableStepAndTrackTimeStudy", this);
   TimeStudyForStepsCmd->SetGuidance("Activate the time measurement of steps and tracks (Slow down the simulation).");
   TimeStudyForStepsCmd->SetParameterName("File name",false);
+
+  ProfilingCmd = new G4UIcmdWithAString("/gate/application/enableProfiling", this);
+  ProfilingCmd->SetGuidance("Record the number of calls and the time of the actors, filters, output modules and digitizer stages. The report is written at the end of each run (JSON, or CSV if the file name ends with .csv).");
+  ProfilingCmd->SetParameterName("File name",false);
+
+  ProfilingSamplingPeriodCmd = new G4UIcmdWithAnInteger("/gate/application/setProfilingSamplingPeriod", this);
+  ProfilingSamplingPeriodCmd->SetGuidance("Time only one call every N calls in the profiling report (1 by default).");
+  ProfilingSamplingPeriodCmd->SetParameterName("N",false);
+  ProfilingSamplingPeriodCmd->SetRange("N>0");
+
+  SharedMemoryDirectoryCmd = new G4UIcmdWithAString("/gate/application/setSharedMemoryDirectory", this);
+  SharedMemoryDirectoryCmd->SetGuidance("Share the labels of the images and the ARF tables between the processes of a node, through files mapped in memory in this directory (e.g. /dev/shm/gate).");
+  SharedMemoryDirectoryCmd->SetParameterName("Directory",false);
 }
 //-------------------------------------------------------------------------------------------------------------------
 
@@ -156,6 +171,9 @@ GateApplicationMgrMessenger::~GateApplicationMgrMessenger()
   delete AddSliceCmd;
   delete TimeStudyCmd;
   delete TimeStudyForStepsCmd;
+  delete ProfilingCmd;
+  delete ProfilingSamplingPeriodCmd;
+  delete SharedMemoryDirectoryCmd;
 
   //LSLS
   delete ReadNumberOfPrimariesInAFileCmd;
@@ -248,5 +266,14 @@ void GateApplicationMgrMessenger::SetNewValue(G4UIcommand* command, G4String new
   else if (command == TimeStudyForStepsCmd) {
     appMgr->EnableTimeStudyForSteps(newValue);
   }
+  else if (command == ProfilingCmd) {
+    GateProfiler::GetInstance()->Enable(newValue);
+  }
+  else if (command == ProfilingSamplingPeriodCmd) {
+    GateProfiler::GetInstance()->SetSamplingPeriod(ProfilingSamplingPeriodCmd->GetNewIntValue(newValue));
+  }
+  else if (command == SharedMemoryDirectoryCmd) {
+    GateSharedFile::SetDirectory(newValue);
+  }
 }
 //-------------------------------------------------------------------------------------------------------------------
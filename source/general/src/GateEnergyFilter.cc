@@ -9,6 +9,8 @@ See LICENSE.md for further details
 
 #include "GateEnergyFilter.hh"
 
+#include <sstream>
+
 
 
 //---------------------------------------------------------------------------
@@ -51,6 +53,17 @@ G4bool GateEnergyFilter::Accept(const G4Track* aTrack)
 //---------------------------------------------------------------------------
 
 
+//---------------------------------------------------------------------------
+G4String GateEnergyFilter::GetSignature() const
+{
+  std::ostringstream os;
+  os.precision(17);
+  os << "energyFilter:" << fLowEnergy << "," << fHighEnergy;
+  return os.str();
+}
+//---------------------------------------------------------------------------
+
+
 //---------------------------------------------------------------------------
 void GateEnergyFilter::show(){
   G4cout << "------Filter: "<<GetObjectName()<<" particle list------\n";
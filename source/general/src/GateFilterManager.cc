@@ -9,7 +9,10 @@ See LICENSE.md for further details
 
 #include "GateFilterManager.hh"
 #include "GateMessageManager.hh"
+#include "GateActorManager.hh"
 
+std::map<G4String, GateFilterManager::SharedResult> GateFilterManager::theSharedResults;
+unsigned long GateFilterManager::theSharedResultsGeneration = 1;
 
 //---------------------------------------------------------------------------
 GateFilterManager::GateFilterManager(G4String name)
@@ -17,6 +20,8 @@ GateFilterManager::GateFilterManager(G4String name)
 {
   theFilters.clear();
   mFilterName = name;
+  mSharedResult = 0;
+  mSharedResultGeneration = 0;
 }
 //---------------------------------------------------------------------------
 
@@ -42,14 +47,34 @@ GateFilterManager::~GateFilterManager()
 //---------------------------------------------------------------------------
 G4bool GateFilterManager::Accept(const G4Step* aStep) const
 {
-//  std::vector<GateVFilter*>::iterator sit;
- // for(sit= theFilters.begin(); sit!=theFilters.end(); ++sit)
-      //if(!(*sit)->Accept(aStep)) return false;
+  if(mSharedResultGeneration != theSharedResultsGeneration) ResolveSharedResult();
+
+  // a step is identified by its event, track and step number
+  G4int eventID = 0, trackID = 0, stepNumber = 0;
+  if(mSharedResult) {
+    const G4Track* aTrack = aStep->GetTrack();
+    eventID = GateActorManager::GetInstance()->GetCurrentEventId();
+    trackID = aTrack->GetTrackID();
+    stepNumber = aTrack->GetCurrentStepNumber();
+    if(mSharedResult->stepNumber == stepNumber && mSharedResult->trackID == trackID
+       && mSharedResult->eventID == eventID) {
+      if(mSharedResult->accepted)
+        for(unsigned int i = 0;i<theFilters.size();i++) theFilters[i]->CountSharedAccept();
+      return mSharedResult->accepted;
+    }
+  }
 
+  G4bool accepted = true;
   for(unsigned int i = 0;i<theFilters.size();i++)
-     if(!theFilters[i]->Accept(aStep)) return false;
+     if(!theFilters[i]->Accept(aStep)) { accepted = false; break; }
 
-  return true;
+  if(mSharedResult) {
+    mSharedResult->eventID = eventID;
+    mSharedResult->trackID = trackID;
+    mSharedResult->stepNumber = stepNumber;
+    mSharedResult->accepted = accepted;
+  }
+  return accepted;
 }
 //---------------------------------------------------------------------------
 
@@ -69,6 +94,48 @@ G4bool GateFilterManager::Accept(const G4Track* aTrack) const
 
 
 
+//---------------------------------------------------------------------------
+G4String GateFilterManager::GetSignature() const
+{
+  G4String signature;
+  for(unsigned int i = 0;i<theFilters.size();i++) {
+    G4String s = theFilters[i]->GetSignature();
+    if(s == "") return "";
+    signature += s + ";";
+  }
+  return signature;
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+void GateFilterManager::ResolveSharedResult() const
+{
+  // the filters are configured by the time of the first step of the run
+  mSharedResultGeneration = theSharedResultsGeneration;
+  mSharedResult = 0;
+  G4String signature = GetSignature();
+  if(signature == "") return;
+  std::map<G4String, SharedResult>::iterator it = theSharedResults.find(signature);
+  if(it == theSharedResults.end()) {
+    SharedResult r = { -1, -1, -1, false };
+    it = theSharedResults.insert(std::make_pair(signature, r)).first;
+  }
+  mSharedResult = &it->second;
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+void GateFilterManager::ResetSharedResults()
+{
+  // the managers resolve their signature again at their next step
+  theSharedResults.clear();
+  theSharedResultsGeneration++;
+}
+//---------------------------------------------------------------------------
+
+
 //---------------------------------------------------------------------------
 void GateFilterManager::show(){
   G4cout << "------Filter Manager: "<<mFilterName<<" ------\n";
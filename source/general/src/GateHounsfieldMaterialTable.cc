@@ -52,13 +52,11 @@ void GateHounsfieldMaterialTable::AddMaterial(double H1, double H2, double d,
   // Material's name
   mat.mName = p->GetName()+"_"+DoubletoString(mMaterialsVector.size());
 
-  // Create new material
-  mat.mMaterial = new G4Material(mat.mName, d, p->GetNumberOfElements());
-
-  // Material's elements
-  for (int i=0; i<p->GetNumberOfElements(); i++) {
-    mat.mMaterial->AddElement(p->GetElements(i), p->GetElementsFraction(i));
-  }
+  // The G4Material is not created here: it is always built by the
+  // material database from the written file, so that the generated and
+  // the cached materials are the same
+  mat.mMaterial = 0;
+  mat.mProperties = p;
 
   // Set material
   mMaterialsVector.push_back(mat);
@@ -77,7 +75,7 @@ void GateHounsfieldMaterialTable::WriteMaterialDatabase(G4String filename) {
         //        << G4BestUnit(md1[i],"Volumic Mass")
         //        << ";" << G4BestUnit(md2[i],"Volumic Mass") << "]"
          << " ]\n";
-      WriteMaterial(it->mMaterial, os);
+      WriteMaterial(*it, os);
       os << Gateendl;
     }
   os.close();
@@ -97,15 +95,19 @@ void GateHounsfieldMaterialTable::WriteMaterialtoHounsfieldLink(G4String filenam
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void GateHounsfieldMaterialTable::WriteMaterial(G4Material * m, std::ofstream & os) {
-  os << m->GetName() << ": d=" << G4BestUnit(m->GetDensity(),"Volumic Mass")
-     << "; n=" << m->GetNumberOfElements()
+// Density and fractions with 17 digits: the materials read from the file
+// have the values computed by the generator
+void GateHounsfieldMaterialTable::WriteMaterial(const mMaterials & m, std::ofstream & os) {
+  GateHounsfieldMaterialProperties * p = m.mProperties;
+  std::streamsize precision = os.precision(17);
+  os << m.mName << ": d=" << m.md1/(g/cm3) << " g/cm3"
+     << "; n=" << p->GetNumberOfElements()
      << "; \n";
-  for (unsigned int j=0; j<m->GetNumberOfElements(); j++) {
-    os << "+el: name=" << m->GetElement(j)->GetName()
-       << "; f=" << m->GetFractionVector()[j] << Gateendl;
+  for (int j=0; j<p->GetNumberOfElements(); j++) {
+    os << "+el: name=" << p->GetElements(j)->GetName()
+       << "; f=" << p->GetElementsFraction(j) << Gateendl;
   }
-  //os.close();
+  os.precision(precision);
 }
 //-----------------------------------------------------------------------------
 
@@ -118,6 +120,7 @@ void GateHounsfieldMaterialTable::AddMaterial(double H1, double H2, G4String nam
   mat.mName = name;
   mat.mMaterial = theMaterialDatabase.GetMaterial(name);
   mat.md1=mat.mMaterial->GetDensity();
+  mat.mProperties = 0;
   mMaterialsVector.push_back(mat);
   GateMessage("Actor",3,H1 << " " << H2 << " " << name);
 }
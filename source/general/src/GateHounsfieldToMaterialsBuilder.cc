@@ -16,6 +16,14 @@
 #include "GateHounsfieldToMaterialsBuilder.hh"
 #include "GateHounsfieldMaterialTable.hh"
 #include "GateHounsfieldDensityTable.hh"
+#include "GateProfiler.hh"
+#include "GateSharedFile.hh"
+
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <cstdio>
+#include <unistd.h>
 
 //-------------------------------------------------------------------------------------------------
 GateHounsfieldToMaterialsBuilder::GateHounsfieldToMaterialsBuilder()
@@ -37,9 +45,68 @@ GateHounsfieldToMaterialsBuilder::~GateHounsfieldToMaterialsBuilder() {
 //-------------------------------------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------------------------------------
+// Key of the generated files in the cache: hash (64 bits FNV-1a) of the
+// content of the two tables, of the density tolerance and of the version
+// of the file format (files written with 6 digits before version 2)
+G4String GateHounsfieldToMaterialsBuilder::ComputeCacheKey() {
+  unsigned long long h = GateSharedFile::UpdateKey(0, 0);
+  const G4String filenames[2] = { mMaterialTableFilename, mDensityTableFilename };
+  const unsigned char separator = 0xff; // between the two files
+  for (int f=0; f<2; f++) {
+    std::ifstream is;
+    OpenFileInput(filenames[f], is);
+    const std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    h = GateSharedFile::UpdateKey(content.data(), content.size(), h);
+    h = GateSharedFile::UpdateKey(&separator, 1, h);
+  }
+  std::ostringstream tol;
+  tol << std::setprecision(17) << mDensityTol/(g/cm3) << " v2";
+  const std::string s = tol.str();
+  h = GateSharedFile::UpdateKey(s.data(), s.size(), h);
+  return GateSharedFile::KeyToString(h);
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+bool GateHounsfieldToMaterialsBuilder::CopyFile(const G4String & from, const G4String & to) {
+  std::ifstream is(from, std::ios::binary);
+  if (!is) return false;
+  std::ofstream os(to, std::ios::binary);
+  if (!os) return false;
+  os << is.rdbuf();
+  return (bool)os;
+}
+//-------------------------------------------------------------------------------------------------
+
+
 //-------------------------------------------------------------------------------------------------
 void GateHounsfieldToMaterialsBuilder::BuildAndWriteMaterials() {
   GateMessage("Geometry", 3, "GateHounsfieldToMaterialsBuilder::BuildAndWriteMaterials\n");
+  GateProfilerPhase phase("hounsfieldMaterials");
+
+  // Files already generated with the same tables and tolerance
+  G4String cachedDatabase, cachedHUMaterial;
+  if (mCacheDirectory != "") {
+    G4String key = ComputeCacheKey();
+    cachedDatabase = mCacheDirectory + "/HUmaterials-" + key + ".db";
+    cachedHUMaterial = mCacheDirectory + "/HU2mat-" + key + ".txt";
+    std::ifstream db(cachedDatabase);
+    std::ifstream hu(cachedHUMaterial);
+    if (db && hu) {
+      db.close();
+      hu.close();
+      if (CopyFile(cachedDatabase, mOutputMaterialDatabaseFilename) &&
+          CopyFile(cachedHUMaterial, mOutputHUMaterialFilename)) {
+        GateMessage("Geometry", 1, "Hounsfield materials read from the cache " << mCacheDirectory
+                    << " (key " << key << ")\n");
+        return;
+      }
+      GateWarning("Could not copy the Hounsfield materials from the cache " << mCacheDirectory
+                  << ", they are generated again.\n");
+    }
+  }
 
   // Read matTable.txt
   std::vector<GateHounsfieldMaterialProperties*> mHounsfieldMaterialPropertiesVector;
@@ -157,6 +224,24 @@ void GateHounsfieldToMaterialsBuilder::BuildAndWriteMaterials() {
 	      << mHounsfieldMaterialTable->GetNumberOfMaterials()
 	      << " materials.\n");
 
+  // Store the generated files in the cache. They are first written under a
+  // temporary name, so that concurrent jobs never read a partial file.
+  if (mCacheDirectory != "") {
+    std::ostringstream suffix;
+    suffix << ".tmp" << getpid();
+    if (CopyFile(mOutputMaterialDatabaseFilename, cachedDatabase + suffix.str()) &&
+        CopyFile(mOutputHUMaterialFilename, cachedHUMaterial + suffix.str()) &&
+        std::rename((cachedHUMaterial + suffix.str()).c_str(), cachedHUMaterial.c_str()) == 0 &&
+        std::rename((cachedDatabase + suffix.str()).c_str(), cachedDatabase.c_str()) == 0) {
+      GateMessage("Geometry", 2, "Hounsfield materials stored in the cache " << mCacheDirectory << Gateendl);
+    }
+    else {
+      std::remove((cachedDatabase + suffix.str()).c_str());
+      std::remove((cachedHUMaterial + suffix.str()).c_str());
+      GateWarning("Could not store the Hounsfield materials in the cache " << mCacheDirectory << Gateendl);
+    }
+  }
+
   // Release memory
   delete mHounsfieldMaterialTable;
   delete mDensityTable;
@@ -48,6 +48,9 @@ GateHounsfieldToMaterialsBuilderMessenger::GateHounsfieldToMaterialsBuilderMesse
   cmdName = dir+"SetDensityTolerance";
   pSetDensityTolerance = new G4UIcmdWithADoubleAndUnit(cmdName.c_str(),this);
 
+  cmdName = dir+"SetCacheDirectory";
+  pSetCacheDirectory = new G4UIcmdWithAString(cmdName.c_str(),this);
+  pSetCacheDirectory->SetGuidance("Directory where the generated files are kept, and reused by the next generations with the same tables and tolerance");
 }
 //-----------------------------------------------------------------------------------------
 
@@ -60,6 +63,7 @@ GateHounsfieldToMaterialsBuilderMessenger::~GateHounsfieldToMaterialsBuilderMess
   delete pSetOutputMaterialDatabaseFilename;
   delete pSetOutputHUMaterialFilename;
   delete pSetDensityTolerance;
+  delete pSetCacheDirectory;
 }
 //-----------------------------------------------------------------------------------------
 
@@ -70,6 +74,7 @@ void GateHounsfieldToMaterialsBuilderMessenger::SetNewValue(G4UIcommand *c, G4St
   if (c == pSetOutputMaterialDatabaseFilename)  mBuilder->SetOutputMaterialDatabaseFilename(s);
   if (c == pSetOutputHUMaterialFilename)  mBuilder->SetOutputHUMaterialFilename(s);
   if (c == pSetDensityTolerance)  mBuilder->SetDensityTolerance(pSetDensityTolerance->GetNewDoubleValue(s));
+  if (c == pSetCacheDirectory)  mBuilder->SetCacheDirectory(s);
   if (c == pGenerateCmd) mBuilder->BuildAndWriteMaterials();  
 }
 //-----------------------------------------------------------------------------------------
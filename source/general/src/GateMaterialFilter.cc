@@ -14,6 +14,7 @@ See LICENSE.md for further details
 
 #include "GateUserActions.hh"
 #include "GateTrajectory.hh"
+#include "G4Material.hh"
 
 
 //---------------------------------------------------------------------------
@@ -37,12 +38,10 @@ GateMaterialFilter::~GateMaterialFilter()
 //---------------------------------------------------------------------------
 G4bool GateMaterialFilter::Accept(const G4Step* aStep) 
 {
-    for ( size_t i = 0; i < theMdef.size(); i++){
-      if ( theMdef[i] == aStep->GetPreStepPoint()->GetMaterial()->GetName() ) {
-        nFilteredParticles++;
-        return true;
-      } 
-    }
+  if (IsAccepted(aStep->GetPreStepPoint()->GetMaterial())) {
+    nFilteredParticles++;
+    return true;
+  }
   return false;
 }
 //---------------------------------------------------------------------------
@@ -50,16 +49,42 @@ G4bool GateMaterialFilter::Accept(const G4Step* aStep)
 //---------------------------------------------------------------------------
 G4bool GateMaterialFilter::Accept(const G4Track* aTrack) 
 {
-    for ( size_t i = 0; i < theMdef.size(); i++){ 	
-      if ( theMdef[i] == aTrack->GetMaterial()->GetName() ) {
-        nFilteredParticles++;
-        return true;
-      } 
-    }
+  if (IsAccepted(aTrack->GetMaterial())) {
+    nFilteredParticles++;
+    return true;
+  }
   return false;
 }
 //---------------------------------------------------------------------------
 
+
+//---------------------------------------------------------------------------
+G4bool GateMaterialFilter::IsAccepted(const G4Material * material)
+{
+  size_t index = material->GetIndex();
+  // materials may be created after the first call (e.g. by the image volumes)
+  if (index >= theAcceptedMaterials.size()) UpdateAcceptedMaterials();
+  return theAcceptedMaterials[index];
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+void GateMaterialFilter::UpdateAcceptedMaterials()
+{
+  const G4MaterialTable * table = G4Material::GetMaterialTable();
+  theAcceptedMaterials.assign(table->size(), 0);
+  for (size_t m = 0; m < table->size(); m++) {
+    for (size_t i = 0; i < theMdef.size(); i++) {
+      if (theMdef[i] == (*table)[m]->GetName()) {
+        theAcceptedMaterials[m] = 1;
+        break;
+      }
+    }
+  }
+}
+//---------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------
 void GateMaterialFilter::Add(const G4String& materialName)
 {
@@ -67,9 +92,20 @@ void GateMaterialFilter::Add(const G4String& materialName)
     if ( theMdef[i] == materialName ) return;
   }
   theMdef.push_back(materialName);
+  theAcceptedMaterials.clear();
 }
 //---------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------
+G4String GateMaterialFilter::GetSignature() const
+{
+  G4String s = "materialFilter:";
+  for ( size_t i = 0; i < theMdef.size(); i++ ) s += theMdef[i] + ",";
+  return s;
+}
+//---------------------------------------------------------------------------
+
+
 //---------------------------------------------------------------------------
 void GateMaterialFilter::show()
 {
@@ -9,6 +9,9 @@
 #include "GateUserActions.hh"
 #include "GateTrajectory.hh"
 
+#include <algorithm>
+#include <sstream>
+
 //---------------------------------------------------------------------------
 GateParticleFilter::GateParticleFilter(G4String name)
   : GateVFilter(name)
@@ -16,6 +19,7 @@ GateParticleFilter::GateParticleFilter(G4String name)
   thePdef.clear();
   pPartMessenger = new GateParticleFilterMessenger(this);
   nFilteredParticles = 0;
+  ClearDefinitionCache();
 }
 //---------------------------------------------------------------------------
 
@@ -34,62 +38,18 @@ G4bool GateParticleFilter::Accept(const G4Track *aTrack)
 {
   std::vector<bool> acceptTemp;
 
-  // Test the particle name, keep the particle if the name is in the list
-  acceptTemp.push_back(true);
-  if (!thePdef.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdef.size(); i++) {
-      if (thePdef[i] == aTrack->GetDefinition()->GetParticleName() ||
-          (aTrack->GetDefinition()->GetParticleSubType() == "generic" && thePdef[i] == "GenericIon") ) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdef !empty
-  if (!acceptTemp.back()) return false;
-
-  // Test the particle Z, keep the particle if Z is in the list
-  acceptTemp.push_back(true);
-  if (!thePdefZ.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdefZ.size(); i++) {
-      if (thePdefZ[i] == aTrack->GetDefinition()->GetAtomicNumber()) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdefZ !empty
-  if (!acceptTemp.back()) return false;
-
-  //// Test the particle A
-  acceptTemp.push_back(true);
-  if (!thePdefA.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdefA.size(); i++) {
-      if (thePdefA[i] == aTrack->GetDefinition()->GetAtomicMass()) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdefA !empty
-  if (!acceptTemp.back()) return false;
-
-  // Test the particle PDG
-  acceptTemp.push_back(true);
-  if (!thePdefPDG.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdefPDG.size(); i++) {
-      if (thePdefPDG[i] == aTrack->GetDefinition()->GetPDGEncoding()) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdefPFG !empty
-  if (!acceptTemp.back()) return false;
+  // Test the particle name, Z, A and PDG, keep the particle if it is in the lists
+  const G4ParticleDefinition * def = aTrack->GetDefinition();
+  if (def != pLastDefinition) {
+    std::map<const G4ParticleDefinition*, G4bool>::iterator it = theAcceptedDefinitions.find(def);
+    if (it == theAcceptedDefinitions.end())
+      it = theAcceptedDefinitions.insert(std::make_pair(def, AcceptDefinition(def))).first;
+    pLastDefinition = def;
+    mLastDefinitionAccepted = it->second;
+  }
+  if (!mLastDefinitionAccepted) return false;
+  if (!thePdef.empty() || !thePdefZ.empty() || !thePdefA.empty() || !thePdefPDG.empty())
+    nFilteredParticles++;
 
   // Test the parent
   acceptTemp.push_back(true);
@@ -136,6 +96,52 @@ G4bool GateParticleFilter::Accept(const G4Track *aTrack)
 //---------------------------------------------------------------------------
 
 
+//---------------------------------------------------------------------------
+G4bool GateParticleFilter::AcceptDefinition(const G4ParticleDefinition * def) const
+{
+  // Test the particle name
+  if (!thePdef.empty()) {
+    bool accept = false;
+    for (size_t i = 0; i < thePdef.size(); i++) {
+      if (thePdef[i] == def->GetParticleName() ||
+          (def->GetParticleSubType() == "generic" && thePdef[i] == "GenericIon") ) {
+        accept = true;
+        break;
+      }
+    }
+    if (!accept) return false;
+  }
+
+  // Test the particle Z
+  if (!thePdefZ.empty() &&
+      std::find(thePdefZ.begin(), thePdefZ.end(), def->GetAtomicNumber()) == thePdefZ.end())
+    return false;
+
+  // Test the particle A
+  if (!thePdefA.empty() &&
+      std::find(thePdefA.begin(), thePdefA.end(), def->GetAtomicMass()) == thePdefA.end())
+    return false;
+
+  // Test the particle PDG
+  if (!thePdefPDG.empty() &&
+      std::find(thePdefPDG.begin(), thePdefPDG.end(), def->GetPDGEncoding()) == thePdefPDG.end())
+    return false;
+
+  return true;
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+void GateParticleFilter::ClearDefinitionCache()
+{
+  theAcceptedDefinitions.clear();
+  pLastDefinition = 0;
+  mLastDefinitionAccepted = false;
+}
+//---------------------------------------------------------------------------
+
+
 //---------------------------------------------------------------------------
 void GateParticleFilter::Add(const G4String &particleName)
 {
@@ -143,6 +149,7 @@ void GateParticleFilter::Add(const G4String &particleName)
     if (thePdef[i] == particleName ) return;
   }
   thePdef.push_back(particleName);
+  ClearDefinitionCache();
 }
 //---------------------------------------------------------------------------
 
@@ -154,6 +161,7 @@ void GateParticleFilter::AddZ(const G4int &particleZ)
     if (thePdefZ[i] == particleZ ) return;
   }
   thePdefZ.push_back(particleZ);
+  ClearDefinitionCache();
 }
 //---------------------------------------------------------------------------
 
@@ -165,6 +173,7 @@ void GateParticleFilter::AddA(const G4int &particleA)
     if (thePdefA[i] == particleA ) return;
   }
   thePdefA.push_back(particleA);
+  ClearDefinitionCache();
 }
 //---------------------------------------------------------------------------
 
@@ -176,6 +185,7 @@ void GateParticleFilter::AddPDG(const G4int &particlePDG)
     if (thePdefPDG[i] == particlePDG ) return;
   }
   thePdefPDG.push_back(particlePDG);
+  ClearDefinitionCache();
 }
 //---------------------------------------------------------------------------
 
@@ -202,6 +212,27 @@ void GateParticleFilter::AddDirectParent(const G4String &particleName)
 //---------------------------------------------------------------------------
 
 
+//---------------------------------------------------------------------------
+G4String GateParticleFilter::GetSignature() const
+{
+  std::ostringstream os;
+  os << "particleFilter:";
+  for (size_t i = 0; i < thePdef.size(); i++) os << thePdef[i] << ",";
+  os << "|Z:";
+  for (size_t i = 0; i < thePdefZ.size(); i++) os << thePdefZ[i] << ",";
+  os << "|A:";
+  for (size_t i = 0; i < thePdefA.size(); i++) os << thePdefA[i] << ",";
+  os << "|PDG:";
+  for (size_t i = 0; i < thePdefPDG.size(); i++) os << thePdefPDG[i] << ",";
+  os << "|parent:";
+  for (size_t i = 0; i < theParentPdef.size(); i++) os << theParentPdef[i] << ",";
+  os << "|directParent:";
+  for (size_t i = 0; i < theDirectParentPdef.size(); i++) os << theDirectParentPdef[i] << ",";
+  return os.str();
+}
+//---------------------------------------------------------------------------
+
+
 //---------------------------------------------------------------------------
 void GateParticleFilter::show() {
   G4cout << "------ Filter: " << GetObjectName() << " ------" << G4endl;
@@ -0,0 +1,240 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#include "GateProfiler.hh"
+#include "GateMessageManager.hh"
+
+#include "G4Run.hh"
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+GateProfiler * GateProfiler::instance = 0;
+bool GateProfiler::mIsEnabled = false;
+
+// Approximately the start of the process (static initialization)
+static const std::chrono::steady_clock::time_point gProcessStartTime = std::chrono::steady_clock::now();
+
+//-----------------------------------------------------------------------------
+GateProfiler::GateProfiler()
+{
+  mSamplingPeriod = 1;
+  mCyclesOfRuns = 0;
+  mSecondsOfRuns = 0;
+  mRunStartCycles = 0;
+  mSecondsToFirstRun = -1;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::Enable(const G4String & filename)
+{
+  mFilename = filename;
+  mIsEnabled = true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::SetSamplingPeriod(G4int n)
+{
+  if (n < 1) GateError("The sampling period of the profiler must be positive");
+  mSamplingPeriod = n;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4int GateProfiler::GetIndex(const G4String & category, const G4String & name)
+{
+  std::pair<G4String, G4String> key(category, name);
+  std::map<std::pair<G4String, G4String>, G4int>::iterator it = mIndexOfName.find(key);
+  if (it != mIndexOfName.end()) return it->second;
+
+  Entry e;
+  e.category = category;
+  e.name = name;
+  e.calls = 0;
+  e.sampledCalls = 0;
+  e.cycles = 0;
+  mEntries.push_back(e);
+  mIndexOfName[key] = mEntries.size()-1;
+  return mEntries.size()-1;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4int GateProfiler::GetIndex(const void * object, const G4String & category, const G4String & name)
+{
+  std::map<const void*, G4int>::iterator it = mIndexOfObject.find(object);
+  if (it != mIndexOfObject.end()) return it->second;
+  G4int index = GetIndex(category, name);
+  mIndexOfObject[object] = index;
+  return index;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::BeginOfRun(const G4Run*)
+{
+  if (mSecondsToFirstRun < 0)
+    mSecondsToFirstRun = std::chrono::duration<double>(std::chrono::steady_clock::now() - gProcessStartTime).count();
+  if (!mIsEnabled) return;
+  mRunStartTime = std::chrono::steady_clock::now();
+  mRunStartCycles = ReadCycles();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::EndOfRun(const G4Run* run)
+{
+  if (!mIsEnabled) return;
+  mCyclesOfRuns += ReadCycles() - mRunStartCycles;
+  mSecondsOfRuns += std::chrono::duration<double>(std::chrono::steady_clock::now() - mRunStartTime).count();
+  WriteReport(run);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+long GateProfiler::GetPeakRSS()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss/1024; // bytes on macOS
+#else
+  return usage.ru_maxrss;
+#endif
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+long GateProfiler::GetCurrentRSS()
+{
+  // second field of /proc/self/statm: resident pages (Linux only)
+  std::ifstream is("/proc/self/statm");
+  long size = 0, resident = 0;
+  if (!(is >> size >> resident)) return 0;
+  return resident*(sysconf(_SC_PAGESIZE)/1024);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::BeginPhase(const G4String & name)
+{
+  G4String fullName = mOpenPhases.empty() ? name : mPhases[mOpenPhases.back().first].name + "/" + name;
+  std::map<G4String, G4int>::iterator it = mIndexOfPhase.find(fullName);
+  G4int index;
+  if (it != mIndexOfPhase.end()) index = it->second;
+  else {
+    Phase p;
+    p.name = fullName;
+    p.depth = mOpenPhases.size();
+    p.calls = 0;
+    p.seconds = 0;
+    p.peakRSS = 0;
+    mPhases.push_back(p);
+    index = mPhases.size()-1;
+    mIndexOfPhase[fullName] = index;
+  }
+  mOpenPhases.push_back(std::make_pair(index, std::chrono::steady_clock::now()));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::EndPhase()
+{
+  if (mOpenPhases.empty()) return;
+  Phase & p = mPhases[mOpenPhases.back().first];
+  p.calls++;
+  p.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - mOpenPhases.back().second).count();
+  p.peakRSS = GetPeakRSS();
+  mOpenPhases.pop_back();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::EndOfInitialization()
+{
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - gProcessStartTime).count();
+  GateMessage("Core", 1, "Initialization done after " << seconds << " s, peak memory "
+              << GetPeakRSS()/1024 << " MB" << Gateendl);
+  for (size_t i = 0; i < mPhases.size(); i++) {
+    const Phase & p = mPhases[i];
+    GateMessage("Core", 1, std::string(2*p.depth+2, ' ') << p.name << ": " << p.seconds << " s ("
+                << p.calls << " calls), peak memory " << p.peakRSS/1024 << " MB" << Gateendl);
+  }
+  if (mIsEnabled) WriteReport(0);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateProfiler::WriteReport(const G4Run* run)
+{
+  std::ofstream os(mFilename);
+  if (!os) {
+    GateWarning("Can't write the profiling report " << mFilename);
+    return;
+  }
+  os.precision(10);
+
+  double cyclesPerSecond = (mSecondsOfRuns > 0) ? mCyclesOfRuns/mSecondsOfRuns : 0;
+  bool csv = (mFilename.size() > 4 && mFilename.substr(mFilename.size()-4) == ".csv");
+  if (csv) os << "category,name,calls,sampled_calls,cycles,seconds,peak_rss_kb\n";
+  else {
+    os << "{\n"
+       << "  \"last_run\": " << (run ? run->GetRunID() : -1) << ",\n"
+       << "  \"seconds_to_first_run\": " << mSecondsToFirstRun << ",\n"
+       << "  \"peak_rss_kb\": " << GetPeakRSS() << ",\n"
+       << "  \"sampling_period\": " << mSamplingPeriod << ",\n"
+       << "  \"cycles_per_second\": " << cyclesPerSecond << ",\n"
+       << "  \"run_seconds\": " << mSecondsOfRuns << ",\n"
+       << "  \"entries\": [";
+  }
+
+  for (size_t i = 0; i < mEntries.size(); i++) {
+    const Entry & e = mEntries[i];
+    // extrapolated to all the calls
+    double cycles = e.sampledCalls ? (double)e.cycles*e.calls/e.sampledCalls : 0;
+    double seconds = cyclesPerSecond > 0 ? cycles/cyclesPerSecond : 0;
+    if (csv)
+      os << e.category << ",\"" << e.name << "\"," << e.calls << "," << e.sampledCalls << ","
+         << cycles << "," << seconds << ",\n";
+    else
+      os << (i ? "," : "") << "\n    {\"category\": \"" << e.category << "\", \"name\": \"" << e.name
+         << "\", \"calls\": " << e.calls << ", \"sampled_calls\": " << e.sampledCalls
+         << ", \"cycles\": " << cycles << ", \"seconds\": " << seconds << "}";
+  }
+  if (!csv) os << "\n  ],\n  \"startup\": [";
+
+  for (size_t i = 0; i < mPhases.size(); i++) {
+    const Phase & p = mPhases[i];
+    if (csv)
+      os << "startup,\"" << p.name << "\"," << p.calls << "," << p.calls << ",0,"
+         << p.seconds << "," << p.peakRSS << "\n";
+    else
+      os << (i ? "," : "") << "\n    {\"phase\": \"" << p.name << "\", \"depth\": " << p.depth
+         << ", \"calls\": " << p.calls << ", \"seconds\": " << p.seconds
+         << ", \"peak_rss_kb\": " << p.peakRSS << "}";
+  }
+  if (!csv) os << "\n  ]\n}\n";
+
+  GateMessage("Core", 1, "Profiling report written to " << mFilename << Gateendl);
+}
+//-----------------------------------------------------------------------------
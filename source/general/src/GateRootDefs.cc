@@ -27,6 +27,10 @@ static char *theDefaultOutputIDName[ROOT_OUTPUTIDSIZE] =
    (char *)"unused5ID"
   };
 
+static std::vector<G4bool> theHitMask;
+static G4int    theBasketSize = 0;
+static Long64_t theAutoSave   = 1000;
+
 static char outputIDName     [ROOT_OUTPUTIDSIZE][24];
 static char outputIDLeafList [ROOT_OUTPUTIDSIZE][24];
 static char outputIDName1    [ROOT_OUTPUTIDSIZE][24];
@@ -78,6 +82,51 @@ G4bool GateRootDefs::GetRecordSeptalFlag()
 }
 
 
+void GateRootDefs::SetHitMask(const std::vector<G4bool>& aMask)
+{
+  theHitMask = aMask;
+}
+
+G4bool GateRootDefs::GetHitMask(G4int index)
+{
+  if ((index >= 0) && (((unsigned int)index) < theHitMask.size()))
+    return theHitMask[index];
+  return true;
+}
+
+void GateRootDefs::SetBasketSize(G4int aSize)
+{
+  theBasketSize = aSize;
+}
+
+G4int GateRootDefs::GetBasketSize()
+{
+  return theBasketSize;
+}
+
+void GateRootDefs::SetAutoSave(Long64_t anAutoSave)
+{
+  theAutoSave = anAutoSave;
+}
+
+Long64_t GateRootDefs::GetAutoSave()
+{
+  return theAutoSave;
+}
+
+/*  The auto-save writes the tree header into the file so that a crashed
+    simulation leaves a readable file. With a small period it is done at
+    almost every basket flush, which dominates the output cost of large
+    trees: the period is therefore configurable, 0 disabling it.
+*/
+void GateRootDefs::ConfigureTree(TTree* aTree)
+{
+  aTree->SetAutoSave(theAutoSave);
+  if (theBasketSize > 0)
+    aTree->SetBasketSize("*", theBasketSize);
+}
+
+
 void GateRootHitBuffer::Clear()
 {
   PDGEncoding   = 0;
@@ -131,6 +180,7 @@ void GateRootHitBuffer::Fill(GateCrystalHit* aHit)
 {
   size_t d;
 
+  // Only the columns enabled in the hit mask are computed (see GateHitTree::Init)
   PDGEncoding     = aHit->GetPDGEncoding();
   trackID         = aHit->GetTrackID();
   parentID        = aHit->GetParentID();
@@ -141,46 +191,52 @@ void GateRootHitBuffer::Fill(GateCrystalHit* aHit)
   SetTrackLength(    aHit->GetTrackLength() );
   SetPos(           aHit->GetGlobalPos() );
   SetLocalPos(      aHit->GetLocalPos() );
-  parentID        = aHit->GetParentID();
-  for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
-    outputID[d]   = aHit->GetComponentID(d);
+  if (GateRootDefs::GetHitMask(11))
+    for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
+      outputID[d]   = aHit->GetComponentID(d);
   photonID        = aHit->GetPhotonID();
   nPhantomCompton = aHit->GetNPhantomCompton();
   nCrystalCompton = aHit->GetNCrystalCompton();
   nPhantomRayleigh = aHit->GetNPhantomRayleigh();
   nCrystalRayleigh = aHit->GetNCrystalRayleigh();
   primaryID       = aHit->GetPrimaryID();
-  SetSourcePos(     aHit->GetSourcePosition() );
+  if (GateRootDefs::GetHitMask(18))
+    SetSourcePos(     aHit->GetSourcePosition() );
   sourceID        = aHit->GetSourceID();
   eventID         = aHit->GetEventID();
   runID           = aHit->GetRunID();
-  momDirX         = aHit->GetMomentumDir().x();
-  momDirY         = aHit->GetMomentumDir().y();
-  momDirZ         = aHit->GetMomentumDir().z();
-  SetAxialPos(      aHit->GetScannerPos().z() );
-  SetRotationAngle( aHit->GetScannerRotAngle() );
+  if (GateRootDefs::GetHitMask(10)) {
+    momDirX         = aHit->GetMomentumDir().x();
+    momDirY         = aHit->GetMomentumDir().y();
+    momDirZ         = aHit->GetMomentumDir().z();
+  }
+  if (GateRootDefs::GetHitMask(22))
+    SetAxialPos(      aHit->GetScannerPos().z() );
+  if (GateRootDefs::GetHitMask(23))
+    SetRotationAngle( aHit->GetScannerRotAngle() );
 
   // HDS : septal
 	septalNb = aHit->GetNSeptal();
 
-  strcpy (processName, aHit->GetProcess().c_str());
-
-  strcpy (comptonVolumeName,aHit->GetComptonVolumeName().c_str());
-  if (aHit->GetComptonVolumeName().length()>=40)
-    G4cout << "GateToRoot::RecordEndOfEvent : length of volume name exceeding 40: " <<
-      aHit->GetComptonVolumeName().length()+1 << Gateendl;
+  if (GateRootDefs::GetHitMask(25))
+    strcpy (processName, aHit->GetProcess().c_str());
 
-  strcpy (RayleighVolumeName,aHit->GetRayleighVolumeName().c_str());
-  if (aHit->GetRayleighVolumeName().length()>=40)
-    G4cout << "GateToRoot::RecordEndOfEvent : length of volume name exceeding 40: " <<
-      aHit->GetRayleighVolumeName().length()+1 << Gateendl;
-
-  aHit->GetVolumeID().StoreDaughterIDs(volumeID,ROOT_VOLUMEIDSIZE);
-
-
-  //G4cout << "RootDefs : runID = " << runID << Gateendl;
+  if (GateRootDefs::GetHitMask(26)) {
+    strcpy (comptonVolumeName,aHit->GetComptonVolumeName().c_str());
+    if (aHit->GetComptonVolumeName().length()>=40)
+      G4cout << "GateToRoot::RecordEndOfEvent : length of volume name exceeding 40: " <<
+        aHit->GetComptonVolumeName().length()+1 << Gateendl;
+  }
 
+  if (GateRootDefs::GetHitMask(27)) {
+    strcpy (RayleighVolumeName,aHit->GetRayleighVolumeName().c_str());
+    if (aHit->GetRayleighVolumeName().length()>=40)
+      G4cout << "GateToRoot::RecordEndOfEvent : length of volume name exceeding 40: " <<
+        aHit->GetRayleighVolumeName().length()+1 << Gateendl;
+  }
 
+  if (GateRootDefs::GetHitMask(24))
+    aHit->GetVolumeID().StoreDaughterIDs(volumeID,ROOT_VOLUMEIDSIZE);
 }
 
 GateCrystalHit* GateRootHitBuffer::CreateHit()
@@ -232,49 +288,93 @@ GateCrystalHit* GateRootHitBuffer::CreateHit()
   return aHit;
 }
 
+/*  Indices of the hit mask (/gate/output/root/setHitMask):
+     0 PDGEncoding      1 trackID           2 parentID          3 trackLocalTime
+     4 time             5 edep              6 stepLength        7 trackLength
+     8 posX,posY,posZ   9 localPosX,Y,Z    10 momDirX,Y,Z      11 outputIDs
+    12 photonID        13 nPhantomCompton  14 nCrystalCompton  15 nPhantomRayleigh
+    16 nCrystalRayleigh 17 primaryID       18 sourcePosX,Y,Z   19 sourceID
+    20 eventID         21 runID            22 axialPos         23 rotationAngle
+    24 volumeID        25 processName      26 comptVolName     27 RayleighVolName
+    28 septalNb
+*/
 void GateHitTree::Init(GateRootHitBuffer& buffer)
 {
-  SetAutoSave(1000);
-  Branch("PDGEncoding",    &buffer.PDGEncoding,"PDGEncoding/I");
-  Branch("trackID",        &buffer.trackID,"trackID/I");
-  Branch("parentID",       &buffer.parentID,"parentID/I");
-  Branch("trackLocalTime", &buffer.trackLocalTime,"trackLocalTime/D");
-  Branch("time",           &buffer.time,"time/D");
-  Branch("edep",           &buffer.edep,"edep/F");
-  Branch("stepLength",     &buffer.stepLength,"stepLength/F");
-  Branch("trackLength",    &buffer.trackLength,"trackLength/F");
-  Branch("posX",           &buffer.posX,"posX/F");
-  Branch("posY",           &buffer.posY,"posY/F");
-  Branch("posZ",           &buffer.posZ,"posZ/F");
-  Branch("localPosX",      &buffer.localPosX,"localPosX/F");
-  Branch("localPosY",      &buffer.localPosY,"localPosY/F");
-  Branch("localPosZ",      &buffer.localPosZ,"localPosZ/F");
-  Branch("momDirX",      &buffer.momDirX,"momDirX/F");
-  Branch("momDirY",      &buffer.momDirY,"momDirY/F");
-  Branch("momDirZ",      &buffer.momDirZ,"momDirZ/F");
+  if ( GateRootDefs::GetHitMask(0) )
+    Branch("PDGEncoding",    &buffer.PDGEncoding,"PDGEncoding/I");
+  if ( GateRootDefs::GetHitMask(1) )
+    Branch("trackID",        &buffer.trackID,"trackID/I");
+  if ( GateRootDefs::GetHitMask(2) )
+    Branch("parentID",       &buffer.parentID,"parentID/I");
+  if ( GateRootDefs::GetHitMask(3) )
+    Branch("trackLocalTime", &buffer.trackLocalTime,"trackLocalTime/D");
+  if ( GateRootDefs::GetHitMask(4) )
+    Branch("time",           &buffer.time,"time/D");
+  if ( GateRootDefs::GetHitMask(5) )
+    Branch("edep",           &buffer.edep,"edep/F");
+  if ( GateRootDefs::GetHitMask(6) )
+    Branch("stepLength",     &buffer.stepLength,"stepLength/F");
+  if ( GateRootDefs::GetHitMask(7) )
+    Branch("trackLength",    &buffer.trackLength,"trackLength/F");
+  if ( GateRootDefs::GetHitMask(8) ) {
+    Branch("posX",           &buffer.posX,"posX/F");
+    Branch("posY",           &buffer.posY,"posY/F");
+    Branch("posZ",           &buffer.posZ,"posZ/F");
+  }
+  if ( GateRootDefs::GetHitMask(9) ) {
+    Branch("localPosX",      &buffer.localPosX,"localPosX/F");
+    Branch("localPosY",      &buffer.localPosY,"localPosY/F");
+    Branch("localPosZ",      &buffer.localPosZ,"localPosZ/F");
+  }
+  if ( GateRootDefs::GetHitMask(10) ) {
+    Branch("momDirX",      &buffer.momDirX,"momDirX/F");
+    Branch("momDirY",      &buffer.momDirY,"momDirY/F");
+    Branch("momDirZ",      &buffer.momDirZ,"momDirZ/F");
+  }
 
-  for (size_t d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
-    Branch(outputIDName[d],(void *)(buffer.outputID+d),outputIDLeafList[d]);
-  Branch("photonID",       &buffer.photonID,"photonID/I");
-  Branch("nPhantomCompton",&buffer.nPhantomCompton,"nPhantomCompton/I");
-  Branch("nCrystalCompton",&buffer.nCrystalCompton,"nCrystalCompton/I");
-  Branch("nPhantomRayleigh",&buffer.nPhantomRayleigh,"nPhantomRayleigh/I");
-  Branch("nCrystalRayleigh",&buffer.nCrystalRayleigh,"nCrystalRayleigh/I");
-  Branch("primaryID",      &buffer.primaryID,"primaryID/I");
-  Branch("sourcePosX",     &buffer.sourcePosX,"sourcePosX/F");
-  Branch("sourcePosY",     &buffer.sourcePosY,"sourcePosY/F");
-  Branch("sourcePosZ",     &buffer.sourcePosZ,"sourcePosZ/F");
-  Branch("sourceID",       &buffer.sourceID,"sourceID/I");
-  Branch("eventID",        &buffer.eventID,"eventID/I");
-  Branch("runID",          &buffer.runID,"runID/I");
-  Branch("axialPos",       &buffer.axialPos,"axialPos/F");
-  Branch("rotationAngle",  &buffer.rotationAngle,"rotationAngle/F");
-  Branch("volumeID",       (void *)buffer.volumeID,"volumeID[10]/I");
-  Branch("processName",    (void *)buffer.processName,"processName/C");
-  Branch("comptVolName",   (void *)buffer.comptonVolumeName,"comptVolName/C");
-  Branch("RayleighVolName",   (void *)buffer.RayleighVolumeName,"RayleighVolName/C");
-  // HDS : record septal penetration
-  if (GateRootDefs::GetRecordSeptalFlag())	Branch("septalNb",   &buffer.septalNb,"septalNb/I");
+  if ( GateRootDefs::GetHitMask(11) )
+    for (size_t d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
+      Branch(outputIDName[d],(void *)(buffer.outputID+d),outputIDLeafList[d]);
+  if ( GateRootDefs::GetHitMask(12) )
+    Branch("photonID",       &buffer.photonID,"photonID/I");
+  if ( GateRootDefs::GetHitMask(13) )
+    Branch("nPhantomCompton",&buffer.nPhantomCompton,"nPhantomCompton/I");
+  if ( GateRootDefs::GetHitMask(14) )
+    Branch("nCrystalCompton",&buffer.nCrystalCompton,"nCrystalCompton/I");
+  if ( GateRootDefs::GetHitMask(15) )
+    Branch("nPhantomRayleigh",&buffer.nPhantomRayleigh,"nPhantomRayleigh/I");
+  if ( GateRootDefs::GetHitMask(16) )
+    Branch("nCrystalRayleigh",&buffer.nCrystalRayleigh,"nCrystalRayleigh/I");
+  if ( GateRootDefs::GetHitMask(17) )
+    Branch("primaryID",      &buffer.primaryID,"primaryID/I");
+  if ( GateRootDefs::GetHitMask(18) ) {
+    Branch("sourcePosX",     &buffer.sourcePosX,"sourcePosX/F");
+    Branch("sourcePosY",     &buffer.sourcePosY,"sourcePosY/F");
+    Branch("sourcePosZ",     &buffer.sourcePosZ,"sourcePosZ/F");
+  }
+  if ( GateRootDefs::GetHitMask(19) )
+    Branch("sourceID",       &buffer.sourceID,"sourceID/I");
+  if ( GateRootDefs::GetHitMask(20) )
+    Branch("eventID",        &buffer.eventID,"eventID/I");
+  if ( GateRootDefs::GetHitMask(21) )
+    Branch("runID",          &buffer.runID,"runID/I");
+  if ( GateRootDefs::GetHitMask(22) )
+    Branch("axialPos",       &buffer.axialPos,"axialPos/F");
+  if ( GateRootDefs::GetHitMask(23) )
+    Branch("rotationAngle",  &buffer.rotationAngle,"rotationAngle/F");
+  if ( GateRootDefs::GetHitMask(24) )
+    Branch("volumeID",       (void *)buffer.volumeID,"volumeID[10]/I");
+  if ( GateRootDefs::GetHitMask(25) )
+    Branch("processName",    (void *)buffer.processName,"processName/C");
+  if ( GateRootDefs::GetHitMask(26) )
+    Branch("comptVolName",   (void *)buffer.comptonVolumeName,"comptVolName/C");
+  if ( GateRootDefs::GetHitMask(27) )
+    Branch("RayleighVolName",   (void *)buffer.RayleighVolumeName,"RayleighVolName/C");
+  if ( GateRootDefs::GetHitMask(28) )
+    // HDS : record septal penetration
+    if (GateRootDefs::GetRecordSeptalFlag())	Branch("septalNb",   &buffer.septalNb,"septalNb/I");
+
+  GateRootDefs::ConfigureTree(this);
 }
 
 void GateHitTree::SetBranchAddresses(TTree* hitTree,GateRootHitBuffer& buffer)
@@ -364,16 +464,19 @@ void GateRootSingleBuffer::Fill(GateSingleDigi* aDigi)
   globalPosX    = (aDigi->GetGlobalPos()).x()/mm;
   globalPosY    = (aDigi->GetGlobalPos()).y()/mm;
   globalPosZ    = (aDigi->GetGlobalPos()).z()/mm;
-  for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
-    outputID[d] =  aDigi->GetComponentID(d);
+  if ( GateSingleDigi::GetSingleASCIIMask(6) )
+    for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
+      outputID[d] =  aDigi->GetComponentID(d);
   comptonPhantom=  aDigi->GetNPhantomCompton();
   comptonCrystal=  aDigi->GetNCrystalCompton();
   RayleighPhantom=  aDigi->GetNPhantomRayleigh();
   RayleighCrystal=  aDigi->GetNCrystalRayleigh();
   axialPos      = (aDigi->GetScannerPos()).z()/mm;
   rotationAngle = aDigi->GetScannerRotAngle()/deg;
-  strcpy (comptonVolumeName,(aDigi->GetComptonVolumeName()).c_str());
-  strcpy (RayleighVolumeName,(aDigi->GetRayleighVolumeName()).c_str());
+  if ( GateSingleDigi::GetSingleASCIIMask(16) )
+    strcpy (comptonVolumeName,(aDigi->GetComptonVolumeName()).c_str());
+  if ( GateSingleDigi::GetSingleASCIIMask(17) )
+    strcpy (RayleighVolumeName,(aDigi->GetRayleighVolumeName()).c_str());
 
   // HDS : septal penetration
   septalNb = aDigi->GetNSeptal();
@@ -382,7 +485,6 @@ void GateRootSingleBuffer::Fill(GateSingleDigi* aDigi)
 
 void GateSingleTree::Init(GateRootSingleBuffer& buffer)
 {
-  SetAutoSave(1000);
   if ( GateSingleDigi::GetSingleASCIIMask(0) )
     Branch("runID",          &buffer.runID,"runID/I");
   if ( GateSingleDigi::GetSingleASCIIMask(1) )
@@ -427,6 +529,8 @@ void GateSingleTree::Init(GateRootSingleBuffer& buffer)
   if ( GateSingleDigi::GetSingleASCIIMask(20) )
     // HDS : record septal penetration
     if (GateRootDefs::GetRecordSeptalFlag())	Branch("septalNb",   &buffer.septalNb,"septalNb/I");
+
+  GateRootDefs::ConfigureTree(this);
 }
 
 
@@ -497,15 +601,18 @@ void GateRootCoincBuffer::Fill(GateCoincidenceDigi* aDigi)
   globalPosX1    = (aDigi->GetPulse(0)).GetGlobalPos().x()/mm;
   globalPosY1    = (aDigi->GetPulse(0)).GetGlobalPos().y()/mm;
   globalPosZ1    = (aDigi->GetPulse(0)).GetGlobalPos().z()/mm;
-  for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
-    outputID1[d] = (aDigi->GetPulse(0)).GetComponentID(d);
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(11) )
+    for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
+      outputID1[d] = (aDigi->GetPulse(0)).GetComponentID(d);
   comptonPhantom1       = (aDigi->GetPulse(0)).GetNPhantomCompton();
   comptonCrystal1       = (aDigi->GetPulse(0)).GetNCrystalCompton();
   RayleighPhantom1       = (aDigi->GetPulse(0)).GetNPhantomRayleigh();
   RayleighCrystal1       = (aDigi->GetPulse(0)).GetNCrystalRayleigh();
 
-  strcpy (comptonVolumeName1,((aDigi->GetPulse(0)).GetComptonVolumeName()).c_str());
-  strcpy (RayleighVolumeName1,((aDigi->GetPulse(0)).GetRayleighVolumeName()).c_str());
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(20) )
+    strcpy (comptonVolumeName1,((aDigi->GetPulse(0)).GetComptonVolumeName()).c_str());
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(21) )
+    strcpy (RayleighVolumeName1,((aDigi->GetPulse(0)).GetRayleighVolumeName()).c_str());
 
   eventID2       = (aDigi->GetPulse(1)).GetEventID();
   sourceID2      = (aDigi->GetPulse(1)).GetSourceID();
@@ -517,18 +624,23 @@ void GateRootCoincBuffer::Fill(GateCoincidenceDigi* aDigi)
   globalPosX2    = (aDigi->GetPulse(1)).GetGlobalPos().x()/mm;
   globalPosY2    = (aDigi->GetPulse(1)).GetGlobalPos().y()/mm;
   globalPosZ2    = (aDigi->GetPulse(1)).GetGlobalPos().z()/mm;
-  for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
-    outputID2[d] = (aDigi->GetPulse(1)).GetComponentID(d);
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(11) )
+    for (d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
+      outputID2[d] = (aDigi->GetPulse(1)).GetComponentID(d);
   comptonPhantom2       = (aDigi->GetPulse(1)).GetNPhantomCompton();
   comptonCrystal2       = (aDigi->GetPulse(1)).GetNCrystalCompton();
   RayleighPhantom2       = (aDigi->GetPulse(1)).GetNPhantomRayleigh();
   RayleighCrystal2       = (aDigi->GetPulse(1)).GetNCrystalRayleigh();
 
-  strcpy (comptonVolumeName2,((aDigi->GetPulse(1)).GetComptonVolumeName()).c_str());
-  strcpy (RayleighVolumeName2,((aDigi->GetPulse(1)).GetRayleighVolumeName()).c_str());
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(20) )
+    strcpy (comptonVolumeName2,((aDigi->GetPulse(1)).GetComptonVolumeName()).c_str());
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(21) )
+    strcpy (RayleighVolumeName2,((aDigi->GetPulse(1)).GetRayleighVolumeName()).c_str());
 
-  sinogramTheta  = ComputeSinogramTheta();
-  sinogramS      = ComputeSinogramS();
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(18) )
+    sinogramTheta  = ComputeSinogramTheta();
+  if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(19) )
+    sinogramS      = ComputeSinogramS();
 }
 
 
@@ -575,7 +687,6 @@ G4double GateRootCoincBuffer::ComputeSinogramS()
 
 void GateCoincTree::Init(GateRootCoincBuffer& buffer)
 {
-  SetAutoSave(1000);
   if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(0) )
     Branch("runID",          &buffer.runID,"runID/I");
   if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(16) )
@@ -662,6 +773,8 @@ void GateCoincTree::Init(GateRootCoincBuffer& buffer)
     Branch("RayleighVolName1",  (void *)buffer.RayleighVolumeName1,"RayleighVolName1/C");
   if ( GateCoincidenceDigi::GetCoincidenceASCIIMask(21) )
     Branch("RayleighVolName2",  (void *)buffer.RayleighVolumeName2,"RayleighVolName2/C");
+
+  GateRootDefs::ConfigureTree(this);
 }
 
 
@@ -11,6 +11,9 @@
 #include "GateDetectorConstruction.hh"
 #include "GateRunManagerMessenger.hh"
 #include "GateHounsfieldToMaterialsBuilder.hh"
+#include "GateProfiler.hh"
+#include "GatePhysicsList.hh"
+#include "GateImageVoxelTransportModel.hh"
 
 #include "G4StateManager.hh"
 #include "G4UImanager.hh"
@@ -32,6 +35,7 @@ GateRunManager::GateRunManager():G4RunManager()
   pMessenger = new GateRunManagerMessenger(this);
   mHounsfieldToMaterialsBuilder = new GateHounsfieldToMaterialsBuilder();
   mIsGateInitializationCalled = false;
+  mIsStartupSummaryPending = false;
   mUserPhysicList = 0;
   mUserPhysicListName = "";
   EnableGlobalOutput(true);
@@ -68,11 +72,15 @@ void GateRunManager::InitializeAll()
       return;
     }
 
+  GateProfiler * profiler = GateProfiler::GetInstance();
   GateMessage("Core", 0, "Initialization of geometry\n");
+  profiler->BeginPhase("geometry");
   InitGeometryOnly();
+  profiler->EndPhase();
 
   // if(!physicsInitialized) {
   GateMessage("Core", 0, "Initialization of physics\n");
+  profiler->BeginPhase("physics");
   // We call the PurgeIfFictitious method to delete the gamma related processes
   // that the user defined if the fictitiousProcess is called.
   GatePhysicsList::GetInstance()->PurgeIfFictitious();
@@ -133,9 +141,18 @@ void GateRunManager::InitializeAll()
   // Take into account the em option set by the user (dedx bin etc)
   GatePhysicsList::GetInstance()->SetEmProcessOptions();
 
+  // Fast photon transport in the images, if enabled in the geometry
+  GateImageVoxelTransportModel::ConstructProcess();
+  profiler->EndPhase();
+
   // Actors initialization
   GateMessage("Core", 0, "Initialization of actors\n");
+  profiler->BeginPhase("actors");
   GateActorManager::GetInstance() ->CreateListsOfEnabledActors();
+  profiler->EndPhase();
+  // The summary of the startup is given after the run initialization
+  // (physics tables) of the first run
+  mIsStartupSummaryPending = true;
 
   initializedAtLeastOnce = true;
 
@@ -206,23 +223,34 @@ void GateRunManager::RunInitialization()
   }
 
   // GateMessage("Core", 0, "Initialization of the run \n");
-  // Perform a regular initialisation
-  G4RunManager::RunInitialization();
+  // Perform a regular initialisation (physics tables, begin of run actions)
+  // The physics tables may be retrieved from a previous job (first run only)
+  {
+    GateProfilerPhase phase("runInitialization");
+    GatePhysicsList::GetInstance()->RetrievePhysicsTables(physicsList);
+    G4RunManager::RunInitialization();
+    GatePhysicsList::GetInstance()->StorePhysicsTables(physicsList);
+
+    // Initialization of the atom deexcitation processes
+    // must be done after all other initialization
+    if(G4LossTableManager::Instance()->AtomDeexcitation()) {
+      G4LossTableManager::Instance()->AtomDeexcitation()->InitialiseAtomicDeexcitation();
+    }
 
-  // Initialization of the atom deexcitation processes
-  // must be done after all other initialization
-  if(G4LossTableManager::Instance()->AtomDeexcitation()) {
-    G4LossTableManager::Instance()->AtomDeexcitation()->InitialiseAtomicDeexcitation();
+    // Reset the geometry navigator
+    // In G4.5, both "/geometry/navigator/reset" and the new method
+    // G4RunManager::ResetNavigator() work only in the Idle state,
+    // which is incorrect since the geometry is not closed yet
+    // This is why we perform a manual reset of the navigator
+    G4ThreeVector center(0,0,0);
+    G4TransportationManager::GetTransportationManager()
+      ->GetNavigatorForTracking()
+      ->LocateGlobalPointAndSetup(center,0,false);
   }
 
-  // Reset the geometry navigator
-  // In G4.5, both "/geometry/navigator/reset" and the new method
-  // G4RunManager::ResetNavigator() work only in the Idle state,
-  // which is incorrect since the geometry is not closed yet
-  // This is why we perform a manual reset of the navigator
-  G4ThreeVector center(0,0,0);
-  G4TransportationManager::GetTransportationManager()
-    ->GetNavigatorForTracking()
-    ->LocateGlobalPointAndSetup(center,0,false);
+  if (mIsStartupSummaryPending) {
+    GateProfiler::GetInstance()->EndOfInitialization();
+    mIsStartupSummaryPending = false;
+  }
 }
 //----------------------------------------------------------------------------------------
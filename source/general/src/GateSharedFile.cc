@@ -0,0 +1,147 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#include "GateSharedFile.hh"
+#include "GateMessageManager.hh"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+G4String GateSharedFile::mDirectory = "";
+
+//-----------------------------------------------------------------------------
+GateSharedFile::GateSharedFile()
+  : mData(0), mSize(0)
+{
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateSharedFile::~GateSharedFile()
+{
+  Unmap();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+unsigned long long GateSharedFile::UpdateKey(const void * data, size_t size, unsigned long long h)
+{
+  const unsigned char * c = (const unsigned char *)data;
+  for (size_t i=0; i<size; i++) {
+    h ^= c[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4String GateSharedFile::KeyToString(unsigned long long h)
+{
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << h;
+  return key.str();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4String GateSharedFile::ComputeKey(const void * data, size_t size)
+{
+  return KeyToString(UpdateKey(data, size));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4String GateSharedFile::ComputeFileKey(const G4String & filename)
+{
+  std::ifstream is(filename.c_str(), std::ios::binary);
+  if (!is) GateError("Can't open the file " << filename << Gateendl);
+  unsigned long long h = UpdateKey(0, 0);
+  char buffer[65536];
+  while (is) {
+    is.read(buffer, sizeof(buffer));
+    h = UpdateKey(buffer, is.gcount(), h);
+  }
+  return KeyToString(h);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool GateSharedFile::MapFile(const G4String & filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  void * data = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return false;
+  mData = data;
+  mSize = st.st_size;
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool GateSharedFile::Map(const G4String & name, const std::function<bool(std::ostream &)> & write)
+{
+  Unmap();
+  G4String filename = mDirectory + "/" + name;
+  if (MapFile(filename)) {
+    GateMessage("Core", 2, "Shared file " << filename << " mapped (" << mSize << " bytes)" << Gateendl);
+    return true;
+  }
+
+  // Written under a temporary name, so that the other processes never map
+  // a partial file
+  mkdir(mDirectory.c_str(), 0755);
+  std::ostringstream tmp;
+  tmp << filename << ".tmp" << getpid();
+  std::ofstream os(tmp.str().c_str(), std::ios::binary);
+  bool written = os && write(os);
+  os.close();
+  if (!written || !os || std::rename(tmp.str().c_str(), filename.c_str()) != 0) {
+    std::remove(tmp.str().c_str());
+    GateWarning("Could not write the shared file " << filename << Gateendl);
+    return false;
+  }
+  if (!MapFile(filename)) {
+    GateWarning("Could not map the shared file " << filename << Gateendl);
+    return false;
+  }
+  GateMessage("Core", 2, "Shared file " << filename << " written and mapped (" << mSize << " bytes)" << Gateendl);
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSharedFile::Unmap()
+{
+  if (mData) munmap(mData, mSize);
+  mData = 0;
+  mSize = 0;
+}
+//-----------------------------------------------------------------------------
@@ -32,10 +32,7 @@ G4bool GateVolumeFilter::Accept(const G4Step* aStep)
    G4TouchableHistory* theTouchable = (G4TouchableHistory*)(aStep->GetPreStepPoint()->GetTouchable());
    G4LogicalVolume * currentVol = theTouchable->GetVolume(0)->GetLogicalVolume();
 
-   for(unsigned int k =0 ; k<theListOfLogicalVolume.size();k++)
-            if(theListOfLogicalVolume[k]== currentVol ) return true;
-   
-   return false;
+   return theSetOfLogicalVolume.count(currentVol) > 0;
 }
 //---------------------------------------------------------------------------
 
@@ -48,10 +45,7 @@ G4bool GateVolumeFilter::Accept(const G4Track* t)
    G4TouchableHistory* theTouchable = (G4TouchableHistory*)(t->GetTouchable());
    G4LogicalVolume * currentVol = theTouchable->GetVolume(0)->GetLogicalVolume();
 
-   for(unsigned int k =0 ; k<theListOfLogicalVolume.size();k++)
-            if(theListOfLogicalVolume[k]== currentVol ) return true;
-   
-   return false;
+   return theSetOfLogicalVolume.count(currentVol) > 0;
 }
 
 //---------------------------------------------------------------------------
@@ -104,6 +98,17 @@ void GateVolumeFilter::Initialize()
   {    
     theListOfLogicalVolume.push_back(theListOfVolume[k]->GetLogicalVolume());   
   }
+  theSetOfLogicalVolume.insert(theListOfLogicalVolume.begin(), theListOfLogicalVolume.end());
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+G4String GateVolumeFilter::GetSignature() const
+{
+  G4String s = "volumeFilter:";
+  for(unsigned int k =0 ; k<theTempoListOfVolumeName.size();k++) s += theTempoListOfVolumeName[k] + ",";
+  return s;
 }
 //---------------------------------------------------------------------------
 
@@ -39,7 +39,6 @@
 #ifndef __DT_H
 #define __DT_H
 
-//#define _MULTITHREAD 1
 
 #include <stdio.h>
 #include <iostream>
@@ -48,9 +47,6 @@
 #include <GateDMapVol.h>
 #include <GateDMaplongvol.h>
 
-#ifdef _MULTITHREAD
-#include <pthread.h>
-#endif
 
 
 
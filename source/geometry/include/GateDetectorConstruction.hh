@@ -139,6 +139,11 @@ public:
 
   virtual inline G4bool GetFlagMove() const { return moveFlag; };
 
+  //! With the incremental motion, the time slices only update the placements of the moving
+  //! volumes and the smart voxels of their mother volumes, instead of the whole world
+  inline void SetIncrementalMotion(G4bool val) { m_incrementalMotion = val; }
+  inline G4bool GetIncrementalMotion() const { return m_incrementalMotion; }
+
   /// The Material database
   GateMaterialDatabase mMaterialDatabase;
 
@@ -180,8 +185,12 @@ private :
   static GateDetectorConstruction* pTheGateDetectorConstruction;
 
 protected :
+  //! Transform-only update of the moving volumes, returns false if the geometry is not closed yet
+  G4bool UpdateMovingVolumes();
+
   //!< List of movements
   G4bool moveFlag;
+  G4bool m_incrementalMotion;
 
   std::map<G4String,G4double> theListOfIonisationPotential;
 
@@ -56,6 +56,7 @@ class GateDetectorMessenger: public G4UImessenger
 
     G4UIcmdWithoutParameter*   pListCreatorsCmd;
     G4UIcmdWithAString*        IoniCmd;
+    G4UIcmdWithABool*          pIncrementalMotionCmd;
 
     //G4UIcmdWithABool* 	       pEnableAutoUpdateCmd;    
     //G4UIcmdWithABool* 	       pDisableAutoUpdateCmd; 
@@ -0,0 +1,71 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*!
+  \class  GateImageLabels
+  \brief  Compact copy of the labels of an image volume, read by the
+  parametrisations to find the material of a voxel.
+
+  The labels are stored with the smallest integer type holding the
+  largest label (8, 16 or 32 bits), instead of the float of the image.
+  With a directory of shared files (see GateSharedFile), they are mapped
+  from a file shared by the processes of the node. The float image is
+  then released by the volume (GateVImageVolume::ReleaseImageData()), so
+  that the voxels are only stored in the shared pages.
+*/
+
+#ifndef __GateImageLabels__hh__
+#define __GateImageLabels__hh__
+
+#include "globals.hh"
+#include "GateImage.hh"
+#include "GateSharedFile.hh"
+#include <vector>
+
+class GateImageLabels
+{
+public:
+  GateImageLabels();
+
+  // Copies the labels of the image, which must be in [0, numberOfLabels)
+  void Build(const GateImage & image, size_t numberOfLabels);
+  void Clear();
+
+  inline G4int GetLabel(size_t index) const {
+    if (mData8) return mData8[index];
+    if (mData16) return mData16[index];
+    return mData32[index];
+  }
+  inline G4int GetLabel(G4int i, G4int j, G4int k) const {
+    return GetLabel(i + (size_t)j*mLineSize + (size_t)k*mPlaneSize);
+  }
+
+  size_t GetNumberOfValues() const { return mNumberOfValues; }
+  size_t GetBytesPerLabel() const;
+  // True if the labels are mapped from a shared file
+  bool IsShared() const { return mSharedFile.GetData() != 0; }
+
+protected:
+  void Share();
+
+  // point to the vectors, or to the shared file
+  const unsigned char * mData8;
+  const unsigned short * mData16;
+  const unsigned int * mData32;
+  GateSharedFile mSharedFile;
+
+  std::vector<unsigned char> mLabels8;
+  std::vector<unsigned short> mLabels16;
+  std::vector<unsigned int> mLabels32;
+  size_t mLineSize;
+  size_t mPlaneSize;
+  size_t mNumberOfValues;
+};
+
+#endif
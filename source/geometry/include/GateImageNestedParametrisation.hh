@@ -22,6 +22,7 @@ See LICENSE.md for further details
 #include "G4VNestedParameterisation.hh"
 
 #include "GateVImageVolume.hh"
+#include "GateImageLabels.hh"
 class GateImageNestedParametrisedVolume;
 
 //-----------------------------------------------------------------------------
@@ -53,6 +54,9 @@ public:
   //-----------------------------------------------------------------------------
   virtual G4Material* GetMaterial(G4int idx) const;  
 
+  //-----------------------------------------------------------------------------
+  const GateImageLabels & GetLabels() const { return mLabels; }
+
 /*
   //-----------------------------------------------------------------------------
   void ComputeDimensions(G4Tubs &, const G4int, const G4VPhysicalVolume *) const {}
@@ -95,6 +99,9 @@ protected:
   /// vector of label to material correspondance
   std::vector<G4Material*> mVectorLabel2Material;
   //-----------------------------------------------------------------------------
+  /// labels of the voxels, with the smallest integer type
+  GateImageLabels mLabels;
+  //-----------------------------------------------------------------------------
   /// Dummy material (Air)
   G4Material * mAirMaterial;
   //-----------------------------------------------------------------------------
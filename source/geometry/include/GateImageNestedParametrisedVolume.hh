@@ -23,6 +23,7 @@ See LICENSE.md for further details
 class GateMultiSensitiveDetector;
 
 class GateImageNestedParametrisedVolumeMessenger;
+class GateImageVoxelTransportModel;
 
 //-----------------------------------------------------------------------------
 ///  \brief Descendent of GateVImageVolume which represent the image using a G4VPVParametrisation (GateImageParametrisation)
@@ -73,6 +74,9 @@ public:
   void PrintInfo();
   //-----------------------------------------------------------------------------
 
+  virtual const GateImageLabels * GetLabels() const
+  { return mVoxelParametrisation ? &mVoxelParametrisation->GetLabels() : 0; }
+
   //-----------------------------------------------------------------------------
   virtual void GetPhysVolForAVoxel(const G4int index,
 				   const G4VTouchable & pTouchable,
@@ -87,6 +91,13 @@ public:
   // logical-volume (see GateVVolume.hh)
   virtual void PropagateGlobalSensitiveDetector();
 
+  //-----------------------------------------------------------------------------
+  /// Fast transport of the photons through the voxels (see
+  /// GateImageVoxelTransportModel)
+  void SetFastPhotonTransportFlag(bool b) { mFastPhotonTransportFlag = b; }
+  void SetFastPhotonTransportMaxOpticalDepth(G4double d) { mFastPhotonTransportMaxOpticalDepth = d; }
+  //-----------------------------------------------------------------------------
+
 
 protected:
   //-----------------------------------------------------------------------------
@@ -102,6 +113,10 @@ protected:
   G4LogicalVolume * logXRep;
   G4LogicalVolume * logYRep;
   G4LogicalVolume * logZRep;
+
+  bool mFastPhotonTransportFlag;
+  G4double mFastPhotonTransportMaxOpticalDepth;
+  GateImageVoxelTransportModel * mFastPhotonTransportModel;
 };
 // EO class GateImageNestedParametrisedVolume
 //-----------------------------------------------------------------------------
@@ -20,6 +20,8 @@
 
 #include "GateVImageVolumeMessenger.hh"
 #include "globals.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
 
 class GateImageNestedParametrisedVolume;
 
@@ -32,6 +34,11 @@ public:
   ~GateImageNestedParametrisedVolumeMessenger();
 
   void SetNewValue(G4UIcommand*, G4String);
+
+private:
+  GateImageNestedParametrisedVolume* pVolume;
+  G4UIcmdWithABool* FastPhotonTransportCmd;
+  G4UIcmdWithADouble* FastPhotonTransportMaxOpticalDepthCmd;
 };
 //-----------------------------------------------------------------------------
 
@@ -204,6 +204,10 @@ private:
   //====================================================================
   /// Loads the distance map
   void LoadDistanceMap();
+  /// Name of the distance map computed for the current labels, kept next to the image
+  G4String GetCachedDistanceMapFilename();
+  /// Writes the distance map under the cached name, false if the directory is not writable
+  G4bool WriteCachedDistanceMap(const G4String & cached);
   //====================================================================
   /// The name of the distance map file
   G4String mDistanceMapFilename;
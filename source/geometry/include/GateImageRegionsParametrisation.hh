@@ -0,0 +1,57 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*!
+  \class  GateImageRegionsParametrisation
+  \brief  Parametrisation of an image decomposed into boxes of
+  voxels with the same label (see GateImageRegionsParametrisedVolume).
+  Each copy is one box.
+*/
+
+#ifndef __GateImageRegionsParametrisation__hh__
+#define __GateImageRegionsParametrisation__hh__
+
+#include "GatePVParameterisation.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4Material;
+
+//-----------------------------------------------------------------------------
+class GateImageRegionsParametrisation : public GatePVParameterisation
+{
+public:
+  /// Box of voxels [x,x+nx[ x [y,y+ny[ x [z,z+nz[ with the same label
+  struct Region {
+    G4int x, y, z;
+    G4int nx, ny, nz;
+    G4int label;
+  };
+
+  GateImageRegionsParametrisation(const std::vector<Region> & regions,
+                                  const std::vector<G4Material*> & label2Material,
+                                  const G4ThreeVector & resolution,
+                                  const G4ThreeVector & voxelSize);
+  virtual ~GateImageRegionsParametrisation() {}
+
+  virtual int GetNbOfCopies() { return mRegions.size(); }
+
+  virtual void ComputeTransformation(const G4int copyNo, G4VPhysicalVolume * physVol) const;
+  virtual void ComputeDimensions(G4Box & box, const G4int copyNo, const G4VPhysicalVolume * physVol) const;
+  virtual G4Material* ComputeMaterial(const G4int copyNo, G4VPhysicalVolume * physVol, const G4VTouchable * parentTouch=0);
+
+protected:
+  std::vector<Region> mRegions;
+  std::vector<G4Material*> mVectorLabel2Material;
+  G4ThreeVector mVoxelSize;
+  G4ThreeVector mCornerPosition; // position of the corner of the voxel (0,0,0)
+};
+//-----------------------------------------------------------------------------
+
+#endif
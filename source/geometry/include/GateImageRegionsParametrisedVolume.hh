@@ -0,0 +1,97 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*!
+  \class  GateImageRegionsParametrisedVolume :
+  \brief Descendent of GateVImageVolume which represent the image as
+  boxes of voxels with the same label. The boxes are built at
+  construction by merging the runs of identical voxels along x, then
+  the identical runs of consecutive rows, then the identical
+  rectangles of consecutive planes. The particles cross one boundary
+  per box instead of one per voxel in the homogeneous regions.
+*/
+
+#ifndef __GateImageRegionsParametrisedVolume__hh__
+#define __GateImageRegionsParametrisedVolume__hh__
+
+#include "GateVImageVolume.hh"
+#include "GateImageRegionsParametrisation.hh"
+
+class GateMultiSensitiveDetector;
+class GateImageRegionsParametrisedVolumeMessenger;
+class G4PVParameterised;
+
+//-----------------------------------------------------------------------------
+class GateImageRegionsParametrisedVolume : public GateVImageVolume
+{
+public:
+
+  //-----------------------------------------------------------------------------
+  /// The type of label
+  typedef GateVImageVolume::LabelType LabelType;
+  /// The type of label images
+  typedef GateVImageVolume::ImageType ImageType;
+  typedef GateImageRegionsParametrisation::Region Region;
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  /// Constructor with :
+  /// the path to the volume to create (for commands)
+  /// the name of the volume to create
+  /// Creates the messenger associated to the volume
+  GateImageRegionsParametrisedVolume(const G4String& name,G4bool acceptsChildren,G4int depth);
+  /// Destructor
+  virtual ~GateImageRegionsParametrisedVolume();
+  //-----------------------------------------------------------------------------
+  FCT_FOR_AUTO_CREATOR_VOLUME(GateImageRegionsParametrisedVolume)
+
+  //-----------------------------------------------------------------------------
+  /// Returns a string describing the type of volume and which is used
+  /// for commands
+  virtual G4String GetTypeName() { return "ImageRegionsParametrised"; }
+
+  virtual G4LogicalVolume* ConstructOwnSolidAndLogicalVolume(G4Material*, G4bool);
+
+  //-----------------------------------------------------------------------------
+  /// Method which is called after the image file name and the label
+  /// to material file name have been set (callback from
+  /// GateVImageVolume)
+  virtual void ImageAndTableFilenamesOK() {}
+  //-----------------------------------------------------------------------------
+  /// Constructs the solid
+  virtual void ConstructSolid() {}
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  // IO
+  void PrintInfo();
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  void PropagateGlobalSensitiveDetector();
+  void PropagateSensitiveDetectorToChild(GateMultiSensitiveDetector * msd);
+
+protected:
+  /// Decomposes the labels of the image into boxes of identical voxels
+  void BuildRegions(std::vector<Region> & regions);
+
+  // The messenger
+  GateImageRegionsParametrisedVolumeMessenger* pMessenger;
+
+  G4PVParameterised * mImagePhysVol;
+  G4Box             * mRegionSolid;
+  G4LogicalVolume   * mRegionLog;
+  GateImageRegionsParametrisation * mRegionsParametrisation;
+  std::vector<G4Material*> mVectorLabel2Material;
+};
+// EO class GateImageRegionsParametrisedVolume
+//-----------------------------------------------------------------------------
+MAKE_AUTO_CREATOR_VOLUME(ImageRegionsParametrisedVolume,GateImageRegionsParametrisedVolume)
+
+#endif
@@ -0,0 +1,35 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*!
+  \class  GateImageRegionsParametrisedVolumeMessenger :
+  \brief  Messenger of GateImageRegionsParametrisedVolume.
+*/
+
+#ifndef __GateImageRegionsParametrisedVolumeMessenger__hh__
+#define __GateImageRegionsParametrisedVolumeMessenger__hh__
+
+#include "GateVImageVolumeMessenger.hh"
+#include "globals.hh"
+
+class GateImageRegionsParametrisedVolume;
+
+//-----------------------------------------------------------------------------
+/// \brief Messenger of GateImageRegionsParametrisedVolume
+class GateImageRegionsParametrisedVolumeMessenger : public GateVImageVolumeMessenger
+{
+public:
+  GateImageRegionsParametrisedVolumeMessenger(GateImageRegionsParametrisedVolume* volume);
+  ~GateImageRegionsParametrisedVolumeMessenger();
+
+  void SetNewValue(G4UIcommand*, G4String);
+};
+//-----------------------------------------------------------------------------
+
+#endif
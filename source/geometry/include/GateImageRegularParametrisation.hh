@@ -0,0 +1,48 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*!
+  \class  GateImageRegularParametrisation
+  \brief  G4PhantomParameterisation reading the material of the voxels
+  from the compact labels of the image (see GateImageLabels), instead
+  of an array of size_t indices.
+
+  The array of indices of G4PhantomParameterisation is only set when
+  skipping equal materials (G4RegularNavigation reads it directly). The
+  accessors to the material of a voxel are redefined to read the labels,
+  so that they never read the missing array.
+*/
+
+#ifndef __GateImageRegularParametrisation__hh__
+#define __GateImageRegularParametrisation__hh__
+
+#include "G4PhantomParameterisation.hh"
+#include "GateImageLabels.hh"
+
+class GateImageRegularParametrisation : public G4PhantomParameterisation
+{
+public:
+  GateImageRegularParametrisation(const GateImageLabels * labels, const std::vector<G4Material*> & materials);
+  virtual ~GateImageRegularParametrisation() {}
+
+  virtual G4Material* ComputeMaterial(const G4int repNo, G4VPhysicalVolume*, const G4VTouchable*);
+
+  size_t GetMaterialIndex(size_t copyNo) const { return pLabels->GetLabel(copyNo); }
+  size_t GetMaterialIndex(size_t nx, size_t ny, size_t nz) const
+  { return pLabels->GetLabel(nx + fNoVoxelX*ny + fNoVoxelXY*nz); }
+  G4Material* GetMaterial(size_t copyNo) const { return mLabel2Material[GetMaterialIndex(copyNo)]; }
+  G4Material* GetMaterial(size_t nx, size_t ny, size_t nz) const
+  { return mLabel2Material[GetMaterialIndex(nx, ny, nz)]; }
+
+protected:
+  const GateImageLabels * pLabels;
+  std::vector<G4Material*> mLabel2Material;
+};
+
+#endif
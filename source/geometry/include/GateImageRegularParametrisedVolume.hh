@@ -19,6 +19,7 @@ See LICENSE.md for further details
 #include "GateVImageVolume.hh"
 #include "G4PVParameterised.hh"
 #include "G4PhantomParameterisation.hh"
+#include "GateImageLabels.hh"
 
 class GateMultiSensitiveDetector;
 class GateImageRegularParametrisedVolumeMessenger;
@@ -73,6 +74,8 @@ public:
   void PrintInfo();
   //-----------------------------------------------------------------------------
 
+  virtual const GateImageLabels * GetLabels() const { return &mLabels; }
+
   //-----------------------------------------------------------------------------
   void PropagateGlobalSensitiveDetector();
   void PropagateSensitiveDetectorToChild(GateMultiSensitiveDetector * msd);
@@ -89,7 +92,8 @@ protected:
   G4Box             * mVoxelSolid;
   G4LogicalVolume   * mVoxelLog;
   std::vector<G4Material*> mVectorLabel2Material;
-  size_t * mImageData;
+  size_t * mImageData; // only needed by G4 when skipping equal materials
+  GateImageLabels mLabels;
   bool mSkipEqualMaterialsFlag;
 
 };
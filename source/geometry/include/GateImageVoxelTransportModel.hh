@@ -0,0 +1,117 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*!
+  \class  GateImageVoxelTransportModel
+  \brief  Fast transport of the photons through the voxels of a
+  GateImageNestedParametrisedVolume.
+
+  The model is attached to the region of the image. At each photon step
+  in the image, the voxels on the line of flight are traversed (3D-DDA
+  over the labels) up to a stopping point, which is the exit of the
+  image or, before, the point where the optical depth reaches a maximum.
+  The optical depth of each discrete process is accumulated with its
+  cross section in the material of each voxel (cached per label at the
+  energy of the photon) and compared to the number of interaction
+  lengths left already sampled by the process:
+
+  - if the photon reaches the stopping point without interaction, it is
+  moved there in one step, and the processes sample new interaction
+  lengths (exact, the distribution being memoryless);
+  - otherwise, the step is left to Geant4, which uses the same
+  interaction lengths and so interacts before the stopping point.
+
+  Only the photons whose discrete processes are all electromagnetic
+  (G4VEmProcess) are handled, and the image must have no daughter volume.
+  The interaction points are unchanged, but not the photon steps and
+  tracks: the model is disabled if an actor recording the steps in the
+  image has tracking or stepping actions, except the dose actor.
+*/
+
+#ifndef __GateImageVoxelTransportModel__hh__
+#define __GateImageVoxelTransportModel__hh__
+
+#include "G4VFastSimulationModel.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class GateImageNestedParametrisation;
+class G4VEmProcess;
+class G4MaterialCutsCouple;
+class G4Region;
+class G4LogicalVolume;
+
+//-----------------------------------------------------------------------------
+class GateImageVoxelTransportModel : public G4VFastSimulationModel
+{
+public:
+  GateImageVoxelTransportModel(const G4String & name);
+  virtual ~GateImageVoxelTransportModel();
+
+  // Attaches the model to the region of the image, called at each
+  // construction of the image volume
+  void SetImage(G4Region * region,
+                G4LogicalVolume * envelopeLog,
+                const GateImageNestedParametrisation * param,
+                const G4ThreeVector & resolution,
+                const G4ThreeVector & voxelSize);
+  // Optical depth of the longest flight, no limit if zero
+  void SetMaxOpticalDepth(G4double d) { mMaxOpticalDepth = d; }
+
+  virtual G4bool IsApplicable(const G4ParticleDefinition &);
+  virtual G4bool ModelTrigger(const G4FastTrack &);
+  virtual void DoIt(const G4FastTrack &, G4FastStep &);
+
+  // Adds the fast simulation process to the gammas if at least one model
+  // has been created. Called after the construction of the physics list.
+  static void ConstructProcess();
+
+protected:
+  void Initialize();
+  // Cross sections of the processes in the material of a label, at the
+  // current energy
+  const G4double * GetLambda(G4int label);
+  G4bool Refuse(const G4Track * track);
+
+  G4Region * pRegion;
+  G4LogicalVolume * pEnvelopeLog;
+  const GateImageNestedParametrisation * pParametrisation;
+  G4int mResolution[3];
+  G4double mVoxelSize[3];
+  G4double mHalfSize[3];
+  G4double mMaxOpticalDepth;
+
+  G4bool mIsInitialized;
+  G4bool mIsEnabled;
+  std::vector<G4VEmProcess*> mProcesses;
+  std::vector<const G4MaterialCutsCouple*> mCouples;
+
+  // Cross sections per label (labels x processes), valid when the stamp
+  // of the label is the current one
+  std::vector<G4double> mLambda;
+  std::vector<unsigned long> mLambdaStamp;
+  unsigned long mStamp;
+  G4double mLambdaEnergy;
+  std::vector<G4double> mLengthLeft;
+
+  // Last refused flight, not traversed again until the photon changes
+  const G4Track * pLastTrack;
+  G4int mLastTrackID;
+  G4double mLastEnergy;
+  G4ThreeVector mLastDirection;
+
+  // Stopping point of the accepted flight (local coordinates)
+  G4ThreeVector mStopPosition;
+  G4double mStopDistance;
+
+  static G4int mNumberOfModels;
+};
+//-----------------------------------------------------------------------------
+
+#endif
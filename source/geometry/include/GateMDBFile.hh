@@ -13,6 +13,8 @@ See LICENSE.md for further details
 
 #include "globals.hh"
 #include <fstream>
+#include <vector>
+#include <map>
 
 #include "G4Material.hh"
 
@@ -53,6 +55,7 @@ protected:
   void     ReadAllMaterialOptions(const G4String& materialName,const G4String& line,GateMaterialCreator* creator);
   void     ReadMaterialOption(const G4String& materialName,const G4String& field,GateMaterialCreator* creator);
 
+  void     LoadFile();
   void     FindSection(const G4String& name);
   G4bool   LookForText(const G4String& text);
   G4String ReadItem(const G4String& sectionName,const G4String& itemName);
@@ -64,7 +67,13 @@ private:
   GateMaterialDatabase* mDatabase;
   G4String fileName;
   G4String filePath;
-  std::ifstream dbStream;
+
+  // The file is read once: the lines are kept in memory, with the position of
+  // the sections and of the items of each section
+  std::vector<G4String> mLines;
+  size_t mCurrentLine;                                      //!< Next line read by ReadLine()
+  std::map<G4String,size_t> mSectionLine;                   //!< Line after the section header
+  std::map<G4String,std::map<G4String,size_t> > mItemLine;  //!< Line of each item of each section
 
 public:
   static char theStarterSeparator;
@@ -53,6 +53,7 @@ public:
 
   G4VSensitiveDetector * GetSensitiveDetector() {return pSensitiveDetector;}
   G4MultiFunctionalDetector* GetMultiFunctionalDetector() {return pMultiFunctionalDetector;}
+  const std::vector<GateVActor*> & GetListOfActors() const {return theListOfActors;}
 
 protected:
   virtual G4bool ProcessHits(G4Step *aStep,G4TouchableHistory *ROhist);
@@ -61,6 +62,8 @@ protected:
 protected:
   G4VSensitiveDetector * pSensitiveDetector;
   G4MultiFunctionalDetector* pMultiFunctionalDetector;
+  // actors attached to the volume or to one of its ancestors
+  std::vector<GateVActor*> theListOfActors;
 };
 
 #endif /* end #define GATEMSD_HH */
@@ -13,6 +13,7 @@ See LICENSE.md for further details
 #include "globals.hh"
 #include <iostream>
 #include <vector>
+#include <stdint.h>
 
 #define OUTPUTVOLUMEID_SIZE  6
 
@@ -57,6 +58,27 @@ inline GateOutputVolumeID::GateOutputVolumeID(size_t itsSize)
 {}
 
 
+/*! \typedef GateDetectorAddress
+    \brief  Packed 64-bit form of the system number and of an output volume ID
+
+    - Computed by GateVSystem::ComputeDetectorAddress() with a bit-field per level of the
+      system: the system number in the bits 55-61, then the levels of the output volume ID
+      from the bit 54 downward, so that the address of a block is a prefix of the address
+      of its crystals (see GateVSystem::GetDetectorAddressMask())
+
+    - The bit 62 (DETECTOR_ADDRESS_EXACT) is set when the volume ID itself is fully
+      determined by the address, i.e. when all the volumes below the base of the system
+      are system components. Two such addresses are equal if and only if the volume IDs are.
+
+    - A negative address means that the IDs could not be packed
+*/
+typedef int64_t GateDetectorAddress;
+
+#define DETECTOR_ADDRESS_EXACT     (((GateDetectorAddress)1)<<62)
+#define DETECTOR_ADDRESS_SYSTEM_BITS  7
+#define DETECTOR_ADDRESS_LEVEL_BITS  55
+#define DETECTOR_ADDRESS_SYSTEM(address)  ((G4int)((address)>>DETECTOR_ADDRESS_LEVEL_BITS) & ((1<<DETECTOR_ADDRESS_SYSTEM_BITS)-1))
+
 #define BASE_DEPTH    	   0
 #define RSECTOR_DEPTH      1
 #define MODULE_DEPTH       2
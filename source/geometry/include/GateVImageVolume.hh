@@ -32,6 +32,7 @@
 #include "GateRangeMaterialTable.hh"
 
 class GateVImageVolumeMessenger;
+class GateImageLabels;
 
 //-----------------------------------------------------------------------------
 ///  \brief Base (abstract) class for volumes which represent the data provided by a 3D image of labels and a label to material correspondence table
@@ -100,9 +101,14 @@ public:
   //-----------------------------------------------------------------------------
   /// Returns the volume's half size
   inline G4ThreeVector GetHalfSize() const { return mHalfSize; }
-  /// Gets the Image
-  inline ImageType* GetImage() { return pImage; }
-  inline const ImageType* GetImage() const { return pImage; }
+  /// Gets the Image. Its values are copied back from the labels if they
+  /// were released after the construction (see ReleaseImageData())
+  inline ImageType* GetImage() { if (mImageDataReleased) RestoreImageData(); return pImage; }
+  inline const ImageType* GetImage() const { if (mImageDataReleased) RestoreImageData(); return pImage; }
+  /// Gets the Image for its geometry only (its values may be released)
+  inline const ImageType* GetImageHeader() const { return pImage; }
+  /// Compact labels of the voxels, if the volume keeps them
+  virtual const GateImageLabels * GetLabels() const { return 0; }
 
   /// Returns the volume's transform matrix
   inline G4RotationMatrix GetTransformMatrix() const { return mTransformMatrix; }
@@ -175,6 +181,12 @@ protected:
   void LoadImage(bool add1VoxelMargin);
   /// Loads the LabelToMaterial file
   void LoadImageMaterialsTable();
+  /// Frees the float values of the image once the volume reads its
+  /// materials from the labels (GetLabels()). They are copied back from
+  /// the labels by the first call to GetImage() (e.g. by an actor).
+  void ReleaseImageData();
+  void RestoreImageData() const;
+  mutable bool mImageDataReleased;
   void LoadImageMaterialsFromHounsfieldTable();
   void LoadImageMaterialsFromLabelTable();
   void LoadImageMaterialsFromRangeTable();
@@ -199,6 +211,8 @@ protected:
   //-----------------------------------------------------------------------------
   /// Build distance map
   void BuildDistanceTransfo();
+  /// Computes the distance map of the image (one thread per core)
+  void ComputeDistanceTransfo(GateImage & output);
   G4String mDistanceTransfoOutput;
   bool mBuildDistanceTransfo;
   //-----------------------------------------------------------------------------
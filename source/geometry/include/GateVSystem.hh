@@ -12,6 +12,7 @@ See LICENSE.md for further details
 
 #include "globals.hh"
 #include <vector>
+#include <set>
 
 #include "GateClockDependent.hh"
 #include "GateOutputVolumeID.hh"
@@ -208,7 +209,18 @@ class GateVSystem : public GateClockDependent
     //G4ThreeVector ComputeObjectCenter(const std::vector<G4int>& numList) const;
     G4ThreeVector ComputeObjectCenter(const GateVolumeID* volID) const;
     GateVolumeID* MakeVolumeID(const std::vector<G4int>& numList) const;
+
+    //! Packed address of a volume of the system (see GateDetectorAddress), negative if the
+    //! output volume ID does not fit in the bit-fields of the levels
+    GateDetectorAddress ComputeDetectorAddress(const GateVolumeID& volumeID, const GateOutputVolumeID& outputVolumeID);
+    //! Mask of the bits of the system number and of the levels 0 to depth of the addresses:
+    //! two volumes are in the same element of this depth if their masked addresses are equal.
+    //! Returns 0 if the output volume IDs of the system can't be packed.
+    GateDetectorAddress GetDetectorAddressMask(size_t depth);
   protected:
+    //! Computes the bit-fields of the levels from the number of elements of the component tree
+    void ComputeDetectorAddressLayout();
+
     typedef std::vector< GateSystemComponent* > compList_t;
     compList_t* MakeComponentListAtLevel(G4int level) const;
     GateSystemComponent * m_BaseComponent;      	//!< The base component of the system
@@ -217,6 +229,13 @@ class GateVSystem : public GateClockDependent
     G4int m_itsNumber;                          //! the insertion order of a system, it is too the systemID ((multi-system approach)
     G4int m_sysNumber;
     G4int static m_insertionOrder;              //! a static member to carry the insertion number (multi-system approach)
+
+    //! Layout of the detector addresses, computed at the first address (the geometry must be built)
+    G4bool m_addressLayoutDone;
+    std::vector<G4int> m_addressShift;          //! Position of the bit-field of each level
+    std::vector<G4int> m_addressBits;           //! Width of the bit-field of each level, empty if not packable
+    std::vector<GateDetectorAddress> m_addressMasks; //! Mask of the levels 0 to depth, for each depth
+    std::set<GateVVolume*> m_componentCreators; //! Creators of the components of the system
 };
 
 
@@ -165,6 +165,10 @@ public :
   inline virtual const G4String& GetPhysicalVolumeName() const
   { return mPhysicalVolumeName;}
 
+  //! Updates the placements of the volumes of the tree which have a move or a repeater list,
+  //! without reconstructing their solids, and collects the physical volumes which have moved
+  virtual void UpdatePlacements(std::vector<G4VPhysicalVolume*>& movedVolumes);
+
   //! Returns the number of physical volumes created by the inserter
   virtual inline G4int GetVolumeNumber() const  	      	      	{ return theListOfOwnPhysVolume.size(); }
 
@@ -39,7 +39,6 @@
  *
  **/
 
-//#define _MULTITHREAD 1
 
 #include "GateDMapdt.h"
 #include "GateDMapdt_core.h"
@@ -47,6 +46,32 @@
 //Inline def of +infty opertators
 #include "GateDMapoperators.ihh"
 
+#include <thread>
+#include <vector>
+
+//--------------------------------------------------------------------
+// Runs f(min,max) on NbThreads consecutive blocks of [0,n). The lines
+// of a phase are independent, each block writes its own lines.
+template<class F>
+void parallelBlocks(int n, unsigned int NbThreads, F f)
+{
+  if (NbThreads > (unsigned int)n) NbThreads = n;
+  if (NbThreads <= 1) {
+    f(0, n);
+    return;
+  }
+  std::vector<std::thread> threads;
+  int prev = 0;
+  for (unsigned int t = 0; t < NbThreads - 1; t++) {
+    int next = prev + n/NbThreads;
+    threads.push_back(std::thread(f, prev, next));
+    prev = next;
+  }
+  f(prev, n);
+  for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+}
+//--------------------------------------------------------------------
+
 
 /***************************************************************************************************************/
 /***************************************************************************************************************/
@@ -128,35 +153,6 @@ inline void phaseSaitoX_1D(const Vol &V, Longvol &sdt_x, const bool isMultiregio
 }
 
 
-#ifdef _MULTITHREAD
-struct thread_data
-{
-  int  thread_id;
-  const Vol *V;
-  Longvol *sdt_x;
-  Longvol *output;
-  bool isMultiregion;
-  bool isToric;
-  int minIter;
-  int maxIter;
-};
-
-void *phaseSaitoX_blockZ_multithread(void *threadarg)
-{
-  struct thread_data *data;
-  data = (struct thread_data* ) threadarg;
-
-
-  cout << "Thread ("<<data->thread_id<<"): "<< data->minIter<<" -> "<<data->maxIter<<endl;
-
-  for (int z = data->minIter; z < data->maxIter ; z++)
-    for (int y = 0; y < data->V->sizeY() ; y++)
-      {
-	phaseSaitoX_1D(*(data->V),*(data->sdt_x),data->isMultiregion,data->isToric,y,z);
-      }
-  return 0;
-}
-#endif
 
 //--------------------------------------------------------------------
 void phaseSaitoX_blockZ(const Vol &V, Longvol &sdt_x, const bool isMultiregion, const bool isToric, int minZ,int maxZ)
@@ -180,58 +176,11 @@ void phaseSaitoX_blockZ(const Vol &V, Longvol &sdt_x, const bool isMultiregion,
 void phaseSaitoX(const Vol &V, Longvol &sdt_x, 
                  const bool isMultiregion, 
                  const bool isToric, 
-                 const int /*NbThreads=1*/)
+                 const unsigned int NbThreads)
 {
-#ifndef _MULTITHREAD    //Call to the block version
-  phaseSaitoX_blockZ(V,sdt_x,isMultiregion,isToric,0,V.sizeZ());
-#else
-  pthread_t * threads = new pthread_t[NbThreads];
-  thread_data * thread_data_array = new thread_data[NbThreads];
-  int prevz = 0;
-  int rc,t;
-  pthread_attr_t attr;
-
-  /* Initialize and set thread detached attribute */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-
-  //Thread create
-  for ( t=0; t<NbThreads - 1; t++)
-    {
-      thread_data_array[t].thread_id = t;
-      thread_data_array[t].V = &V;
-      thread_data_array[t].sdt_x = &sdt_x;
-      thread_data_array[t].isToric = isToric;
-      thread_data_array[t].isMultiregion = isMultiregion;
-      thread_data_array[t].minIter = prevz;
-      thread_data_array[t].maxIter = prevz + (V.sizeZ() / NbThreads);
-      prevz = thread_data_array[t].maxIter ;
-      rc = pthread_create(&threads[t], &attr, phaseSaitoX_blockZ_multithread, (void *) &thread_data_array[t]);
-    }
-
-  //Last one
-  thread_data_array[t].thread_id = t;
-  thread_data_array[t].V = &V;
-  thread_data_array[t].sdt_x = &sdt_x;
-  thread_data_array[t].isToric = isToric;
-  thread_data_array[t].isMultiregion = isMultiregion;
-  thread_data_array[t].minIter = prevz;
-  thread_data_array[t].maxIter = V.sizeZ();
-  rc = pthread_create(&threads[t], &attr, phaseSaitoX_blockZ_multithread, (void *) &thread_data_array[t]);
-
-  //Join
-  pthread_attr_destroy(&attr);
-  for (t = 0; t < NbThreads; t++)
-    {
-      rc = pthread_join(threads[t], NULL);
-      if (rc)
-        {
-	  printf("ERROR; return code from pthread_join() is %d\n", rc);
-	  exit(-1);
-        }
-    }
-#endif
+  parallelBlocks(V.sizeZ(), NbThreads, [&](int minZ, int maxZ) {
+      phaseSaitoX_blockZ(V, sdt_x, isMultiregion, isToric, minZ, maxZ);
+    });
 }
 
 
@@ -317,35 +266,6 @@ inline void phaseSaitoY_1D(const Vol &V, Longvol &sdt_x, Longvol &sdt_xy,
 //--------------------------------------------------------------------
 
 //--------------------------------------------------------------------
-#ifdef _MULTITHREAD
-void *phaseSaitoY_block_multithread(void *threadarg)
-{
-  struct thread_data *data;
-  data = (struct thread_data* ) threadarg;
-
-  long int *sdt_temp;  //Row copy for the toric domain mode
-  unsigned int *s;
-  unsigned int *t;
-
-  //Local Memory
-  s = (unsigned int *)malloc(sizeof(unsigned int)*((data->sdt_x)->sizeY()+1));
-  t = (unsigned int *)malloc(sizeof(unsigned int)*((data->sdt_x)->sizeY()+1));
-  sdt_temp = (long int *)malloc(sizeof(long int)*((data->sdt_x)->sizeY()+1));
-
-
-  cout << "Thread ("<<data->thread_id<<"): "<< data->minIter<<" -> "<<data->maxIter<<endl;
-
-  for (int z = data->minIter; z < data->maxIter ; z++)
-    for (int x = 0; x < data->V->sizeX() ; x++)
-      {
-	phaseSaitoY_1D(*(data->V),*(data->sdt_x),*(data->output),data->isMultiregion,data->isToric,x,z,sdt_temp,s,t);
-      }
-  free(s);
-  free(t);
-  free(sdt_temp);
-  return 0;
-}
-#endif
 
 //--------------------------------------------------------------------
 void phaseSaitoY_block(const Vol &V, Longvol &sdt_x, Longvol &sdt_xy, 
@@ -387,63 +307,12 @@ void phaseSaitoY_block(const Vol &V, Longvol &sdt_x, Longvol &sdt_xy,
 //[Meijster/Roerdnik/Hesselink] optimization
 void phaseSaitoY(const Vol &V, Longvol &sdt_x, Longvol &sdt_xy, 
 		 const bool isMultiregion, const bool isToric, 
-		 const int /*NbThreads*/)
+		 const unsigned int NbThreads)
 {
 
-#ifndef _MULTITHREAD
-  // std::cout << "Je *ne* suis *pas* _MULTITHREAD\n";
-  phaseSaitoY_block(V, sdt_x, sdt_xy, isMultiregion, isToric, 0, V.sizeZ());
-  //DS : I change V.sizeY() by V.sizeZ()
-#else
-  // std::cout << "Je  suis  _MULTITHREAD\n";
-  pthread_t * threads = new pthread_t[NbThreads];
-  thread_data * thread_data_array = new thread_data[NbThreads];
-  int prevz = 0;
-  int rc,t;
-  pthread_attr_t attr;
-
-  /* Initialize and set thread detached attribute */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  //Thread create
-  for ( t=0; t<NbThreads - 1; t++)
-    {
-      thread_data_array[t].thread_id = t;
-      thread_data_array[t].V = &V;
-      thread_data_array[t].sdt_x = &sdt_x;
-      thread_data_array[t].output = &sdt_xy;
-      thread_data_array[t].isToric = isToric;
-      thread_data_array[t].isMultiregion = isMultiregion;
-      thread_data_array[t].minIter = prevz;
-      thread_data_array[t].maxIter = prevz + (V.sizeZ() / NbThreads);
-      prevz = thread_data_array[t].maxIter ;
-      rc = pthread_create(&threads[t], &attr, phaseSaitoY_block_multithread, (void *) &thread_data_array[t]);
-    }
-
-  //Last one
-  thread_data_array[t].thread_id = t;
-  thread_data_array[t].V = &V;
-  thread_data_array[t].sdt_x = &sdt_x;
-  thread_data_array[t].output = &sdt_xy;
-  thread_data_array[t].isToric = isToric;
-  thread_data_array[t].isMultiregion = isMultiregion;
-  thread_data_array[t].minIter = prevz;
-  thread_data_array[t].maxIter = V.sizeZ();
-  rc = pthread_create(&threads[t], &attr,  phaseSaitoY_block_multithread, (void *) &thread_data_array[t]);
-
-  //Join
-  pthread_attr_destroy(&attr);
-  for (t = 0; t < NbThreads; t++)
-    {
-      rc = pthread_join(threads[t], NULL);
-      if (rc)
-        {
-	  printf("ERROR; return code from pthread_join() is %d\n", rc);
-	  exit(-1);
-        }
-    }
-#endif
+  parallelBlocks(V.sizeZ(), NbThreads, [&](int minZ, int maxZ) {
+      phaseSaitoY_block(V, sdt_x, sdt_xy, isMultiregion, isToric, minZ, maxZ);
+    });
 }
 
 /***************************************************************************************************************/
@@ -518,35 +387,6 @@ inline void phaseSaitoZ_1D(const Vol &V, Longvol &sdt_xy, Longvol &sdt_xyz, cons
     }
 }
 
-#ifdef _MULTITHREAD
-void *phaseSaitoZ_block_multithread(void *threadarg)
-{
-  struct thread_data *data;
-  data = (struct thread_data* ) threadarg;
-
-  long int *sdt_temp;  //Row copy for the toric domain mode
-  unsigned int *s;
-  unsigned int *t;
-
-  //Local Memory
-  s = (unsigned int *)malloc(sizeof(unsigned int)*((data->sdt_x)->sizeZ()+1));
-  t = (unsigned int *)malloc(sizeof(unsigned int)*((data->sdt_x)->sizeZ()+1));
-  sdt_temp = (long int *)malloc(sizeof(long int)*((data->sdt_x)->sizeZ()+1));
-
-
-  cout << "Thread ("<<data->thread_id<<"): "<< data->minIter<<" -> "<<data->maxIter<<endl;
-
-  for (int y = data->minIter; y < data->maxIter ; y++)
-    for (int x = 0; x < data->V->sizeX() ; x++)
-      {
-	phaseSaitoZ_1D(*(data->V),*(data->sdt_x),*(data->output),data->isMultiregion,data->isToric,x,y,sdt_temp,s,t);
-      }
-  free(s);
-  free(t);
-  free(sdt_temp);
-  return 0;
-}
-#endif
 //--------------------------------------------------------------------
 
 //--------------------------------------------------------------------
@@ -587,62 +427,12 @@ void phaseSaitoZ_block(const Vol &V, Longvol &sdt_xy, Longvol &sdt_xyz, const bo
 //[Meijster/Roerdnik/Hesselink] optimization
 void phaseSaitoZ(const Vol &V, Longvol &sdt_xy, Longvol &sdt_xyz, 
                  const bool isMultiregion, const bool isToric, 
-                 const int /*NbThreads*/)
+                 const unsigned int NbThreads)
 {
 
-#ifndef _MULTITHREAD
-  // std::cout << "phaseSaitoZ no _MULTITHREAD \n";
-  phaseSaitoZ_block(V, sdt_xy, sdt_xyz, isMultiregion, isToric, 0, V.sizeY());
-  //DS : I change V.sizeZ() by V.sizeY()
-#else
-  pthread_t * threads = new pthread_t[NbThreads];
-  thread_data * thread_data_array = new thread_data [NbThreads];
-  int prevz = 0;
-  int rc,t;
-  pthread_attr_t attr;
-
-  /* Initialize and set thread detached attribute */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  //Thread create
-  for ( t=0; t<NbThreads - 1; t++)
-    {
-      thread_data_array[t].thread_id = t;
-      thread_data_array[t].V = &V;
-      thread_data_array[t].sdt_x = &sdt_xy;
-      thread_data_array[t].output = &sdt_xyz;
-      thread_data_array[t].isToric = isToric;
-      thread_data_array[t].isMultiregion = isMultiregion;
-      thread_data_array[t].minIter = prevz;
-      thread_data_array[t].maxIter = prevz + (V.sizeY() / NbThreads);
-      prevz = thread_data_array[t].maxIter ;
-      rc = pthread_create(&threads[t], &attr, phaseSaitoZ_block_multithread, (void *) &thread_data_array[t]);
-    }
-
-  //Last one
-  thread_data_array[t].thread_id = t;
-  thread_data_array[t].V = &V;
-  thread_data_array[t].sdt_x = &sdt_xy;
-  thread_data_array[t].output = &sdt_xyz;
-  thread_data_array[t].isToric = isToric;
-  thread_data_array[t].isMultiregion = isMultiregion;
-  thread_data_array[t].minIter = prevz;
-  thread_data_array[t].maxIter = V.sizeY();
-  rc = pthread_create(&threads[t], &attr,  phaseSaitoZ_block_multithread, (void *) &thread_data_array[t]);
-
-  //Join
-  pthread_attr_destroy(&attr);
-  for (t = 0; t < NbThreads; t++)
-    {
-      rc = pthread_join(threads[t], NULL);
-      if (rc)
-        {
-	  printf("ERROR; return code from pthread_join() is %d\n", rc);
-	  exit(-1);
-        }
-    }
-#endif
+  parallelBlocks(V.sizeY(), NbThreads, [&](int minY, int maxY) {
+      phaseSaitoZ_block(V, sdt_xy, sdt_xyz, isMultiregion, isToric, minY, maxY);
+    });
 }
 
 //*******************************************************************************
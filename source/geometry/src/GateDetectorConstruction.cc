@@ -26,6 +26,8 @@
 
 #include "globals.hh"
 #include "G4Navigator.hh"
+#include "G4GeometryManager.hh"
+#include <set>
 #include "G4SDManager.hh"
 #include "G4Material.hh"
 #include "G4NistManager.hh"
@@ -46,6 +48,7 @@ GateDetectorConstruction::GateDetectorConstruction()
      m_phantomSD(0),
      pdetectorMessenger(0),
      moveFlag(0),
+     m_incrementalMotion(false),
      m_magField(0), m_magFieldValue(0),
      e_electFieldValue(0),
      m_magFieldUniform(false), m_magFieldTabulated(false),
@@ -388,6 +391,11 @@ void GateDetectorConstruction::UpdateGeometry()
 
   switch (nGeometryStatus){
   case geometry_needs_update:
+    if (m_incrementalMotion && UpdateMovingVolumes()) {
+      nGeometryStatus = geometry_is_uptodate;
+      GateMessage("Geometry", 3, "UpdateGeometry finished (incremental motion). \n");
+      return;
+    }
     pworld->Construct(true);
     break;
 
@@ -449,6 +457,36 @@ void GateDetectorConstruction::DestroyGeometry()
 */
 //---------------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------------
+// The world is not redefined, so that the run manager does not reopen and
+// re-optimise the whole geometry at the next run: only the mother volumes of
+// the moved placements are reopened and re-optimised here. The navigator is
+// reset by GateRunManager::RunInitialization().
+G4bool GateDetectorConstruction::UpdateMovingVolumes()
+{
+  G4GeometryManager* geometryManager = G4GeometryManager::GetInstance();
+  if (!geometryManager->IsGeometryClosed())
+    return false;
+
+  std::vector<G4VPhysicalVolume*> movedVolumes;
+  pworld->UpdatePlacements(movedVolumes);
+
+  std::set<G4LogicalVolume*> motherVolumes;
+  for (size_t i=0; i<movedVolumes.size(); i++) {
+    G4LogicalVolume* mother = movedVolumes[i]->GetMotherLogical();
+    if (!mother || !motherVolumes.insert(mother).second)
+      continue;
+    geometryManager->OpenGeometry(movedVolumes[i]);
+    geometryManager->CloseGeometry(true, false, movedVolumes[i]);
+  }
+
+  GateMessage("Move", 3, movedVolumes.size() << " placements moved, "
+              << motherVolumes.size() << " mother volumes re-optimised\n");
+  return true;
+}
+//---------------------------------------------------------------------------------
+
+
 //---------------------------------------------------------------------------------
 void GateDetectorConstruction::ClockHasChanged()
 {
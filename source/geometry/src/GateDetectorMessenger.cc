@@ -167,6 +167,12 @@ GateDetectorMessenger::GateDetectorMessenger(GateDetectorConstruction* GateDet)
   IoniCmd = new G4UIcmdWithAString(cmd,this);
   IoniCmd->SetGuidance("Set the ionisation potential for a material (two parameters 'material' and 'value and unit')");
 
+  cmd = "/gate/geometry/setIncrementalMotion";
+  pIncrementalMotionCmd = new G4UIcmdWithABool(cmd,this);
+  pIncrementalMotionCmd->SetGuidance("At each time slice, only update the placements of the moving volumes and re-optimise their mother volumes");
+  pIncrementalMotionCmd->SetParameterName("flag",true);
+  pIncrementalMotionCmd->SetDefaultValue(true);
+
 
 
 
@@ -182,6 +188,7 @@ GateDetectorMessenger::~GateDetectorMessenger()
   delete pMagFieldCmd;
   delete pListCreatorsCmd;
   delete IoniCmd;
+  delete pIncrementalMotionCmd;
 
   delete pGateGeometryDir;
   delete pGateDir;
@@ -228,6 +235,9 @@ void GateDetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
 
   else if( command == pMagIntegratorStepperCmd )
      { pDetectorConstruction->SetMagIntegratorStepper(newValue);}
+
+  else if( command == pIncrementalMotionCmd )
+     { pDetectorConstruction->SetIncrementalMotion(pIncrementalMotionCmd->GetNewBoolValue(newValue));}
  
   else if( command == pListCreatorsCmd )
     { pDetectorConstruction->GetObjectStore()->ListCreators(); }
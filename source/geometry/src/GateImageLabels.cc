@@ -0,0 +1,116 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#include "GateImageLabels.hh"
+#include "GateMessageManager.hh"
+
+#include <limits>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+GateImageLabels::GateImageLabels()
+  : mData8(0), mData16(0), mData32(0), mLineSize(0), mPlaneSize(0), mNumberOfValues(0)
+{
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageLabels::Clear()
+{
+  std::vector<unsigned char>().swap(mLabels8);
+  std::vector<unsigned short>().swap(mLabels16);
+  std::vector<unsigned int>().swap(mLabels32);
+  mSharedFile.Unmap();
+  mData8 = 0;
+  mData16 = 0;
+  mData32 = 0;
+  mNumberOfValues = 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageLabels::Build(const GateImage & image, size_t numberOfLabels)
+{
+  Clear();
+  mLineSize = image.GetLineSize();
+  mPlaneSize = image.GetPlaneSize();
+  mNumberOfValues = image.GetNumberOfValues();
+
+  for (size_t i=0; i<mNumberOfValues; i++) {
+    G4int label = (G4int)image.GetValue(i);
+    if (label < 0 || (size_t)label >= numberOfLabels)
+      GateError("The label " << label << " of the voxel " << i
+                << " has no material (" << numberOfLabels << " labels)\n");
+  }
+
+  if (numberOfLabels <= (size_t)std::numeric_limits<unsigned char>::max()+1) {
+    mLabels8.resize(mNumberOfValues);
+    for (size_t i=0; i<mNumberOfValues; i++) mLabels8[i] = (unsigned char)image.GetValue(i);
+    mData8 = mLabels8.data();
+  }
+  else if (numberOfLabels <= (size_t)std::numeric_limits<unsigned short>::max()+1) {
+    mLabels16.resize(mNumberOfValues);
+    for (size_t i=0; i<mNumberOfValues; i++) mLabels16[i] = (unsigned short)image.GetValue(i);
+    mData16 = mLabels16.data();
+  }
+  else {
+    mLabels32.resize(mNumberOfValues);
+    for (size_t i=0; i<mNumberOfValues; i++) mLabels32[i] = (unsigned int)image.GetValue(i);
+    mData32 = mLabels32.data();
+  }
+
+  GateMessage("Volume", 3, "Labels of the image stored on " << GetBytesPerLabel()
+              << " byte(s) per voxel (" << numberOfLabels << " labels)\n");
+
+  if (GateSharedFile::IsEnabled()) Share();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// The labels are moved to a shared file named by their key and size. The
+// private copy is kept if the file can't be written or mapped.
+void GateImageLabels::Share()
+{
+  const size_t bytes = GetBytesPerLabel();
+  const void * data = mData8 ? (const void*)mData8 : mData16 ? (const void*)mData16 : (const void*)mData32;
+  const size_t size = mNumberOfValues*bytes;
+  std::ostringstream name;
+  name << "labels-" << GateSharedFile::ComputeKey(data, size) << "-" << bytes << ".bin";
+  bool mapped = mSharedFile.Map(name.str(), [data, size](std::ostream & os) {
+      os.write((const char*)data, size);
+      return (bool)os;
+    });
+  if (!mapped || mSharedFile.GetSize() != size) {
+    mSharedFile.Unmap();
+    return;
+  }
+
+  if (bytes == 1) mData8 = (const unsigned char*)mSharedFile.GetData();
+  if (bytes == 2) mData16 = (const unsigned short*)mSharedFile.GetData();
+  if (bytes == 4) mData32 = (const unsigned int*)mSharedFile.GetData();
+  std::vector<unsigned char>().swap(mLabels8);
+  std::vector<unsigned short>().swap(mLabels16);
+  std::vector<unsigned int>().swap(mLabels32);
+  GateMessage("Volume", 2, "Labels of the image shared in " << GateSharedFile::GetDirectory()
+              << "/" << name.str() << Gateendl);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+size_t GateImageLabels::GetBytesPerLabel() const
+{
+  if (mData8) return 1;
+  if (mData16) return 2;
+  return 4;
+}
+//-----------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include "GateMultiSensitiveDetector.hh"
 #include "GateMiscFunctions.hh"
 #include "GateImageBox.hh"
+#include "GateImageVoxelTransportModel.hh"
 
 ///---------------------------------------------------------------------------
 /// Constructor with :
@@ -37,6 +38,10 @@ GateImageNestedParametrisedVolume::GateImageNestedParametrisedVolume(const G4Str
   : GateVImageVolume(name,acceptsChildren,depth)
 {
   GateMessageInc("Volume",5,"Begin GateImageNestedParametrisedVolume("<<name<<")\n");
+  mFastPhotonTransportFlag = false;
+  mFastPhotonTransportMaxOpticalDepth = 1.0;
+  mFastPhotonTransportModel = 0;
+  mVoxelParametrisation = 0;
   pMessenger = new GateImageNestedParametrisedVolumeMessenger(this);
   GateMessageDec("Volume",5,"End GateImageNestedParametrisedVolume("<<name<<")\n");
 }
@@ -55,6 +60,7 @@ GateImageNestedParametrisedVolume::~GateImageNestedParametrisedVolume()
   delete logXRep;
   delete logYRep;
   delete logZRep;
+  delete mFastPhotonTransportModel;
   GateMessageDec("Volume",5,"End ~GateImageNestedParametrisedVolume()\n");
 }
 ///---------------------------------------------------------------------------
@@ -193,6 +199,21 @@ G4LogicalVolume* GateImageNestedParametrisedVolume::ConstructOwnSolidAndLogicalV
 			  (int)lrint(GetImage()->GetResolution().z()), // Number of copies = number of voxels
 			  voxelParam);
 
+  //---------------------------
+  // Fast photon transport, attached to the region of the image (the one
+  // set on pBoxLog by GateVVolume)
+  if (mFastPhotonTransportFlag) {
+    if (!mFastPhotonTransportModel)
+      mFastPhotonTransportModel = new GateImageVoxelTransportModel(GetObjectName() + "_fastPhotonTransport");
+    mFastPhotonTransportModel->SetMaxOpticalDepth(mFastPhotonTransportMaxOpticalDepth);
+    mFastPhotonTransportModel->SetImage(G4RegionStore::GetInstance()->FindOrCreateRegion(GetObjectName()),
+                                        pBoxLog, mVoxelParametrisation,
+                                        GetImage()->GetResolution(), GetImage()->GetVoxelSize());
+  }
+
+  // The materials are read from the labels of the parametrisation
+  ReleaseImageData();
+
   GateMessageInc("Volume",3,"End GateImageNestedParametrisedVolume::ConstructOwnSolidAndLogicalVolume()\n");
   return pBoxLog;
 }
@@ -236,7 +257,7 @@ void GateImageNestedParametrisedVolume::GetPhysVolForAVoxel(const G4int index,
   // Get dimension (no computation, because same size)
   pSolid->ComputeDimensions(mVoxelParametrisation, index, pPhysVol);
   // Compute position// --> slow ?! should be precomputed ?
-  G4ThreeVector v = GetImage()->GetCoordinatesFromIndex(index);
+  G4ThreeVector v = GetImageHeader()->GetCoordinatesFromIndex(index);
   int ix,iy,iz;
   ix = (int)lrint(v[0]);
   iy = (int)lrint(v[1]);
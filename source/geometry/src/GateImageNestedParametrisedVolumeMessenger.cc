@@ -18,9 +18,17 @@
 
 //-----------------------------------------------------------------------------
 GateImageNestedParametrisedVolumeMessenger::GateImageNestedParametrisedVolumeMessenger(GateImageNestedParametrisedVolume* volume)
-  :GateVImageVolumeMessenger(volume)
+  :GateVImageVolumeMessenger(volume), pVolume(volume)
 {
   GateMessageInc("Volume",6,"Begin GateImageNestedParametrisedVolumeMessenger()\n");
+  G4String cmdName = GetDirectoryName()+"enableFastPhotonTransport";
+  FastPhotonTransportCmd = new G4UIcmdWithABool(cmdName,this);
+  FastPhotonTransportCmd->SetGuidance("Transport the photons through the voxels with a voxel traversal instead of the Geant4 navigation (default: no)");
+  cmdName = GetDirectoryName()+"setFastPhotonTransportMaxOpticalDepth";
+  FastPhotonTransportMaxOpticalDepthCmd = new G4UIcmdWithADouble(cmdName,this);
+  FastPhotonTransportMaxOpticalDepthCmd->SetGuidance("Maximum optical depth of a fast photon step, no maximum if 0 (default: 1)");
+  FastPhotonTransportMaxOpticalDepthCmd->SetParameterName("Depth",false);
+  FastPhotonTransportMaxOpticalDepthCmd->SetRange("Depth>=0");
   GateMessageDec("Volume",6,"End GateImageNestedParametrisedVolumeMessenger()\n");
 }
 //-----------------------------------------------------------------------------
@@ -30,6 +38,8 @@ GateImageNestedParametrisedVolumeMessenger::GateImageNestedParametrisedVolumeMes
 GateImageNestedParametrisedVolumeMessenger::~GateImageNestedParametrisedVolumeMessenger()
 {
   GateMessageInc("Volume",6,"Begin ~GateImageNestedParametrisedVolumeMessenger()\n");
+  delete FastPhotonTransportCmd;
+  delete FastPhotonTransportMaxOpticalDepthCmd;
   GateMessageDec("Volume",6,"End ~GateImageNestedParametrisedVolumeMessenger()\n");
 }
 //-----------------------------------------------------------------------------
@@ -41,6 +51,14 @@ void GateImageNestedParametrisedVolumeMessenger::SetNewValue(G4UIcommand* comman
   GateMessage("Volume",6,"GateImageNestedParametrisedVolumeMessenger::SetNewValue "
               << command->GetCommandPath()
 	      << " newValue=" << newValue << Gateendl);
-  GateVImageVolumeMessenger::SetNewValue(command,newValue);
+  if (command == FastPhotonTransportCmd) {
+    pVolume->SetFastPhotonTransportFlag(FastPhotonTransportCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == FastPhotonTransportMaxOpticalDepthCmd) {
+    pVolume->SetFastPhotonTransportMaxOpticalDepth(FastPhotonTransportMaxOpticalDepthCmd->GetNewDoubleValue(newValue));
+  }
+  else {
+    GateVImageVolumeMessenger::SetNewValue(command,newValue);
+  }
 }
 //-----------------------------------------------------------------------------
@@ -22,9 +22,16 @@
 #include "GateMultiSensitiveDetector.hh"
 #include "GateUserActions.hh"
 #include "GateImage.hh"
+#include "GateSharedFile.hh"
 #include "GatePhantomSD.hh"
 #include "GateDetectorConstruction.hh"
 
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+#include <sstream>
+#include <iomanip>
+
 //-----------------------------------------------------------------------------
 /// Constructor with :
 /// the path to the volume to create (for commands)
@@ -185,23 +192,33 @@ void GateImageRegionalizedVolume::LoadDistanceMap()
 {
   GateMessageInc("Volume",3,"GateImageRegionalizedVolume::LoadDistanceMap("<<mDistanceMapFilename<<") - begin\n");
 
+  if (pDistanceMap) delete pDistanceMap;
+  pDistanceMap = new DistanceMapType;
+
+  // No distance map provided: it is computed, or read from a previous
+  // computation with the same labels
   if (mDistanceMapFilename == "none") {
-    GateError("ImageRegionalized Volume <" << GetObjectName()
-	      << "> : No distance map provided, the navigation could not be optimized."
-	      << Gateendl
-	      << "Please use /gate/" << GetObjectName() << "/geometry/buildAndDumpDistanceTransfo dmap.mhd"
-	      << Gateendl
-	      << "to generate the dmap and then, /gate/patient/geometry/distanceMap dmap.mhd to use it."
-	      << Gateendl);
-    pDistanceMap = new DistanceMapType;
-    pDistanceMap->SetResolutionAndHalfSize(GetImage()->GetResolution(), GetImage()->GetHalfSize());
-    pDistanceMap->Allocate();
-    pDistanceMap->Fill(0.0);
-    pDistanceMap->PrintInfo();
+    G4String cached = GetCachedDistanceMapFilename();
+    if (std::ifstream(cached.c_str())) {
+      GateMessage("Volume", 1, "Distance map of <" << GetObjectName() << "> read from " << cached << Gateendl);
+      pDistanceMap->Read(cached);
+    }
+    else {
+      ComputeDistanceTransfo(*pDistanceMap);
+      if (WriteCachedDistanceMap(cached)) {
+        GateMessage("Volume", 1, "Distance map of <" << GetObjectName() << "> written to " << cached << Gateendl);
+      }
+      else {
+        GateWarning("Could not write the distance map " << cached
+                    << ", it will be computed again at the next start." << Gateendl);
+      }
+    }
+    if (!pDistanceMap->HasSameResolutionThan(GetImage())) {
+      GateError("Error distance map image does not have the same size than the image.\n");
+    }
+    GateMessageDec("Volume",3,"GateImageRegionalizedVolume::LoadDistanceMap("<<mDistanceMapFilename<<") - end\n");
     return;
   }
-  if (pDistanceMap) delete pDistanceMap;
-  pDistanceMap = new DistanceMapType;
   pDistanceMap->Read(mDistanceMapFilename);
 
   // Check size
@@ -213,6 +230,76 @@ void GateImageRegionalizedVolume::LoadDistanceMap()
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// The key is a hash (64 bits FNV-1a) of the labels and of the voxel size
+G4String GateImageRegionalizedVolume::GetCachedDistanceMapFilename()
+{
+  const G4double spacing[3] = { GetImage()->GetVoxelSize().x(),
+                                GetImage()->GetVoxelSize().y(),
+                                GetImage()->GetVoxelSize().z() };
+  const G4int resolution[3] = { (G4int)lrint(GetImage()->GetResolution().x()),
+                                (G4int)lrint(GetImage()->GetResolution().y()),
+                                (G4int)lrint(GetImage()->GetResolution().z()) };
+  unsigned long long h = GateSharedFile::UpdateKey(spacing, sizeof(spacing));
+  h = GateSharedFile::UpdateKey(resolution, sizeof(resolution), h);
+  const GateImage * image = GetImage();
+  h = GateSharedFile::UpdateKey(&(*image->begin()), image->GetNumberOfValues()*sizeof(*image->begin()), h);
+
+  G4String base = mImageFilename;
+  size_t dot = base.rfind('.');
+  size_t slash = base.rfind('/');
+  if (dot != G4String::npos && (slash == G4String::npos || dot > slash)) base = base.substr(0, dot);
+  return base + ".dmap-" + GateSharedFile::KeyToString(h) + ".mhd";
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// The map is written under a temporary name and renamed into place, the
+// raw data first and the header last: a concurrent job (which only looks
+// for the header) or a crash never leaves a partial map under the final name
+G4bool GateImageRegionalizedVolume::WriteCachedDistanceMap(const G4String & cached)
+{
+  const G4String base = cached.substr(0, cached.size() - 4);
+  std::ostringstream tmp;
+  tmp << base << ".tmp" << getpid();
+  const G4String tmpHeader = tmp.str() + ".mhd";
+  const G4String tmpRaw = tmp.str() + ".raw";
+  const G4String raw = base + ".raw";
+
+  // probe, the image writer does not report the errors
+  if (!std::ofstream(tmpHeader.c_str())) return false;
+  pDistanceMap->Write(tmpHeader);
+
+  // the header of the temporary map refers to its temporary raw file
+  std::ifstream is(tmpHeader.c_str());
+  std::ostringstream header;
+  std::string line;
+  G4bool hasData = false;
+  while (std::getline(is, line)) {
+    if (line.compare(0, 15, "ElementDataFile") == 0) {
+      line = "ElementDataFile = " + raw.substr(raw.rfind('/') + 1);
+      hasData = true;
+    }
+    header << line << "\n";
+  }
+  is.close();
+  std::remove(tmpHeader.c_str());
+
+  G4bool written = hasData && std::rename(tmpRaw.c_str(), raw.c_str()) == 0;
+  if (written) {
+    std::ofstream os(tmpHeader.c_str());
+    os << header.str();
+    os.close();
+    written = os && std::rename(tmpHeader.c_str(), cached.c_str()) == 0;
+  }
+  if (!written) {
+    std::remove(tmpHeader.c_str());
+    std::remove(tmpRaw.c_str());
+  }
+  return written;
+}
+//-----------------------------------------------------------------------------
+
 //------------------------------------------------
 // Methods used by SubVolumeSolids
 //------------------------------------------------
@@ -0,0 +1,62 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*! \file
+  \brief Implementation of GateImageRegionsParametrisation
+*/
+#include "GateImageRegionsParametrisation.hh"
+
+#include "G4Box.hh"
+#include "G4VPhysicalVolume.hh"
+
+//-----------------------------------------------------------------------------
+GateImageRegionsParametrisation::GateImageRegionsParametrisation(const std::vector<Region> & regions,
+                                                                 const std::vector<G4Material*> & label2Material,
+                                                                 const G4ThreeVector & resolution,
+                                                                 const G4ThreeVector & voxelSize)
+  : GatePVParameterisation(), mRegions(regions), mVectorLabel2Material(label2Material),
+    mVoxelSize(voxelSize)
+{
+  mCornerPosition = G4ThreeVector(-resolution.x()*voxelSize.x()/2.0,
+                                  -resolution.y()*voxelSize.y()/2.0,
+                                  -resolution.z()*voxelSize.z()/2.0);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageRegionsParametrisation::ComputeTransformation(const G4int copyNo, G4VPhysicalVolume * physVol) const
+{
+  const Region & r = mRegions[copyNo];
+  G4ThreeVector t(mCornerPosition.x() + (r.x + r.nx/2.0)*mVoxelSize.x(),
+                  mCornerPosition.y() + (r.y + r.ny/2.0)*mVoxelSize.y(),
+                  mCornerPosition.z() + (r.z + r.nz/2.0)*mVoxelSize.z());
+  physVol->SetTranslation(t);
+  physVol->SetRotation(0);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageRegionsParametrisation::ComputeDimensions(G4Box & box, const G4int copyNo, const G4VPhysicalVolume *) const
+{
+  const Region & r = mRegions[copyNo];
+  box.SetXHalfLength(r.nx*mVoxelSize.x()/2.0);
+  box.SetYHalfLength(r.ny*mVoxelSize.y()/2.0);
+  box.SetZHalfLength(r.nz*mVoxelSize.z()/2.0);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4Material* GateImageRegionsParametrisation::ComputeMaterial(const G4int copyNo, G4VPhysicalVolume *, const G4VTouchable *)
+{
+  return mVectorLabel2Material[mRegions[copyNo].label];
+}
+//-----------------------------------------------------------------------------
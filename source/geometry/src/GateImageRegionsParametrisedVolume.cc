@@ -0,0 +1,224 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*! /file
+  /brief Implementation of GateImageRegionsParametrisedVolume
+*/
+
+#include "G4PVParameterised.hh"
+#include "G4PVPlacement.hh"
+#include "G4Box.hh"
+
+#include "GateImageRegionsParametrisedVolumeMessenger.hh"
+#include "GateImageRegionsParametrisedVolume.hh"
+#include "GateDetectorConstruction.hh"
+#include "GateMultiSensitiveDetector.hh"
+#include "GateMiscFunctions.hh"
+#include "GateImageBox.hh"
+
+#include <map>
+#include <tuple>
+
+///---------------------------------------------------------------------------
+/// Constructor with :
+/// the path to the volume to create (for commands)
+/// the name of the volume to create
+/// Creates the messenger associated to the volume
+GateImageRegionsParametrisedVolume::GateImageRegionsParametrisedVolume(const G4String& name,
+								       G4bool acceptsChildren,
+								       G4int depth)
+  : GateVImageVolume(name,acceptsChildren,depth),
+    mImagePhysVol(0), mRegionSolid(0), mRegionLog(0), mRegionsParametrisation(0)
+{
+  GateMessageInc("Volume",5,"Begin GateImageRegionsParametrisedVolume("<<name<<")\n");
+  pMessenger = new GateImageRegionsParametrisedVolumeMessenger(this);
+  GateMessageDec("Volume",5,"End GateImageRegionsParametrisedVolume("<<name<<")\n");
+}
+///---------------------------------------------------------------------------
+
+
+///---------------------------------------------------------------------------
+/// Destructor
+GateImageRegionsParametrisedVolume::~GateImageRegionsParametrisedVolume()
+{
+  GateMessageInc("Volume",5,"Begin ~GateImageRegionsParametrisedVolume()\n");
+  if (pMessenger) delete pMessenger;
+
+  delete mImagePhysVol;
+  delete mRegionSolid;
+  delete mRegionLog;
+  delete mRegionsParametrisation;
+
+  GateMessageDec("Volume",5,"End ~GateImageRegionsParametrisedVolume()\n");
+}
+///---------------------------------------------------------------------------
+
+
+///---------------------------------------------------------------------------
+/// Constructs
+G4LogicalVolume* GateImageRegionsParametrisedVolume::ConstructOwnSolidAndLogicalVolume(G4Material* mater,
+										      G4bool /*flagUpdateOnly*/)
+{
+  GateMessageInc("Volume",3,"Begin GateImageRegionsParametrisedVolume::ConstructOwnSolidAndLogicalVolume()\n");
+  // Load image and material table (false = no additional border)
+  LoadImage(false);
+
+  if (mIsBoundingBoxOnlyModeEnabled) {
+    // Create few pixels
+    G4ThreeVector r(1,2,3);
+    G4ThreeVector s(GetImage()->GetSize().x()/1.0,
+                    GetImage()->GetSize().y()/2.0,
+                    GetImage()->GetSize().z()/3.0);
+    GetImage()->SetResolutionAndVoxelSize(r, s);
+  }
+
+  // Set position if IsoCenter is Set
+  UpdatePositionWithIsoCenter();
+
+  // Create the main volume (bounding box)
+  G4String boxname = GetObjectName() + "_solid";
+  pBoxSolid = new GateImageBox(*GetImage(), GetSolidName());
+  pBoxLog = new G4LogicalVolume(pBoxSolid, mater, GetLogicalVolumeName());
+
+  LoadImageMaterialsTable();
+
+  G4RotationMatrix *rotm = new G4RotationMatrix;
+  G4ThreeVector pos(0.,0.,0.);
+  pBoxPhys = new G4PVPlacement(rotm, pos, pBoxLog, boxname+"_phys", GetMotherLogicalVolume(), false, 1);
+
+  // Decompose the image into boxes of identical voxels
+  BuildLabelToG4MaterialVector(mVectorLabel2Material);
+  std::vector<Region> regions;
+  BuildRegions(regions);
+  GateMessage("Volume", 1, "Image " << GetImage()->GetNumberOfValues() << " voxels decomposed into "
+              << regions.size() << " homogeneous boxes\n");
+
+  // Volume of one box (the dimensions are set by the parametrisation,
+  // default material = Vacuum)
+  mRegionSolid = new G4Box(GetObjectName()+"_regionsolid",
+                           GetImage()->GetVoxelSize().x()/2.0,
+                           GetImage()->GetVoxelSize().y()/2.0,
+                           GetImage()->GetVoxelSize().z()/2.0);
+  G4Material * Vacuum = theMaterialDatabase.GetMaterial("Vacuum");
+  mRegionLog = new G4LogicalVolume(mRegionSolid, Vacuum, GetObjectName()+"_regionLog", 0,0,0);
+
+  mRegionsParametrisation = new GateImageRegionsParametrisation(regions, mVectorLabel2Material,
+                                                                GetImage()->GetResolution(),
+                                                                GetImage()->GetVoxelSize());
+
+  GateMessage("Volume", 4, "GateImageRegionsParametrisedVolume: create Physical Volume\n");
+  mImagePhysVol = new G4PVParameterised(GetObjectName() + "_physVol",
+                                        mRegionLog, // logical volume for a box
+                                        pBoxLog, // logical volume for the whole image
+                                        kUndefined,
+                                        mRegionsParametrisation->GetNbOfCopies(),
+                                        mRegionsParametrisation);
+
+  GateMessageDec("Volume",3,"End GateImageRegionsParametrisedVolume::ConstructOwnSolidAndLogicalVolume()\n");
+  // Return the logical volume (will be pOwnLog);
+  return pBoxLog;
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+// The runs of identical voxels of each row are merged with the identical
+// runs (same x extent and label) of the previous row, then the resulting
+// rectangles of each plane with the identical rectangles of the previous
+// plane.
+void GateImageRegionsParametrisedVolume::BuildRegions(std::vector<Region> & regions)
+{
+  const ImageType * image = GetImage();
+  const G4int nx = (G4int)lrint(image->GetResolution().x());
+  const G4int ny = (G4int)lrint(image->GetResolution().y());
+  const G4int nz = (G4int)lrint(image->GetResolution().z());
+
+  typedef std::pair<G4int,G4int> RunKey;                        // x, nx
+  typedef std::tuple<G4int,G4int,G4int,G4int> RectangleKey;     // x, nx, y, ny
+  std::map<RectangleKey,size_t> openBoxes, nextOpenBoxes;       // boxes ending on the previous plane
+  std::vector<Region> rectangles;
+
+  regions.clear();
+  for (G4int z=0; z<nz; z++) {
+    rectangles.clear();
+    std::map<RunKey,size_t> openRectangles, nextOpenRectangles; // rectangles ending on the previous row
+    for (G4int y=0; y<ny; y++) {
+      nextOpenRectangles.clear();
+      G4int x = 0;
+      while (x < nx) {
+        G4int label = (G4int)image->GetValue(x,y,z);
+        if (label < 0 || label >= (G4int)mVectorLabel2Material.size())
+          GateError("The label " << label << " of the voxel (" << x << "," << y << "," << z
+                    << ") has no material.\n");
+        G4int x2 = x+1;
+        while (x2 < nx && (G4int)image->GetValue(x2,y,z) == label) x2++;
+
+        RunKey key(x, x2-x);
+        std::map<RunKey,size_t>::iterator it = openRectangles.find(key);
+        if (it != openRectangles.end() && rectangles[it->second].label == label) {
+          rectangles[it->second].ny++;
+          nextOpenRectangles[key] = it->second;
+        }
+        else {
+          Region r = { x, y, z, x2-x, 1, 1, label };
+          rectangles.push_back(r);
+          nextOpenRectangles[key] = rectangles.size()-1;
+        }
+        x = x2;
+      }
+      openRectangles.swap(nextOpenRectangles);
+    }
+
+    nextOpenBoxes.clear();
+    for (size_t i=0; i<rectangles.size(); i++) {
+      const Region & r = rectangles[i];
+      RectangleKey key(r.x, r.nx, r.y, r.ny);
+      std::map<RectangleKey,size_t>::iterator it = openBoxes.find(key);
+      if (it != openBoxes.end() && regions[it->second].label == r.label) {
+        regions[it->second].nz++;
+        nextOpenBoxes[key] = it->second;
+      }
+      else {
+        regions.push_back(r);
+        nextOpenBoxes[key] = regions.size()-1;
+      }
+    }
+    openBoxes.swap(nextOpenBoxes);
+  }
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+void GateImageRegionsParametrisedVolume::PrintInfo()
+{
+  GateMessage("Actor", 1, "GateImageRegionsParametrisedVolume Actor \n");
+  GateVImageVolume::PrintInfo();
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+void GateImageRegionsParametrisedVolume::PropagateGlobalSensitiveDetector()
+{
+  if (m_sensitiveDetector) {
+    GatePhantomSD* phantomSD = GateDetectorConstruction::GetGateDetectorConstruction()->GetPhantomSD();
+    mRegionLog->SetSensitiveDetector(phantomSD);
+  }
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+void GateImageRegionsParametrisedVolume::PropagateSensitiveDetectorToChild(GateMultiSensitiveDetector * msd)
+{
+  GateDebugMessage("Volume", 5, "Add SD to child\n");
+  mRegionLog->SetSensitiveDetector(msd);
+}
+//---------------------------------------------------------------------------
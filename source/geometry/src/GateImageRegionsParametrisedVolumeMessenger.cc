@@ -0,0 +1,45 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*! \file
+  \brief Implementation of GateImageRegionsParametrisedVolumeMessenger
+*/
+#include "GateImageRegionsParametrisedVolumeMessenger.hh"
+#include "GateImageRegionsParametrisedVolume.hh"
+
+#include "G4UIcommand.hh"
+
+//-----------------------------------------------------------------------------
+GateImageRegionsParametrisedVolumeMessenger::GateImageRegionsParametrisedVolumeMessenger(GateImageRegionsParametrisedVolume* volume)
+  :GateVImageVolumeMessenger(volume)
+{
+  GateMessageInc("Volume",6,"Begin GateImageRegionsParametrisedVolumeMessenger()\n");
+  GateMessageDec("Volume",6,"End GateImageRegionsParametrisedVolumeMessenger()\n");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateImageRegionsParametrisedVolumeMessenger::~GateImageRegionsParametrisedVolumeMessenger()
+{
+  GateMessageInc("Volume",6,"Begin ~GateImageRegionsParametrisedVolumeMessenger()\n");
+  GateMessageDec("Volume",6,"End ~GateImageRegionsParametrisedVolumeMessenger()\n");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageRegionsParametrisedVolumeMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  GateMessage("Volume",6,"GateImageRegionsParametrisedVolumeMessenger::SetNewValue "
+              << command->GetCommandPath()
+	      << " newValue=" << newValue << Gateendl);
+  GateVImageVolumeMessenger::SetNewValue(command,newValue);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,29 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#include "GateImageRegularParametrisation.hh"
+
+//-----------------------------------------------------------------------------
+GateImageRegularParametrisation::GateImageRegularParametrisation(const GateImageLabels * labels,
+                                                                 const std::vector<G4Material*> & materials)
+  : G4PhantomParameterisation(), pLabels(labels), mLabel2Material(materials)
+{
+  SetMaterials(mLabel2Material);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4Material* GateImageRegularParametrisation::ComputeMaterial(const G4int copyNo,
+                                                             G4VPhysicalVolume*,
+                                                             const G4VTouchable*)
+{
+  return mLabel2Material[pLabels->GetLabel(copyNo)];
+}
+//-----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
 #include "GateImageRegularParametrisedVolume.hh"
 #include "GateDetectorConstruction.hh"
 #include "GateImageNestedParametrisation.hh"
+#include "GateImageRegularParametrisation.hh"
 #include "GateMultiSensitiveDetector.hh"
 #include "GateMiscFunctions.hh"
 #include "GateImageBox.hh"
@@ -34,7 +35,7 @@
 GateImageRegularParametrisedVolume::GateImageRegularParametrisedVolume(const G4String& name,
 								     G4bool acceptsChildren,
 								     G4int depth)
-  : GateVImageVolume(name,acceptsChildren,depth)
+  : GateVImageVolume(name,acceptsChildren,depth), mImageData(0)
 {
   GateMessageInc("Volume",5,"Begin GateImageRegularParametrisedVolume("<<name<<")\n");
   pMessenger = new GateImageRegularParametrisedVolumeMessenger(this);
@@ -54,7 +55,7 @@ GateImageRegularParametrisedVolume::~GateImageRegularParametrisedVolume()
   delete mImagePhysVol;
   delete mVoxelSolid;
   delete mVoxelLog;
-  delete mImageData;
+  delete [] mImageData;
 
   GateMessageDec("Volume",5,"End ~GateImageRegularParametrisedVolume()\n");
 }
@@ -119,22 +120,25 @@ G4LogicalVolume* GateImageRegularParametrisedVolume::ConstructOwnSolidAndLogical
     theMaterialDatabase.GetMaterial("Vacuum");
   mVoxelLog = new G4LogicalVolume(mVoxelSolid, Vacuum, GetObjectName()+"_voxelLog", 0,0,0);
 
-  // Create the main Parametrisation
-  G4PhantomParameterisation* param = new G4PhantomParameterisation();
+  // Create the main Parametrisation. The materials are read from a compact
+  // copy of the labels (1 or 2 bytes per voxel for usual images).
+  BuildLabelToG4MaterialVector(mVectorLabel2Material);
+  mLabels.Build(*GetImage(), mVectorLabel2Material.size());
+  GateImageRegularParametrisation* param = new GateImageRegularParametrisation(&mLabels, mVectorLabel2Material);
   param->SetVoxelDimensions(GetImage()->GetVoxelSize().x()/2.0,
                             GetImage()->GetVoxelSize().y()/2.0,
                             GetImage()->GetVoxelSize().z()/2.0);
   param->SetNoVoxel(GetImage()->GetResolution().x(),
                     GetImage()->GetResolution().y(),
                     GetImage()->GetResolution().z());
-  BuildLabelToG4MaterialVector(mVectorLabel2Material);
-  param->SetMaterials(mVectorLabel2Material);
-  // Convert image voxel into size_t type.
-  mImageData = new size_t[GetImage()->GetNumberOfValues()];
-  for(int i=0; i<GetImage()->GetNumberOfValues(); i++) {
-    mImageData[i] = GetImage()->GetValue(i);
+  // Geant4 reads the size_t indices directly when skipping equal materials
+  if (mSkipEqualMaterialsFlag) {
+    mImageData = new size_t[GetImage()->GetNumberOfValues()];
+    for(int i=0; i<GetImage()->GetNumberOfValues(); i++) {
+      mImageData[i] = GetImage()->GetValue(i);
+    }
+    param->SetMaterialIndices(mImageData);
   }
-  param->SetMaterialIndices(mImageData);
   param->SetSkipEqualMaterials(mSkipEqualMaterialsFlag);
   param->BuildContainerSolid(pBoxPhys);
 
@@ -148,6 +152,9 @@ G4LogicalVolume* GateImageRegularParametrisedVolume::ConstructOwnSolidAndLogical
                                    param); // parametrisation
   mImagePhysVol->SetRegularStructureId(1);
 
+  // The materials are read from the labels (and the indices)
+  ReleaseImageData();
+
   // Return the logical volume (will be pOwnLog);
   return pBoxLog;
 }
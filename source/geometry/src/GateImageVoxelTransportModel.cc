@@ -0,0 +1,351 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+/*! \file
+  \brief Implementation of GateImageVoxelTransportModel
+*/
+
+#include "GateImageVoxelTransportModel.hh"
+#include "GateImageNestedParametrisation.hh"
+#include "GateMessageManager.hh"
+#include "GateObjectStore.hh"
+#include "GateVVolume.hh"
+#include "GateActorManager.hh"
+#include "GateDoseActor.hh"
+
+#include "G4FastSimulationManager.hh"
+#include "G4FastSimulationManagerProcess.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4VEmProcess.hh"
+#include "G4Gamma.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4LogicalVolume.hh"
+
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+#include <set>
+
+G4int GateImageVoxelTransportModel::mNumberOfModels = 0;
+
+static const G4String gProcessName = "ImageVoxelTransport";
+
+//-----------------------------------------------------------------------------
+// An actor that sees the photon steps or tracks in the image is compatible
+// only if it is known to give the same result with long steps without
+// interaction. The others depend on the step length or on the steps (track
+// length, counts) or see the tracking actions called again after each fast
+// step. The dose actor scores the photons at the post-step point, i.e. at
+// the interactions, and only reads the particle type at the start of a track.
+static bool IsCompatibleActor(GateVActor * actor)
+{
+  if (dynamic_cast<GateDoseActor*>(actor)) return true;
+  return !actor->IsPreUserTrackingActionEnabled() &&
+    !actor->IsPostUserTrackingActionEnabled() &&
+    !actor->IsUserSteppingActionEnabled();
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+GateImageVoxelTransportModel::GateImageVoxelTransportModel(const G4String & name)
+  : G4VFastSimulationModel(name)
+{
+  pRegion = 0;
+  pEnvelopeLog = 0;
+  pParametrisation = 0;
+  mMaxOpticalDepth = 1.0;
+  mIsInitialized = false;
+  mIsEnabled = false;
+  mStamp = 0;
+  mLambdaEnergy = -1;
+  pLastTrack = 0;
+  mLastTrackID = -1;
+  mLastEnergy = -1;
+  mStopDistance = 0;
+  mNumberOfModels++;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateImageVoxelTransportModel::~GateImageVoxelTransportModel()
+{
+  mNumberOfModels--;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageVoxelTransportModel::SetImage(G4Region * region,
+                                            G4LogicalVolume * envelopeLog,
+                                            const GateImageNestedParametrisation * param,
+                                            const G4ThreeVector & resolution,
+                                            const G4ThreeVector & voxelSize)
+{
+  // The regions are rebuilt with the geometry, the model is then added
+  // to the new one
+  if (region != pRegion) {
+    G4FastSimulationManager * manager = region->GetFastSimulationManager();
+    if (!manager) manager = new G4FastSimulationManager(region, false);
+    manager->AddFastSimulationModel(this);
+    pRegion = region;
+  }
+  pEnvelopeLog = envelopeLog;
+  pParametrisation = param;
+  for (int a=0; a<3; a++) {
+    mResolution[a] = (G4int)lrint(resolution[a]);
+    mVoxelSize[a] = voxelSize[a];
+    mHalfSize[a] = mResolution[a]*mVoxelSize[a]/2.0;
+  }
+  mIsInitialized = false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageVoxelTransportModel::ConstructProcess()
+{
+  if (mNumberOfModels == 0) return;
+  G4ProcessManager * manager = G4Gamma::Gamma()->GetProcessManager();
+  if (manager->GetProcess(gProcessName)) return;
+  // Ordered first for the DoIt, hence last for the GPIL: the interaction
+  // lengths of the other processes are updated when the model is triggered
+  manager->AddDiscreteProcess(new G4FastSimulationManagerProcess(gProcessName), 0);
+  GateMessage("Physic", 1, "Fast photon transport in the images enabled" << Gateendl);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateImageVoxelTransportModel::IsApplicable(const G4ParticleDefinition & particle)
+{
+  return (&particle == G4Gamma::Gamma());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageVoxelTransportModel::Initialize()
+{
+  mIsInitialized = true;
+  mIsEnabled = false;
+  mProcesses.clear();
+  mCouples.clear();
+
+  if (pEnvelopeLog->GetNoDaughters() != 1) {
+    GateWarning("The image in region " << pRegion->GetName()
+                << " has daughter volumes, the fast photon transport is disabled" << Gateendl);
+    return;
+  }
+
+  // Actors recording the steps in the image: attached to it, to one of
+  // its mothers or to no volume
+  std::set<G4String> volumes;
+  volumes.insert("");
+  GateVVolume * volume = GateObjectStore::GetInstance()->FindVolumeCreator(pRegion->GetName());
+  while (volume) {
+    volumes.insert(volume->GetObjectName());
+    volume = volume->GetMotherCreator();
+  }
+  std::vector<GateVActor*> & actors = GateActorManager::GetInstance()->GetTheListOfActors();
+  for (size_t i=0; i<actors.size(); i++) {
+    if (volumes.count(actors[i]->GetVolumeName()) && !IsCompatibleActor(actors[i])) {
+      GateWarning("The actor " << actors[i]->GetObjectName()
+                  << " may depend on the photon steps or tracks in the image " << pRegion->GetName()
+                  << ", the fast photon transport is disabled" << Gateendl);
+      return;
+    }
+  }
+
+  // Discrete processes of the gammas
+  G4ProcessManager * manager = G4Gamma::Gamma()->GetProcessManager();
+  G4ProcessVector * processes = manager->GetPostStepProcessVector(typeDoIt);
+  G4int nProcesses = (G4int)processes->entries();
+  for (G4int i=0; i<nProcesses; i++) {
+    G4VProcess * process = (*processes)[i];
+    if (!manager->GetProcessActivation(process)) continue;
+    // transportation, fast simulation and step limiters
+    G4ProcessType type = process->GetProcessType();
+    if (type == fTransportation || type == fParameterisation || type == fGeneral) continue;
+    G4VEmProcess * em = dynamic_cast<G4VEmProcess*>(process);
+    if (!em) {
+      GateWarning("The gamma process " << process->GetProcessName()
+                  << " is not electromagnetic, the fast photon transport is disabled" << Gateendl);
+      mProcesses.clear();
+      return;
+    }
+    mProcesses.push_back(em);
+  }
+  if (mProcesses.empty()) return;
+
+  // Material-cuts couples of the labels
+  G4ProductionCutsTable * table = G4ProductionCutsTable::GetProductionCutsTable();
+  G4int nLabels = pParametrisation->GetNumberOfMaterials();
+  for (G4int l=0; l<nLabels; l++) {
+    const G4MaterialCutsCouple * couple =
+      table->GetMaterialCutsCouple(pParametrisation->GetMaterial(l), pRegion->GetProductionCuts());
+    if (!couple) {
+      GateWarning("No cuts for the material " << pParametrisation->GetMaterial(l)->GetName()
+                  << " in region " << pRegion->GetName()
+                  << ", the fast photon transport is disabled" << Gateendl);
+      return;
+    }
+    mCouples.push_back(couple);
+  }
+
+  mLambda.assign(nLabels*mProcesses.size(), 0.0);
+  mLambdaStamp.assign(nLabels, 0);
+  mLengthLeft.resize(mProcesses.size());
+  mStamp = 1;
+  mLambdaEnergy = -1;
+  pLastTrack = 0;
+  mIsEnabled = true;
+  GateMessage("Geometry", 1, "Fast photon transport in region " << pRegion->GetName()
+              << " with " << mProcesses.size() << " processes and " << nLabels << " materials" << Gateendl);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const G4double * GateImageVoxelTransportModel::GetLambda(G4int label)
+{
+  G4double * lambda = &mLambda[label*mProcesses.size()];
+  if (mLambdaStamp[label] != mStamp) {
+    for (size_t p=0; p<mProcesses.size(); p++)
+      lambda[p] = mProcesses[p]->GetLambda(mLambdaEnergy, mCouples[label]);
+    mLambdaStamp[label] = mStamp;
+  }
+  return lambda;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateImageVoxelTransportModel::Refuse(const G4Track * track)
+{
+  pLastTrack = track;
+  mLastTrackID = track->GetTrackID();
+  mLastEnergy = track->GetKineticEnergy();
+  mLastDirection = track->GetMomentumDirection();
+  return false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateImageVoxelTransportModel::ModelTrigger(const G4FastTrack & fastTrack)
+{
+  if (!mIsInitialized) Initialize();
+  if (!mIsEnabled) return false;
+
+  const G4Track * track = fastTrack.GetPrimaryTrack();
+  const G4double energy = track->GetKineticEnergy();
+
+  // Same flight as the last refused one: the photon interacts before the
+  // stopping point, it is left to Geant4 until then
+  if (track == pLastTrack && track->GetTrackID() == mLastTrackID &&
+      energy == mLastEnergy && track->GetMomentumDirection() == mLastDirection) return false;
+  pLastTrack = 0;
+
+  if (energy != mLambdaEnergy) {
+    mLambdaEnergy = energy;
+    mStamp++;
+  }
+  for (size_t p=0; p<mProcesses.size(); p++)
+    mLengthLeft[p] = mProcesses[p]->GetNumberOfInteractionLengthLeft();
+
+  // Initial voxel and distances to the next boundaries along each axis
+  const G4ThreeVector position = fastTrack.GetPrimaryTrackLocalPosition();
+  const G4ThreeVector direction = fastTrack.GetPrimaryTrackLocalDirection();
+  G4int index[3], step[3];
+  G4double tMax[3], tDelta[3];
+  for (int a=0; a<3; a++) {
+    G4double x = position[a] + mHalfSize[a];
+    index[a] = (G4int)std::floor(x/mVoxelSize[a]);
+    if (index[a] < 0) index[a] = 0;
+    if (index[a] >= mResolution[a]) index[a] = mResolution[a]-1;
+    if (direction[a] > 0) {
+      step[a] = 1;
+      tMax[a] = ((index[a]+1)*mVoxelSize[a] - x)/direction[a];
+      tDelta[a] = mVoxelSize[a]/direction[a];
+    }
+    else if (direction[a] < 0) {
+      step[a] = -1;
+      tMax[a] = (index[a]*mVoxelSize[a] - x)/direction[a];
+      tDelta[a] = -mVoxelSize[a]/direction[a];
+    }
+    else {
+      step[a] = 0;
+      tMax[a] = DBL_MAX;
+      tDelta[a] = DBL_MAX;
+    }
+  }
+
+  const GateImageLabels & labels = pParametrisation->GetLabels();
+  const size_t nProcesses = mProcesses.size();
+  G4double t = 0;
+  G4double depth = 0;
+  while (true) {
+    int a = (tMax[0] < tMax[1]) ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+    G4double end = tMax[a];
+    const G4double * lambda = GetLambda(labels.GetLabel(index[0], index[1], index[2]));
+    G4double total = 0;
+    for (size_t p=0; p<nProcesses; p++) total += lambda[p];
+
+    // Stops inside the voxel if the optical depth reaches its maximum
+    G4bool last = false;
+    if (mMaxOpticalDepth > 0 && total > 0 && depth + total*(end-t) >= mMaxOpticalDepth) {
+      end = t + (mMaxOpticalDepth - depth)/total;
+      last = true;
+    }
+    G4double length = std::max(end - t, 0.0);
+
+    for (size_t p=0; p<nProcesses; p++) {
+      if (lambda[p] <= 0) continue;
+      // not sampled yet, the process samples its length in this voxel
+      if (mLengthLeft[p] < 0) return Refuse(track);
+      mLengthLeft[p] -= lambda[p]*length;
+      if (mLengthLeft[p] <= 0) return Refuse(track);
+    }
+    depth += total*length;
+    t = std::max(end, t);
+    if (last) break;
+
+    index[a] += step[a];
+    if (index[a] < 0 || index[a] >= mResolution[a]) break;
+    tMax[a] += tDelta[a];
+  }
+
+  if (t <= 0) return false;
+  mStopDistance = t;
+  mStopPosition = position + t*direction;
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageVoxelTransportModel::DoIt(const G4FastTrack & fastTrack, G4FastStep & fastStep)
+{
+  const G4Track * track = fastTrack.GetPrimaryTrack();
+  fastStep.ProposePrimaryTrackFinalPosition(mStopPosition);
+  fastStep.ProposePrimaryTrackPathLength(mStopDistance);
+  fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + mStopDistance/track->GetVelocity());
+
+  // The photon survived up to the stopping point: new interaction lengths
+  // are sampled, as at the start of a track (Geant4 also suspends the
+  // track after a fast step, which restarts it)
+  for (size_t p=0; p<mProcesses.size(); p++)
+    mProcesses[p]->StartTracking(const_cast<G4Track*>(track));
+}
+//-----------------------------------------------------------------------------
@@ -28,12 +28,11 @@ char GateMDBFile::theStarterSeparator = ':';
 char GateMDBFile::theFieldSeparator   = ';';
 G4String GateMDBFile::theReadItemErrorMsg = "Item not found";
 
-#define GATE_BUFFERSIZE 256
-
 //-----------------------------------------------------------------------------
 GateMDBFile::GateMDBFile(GateMaterialDatabase* db, const G4String& itsFileName)
   :mDatabase(db), 
-   fileName(itsFileName),filePath("")
+   fileName(itsFileName),filePath(""),
+   mCurrentLine(0)
 {
   GateMessage("Materials", 1, 
 	      "GateMDBFile: I start looking for the material database file <"
@@ -44,7 +43,7 @@ GateMDBFile::GateMDBFile(GateMaterialDatabase* db, const G4String& itsFileName)
 		G4String msg = "Could not find material database file '" + fileName + "'";
     G4Exception( "GateMDBFile::GateMDBFile", "GateMDBFile", FatalException, msg );
 	}
-  dbStream.open(filePath);
+  std::ifstream dbStream(filePath);
 
   if (dbStream) {
     GateMessage("Materials", 2, 
@@ -55,6 +54,11 @@ GateMDBFile::GateMDBFile(GateMaterialDatabase* db, const G4String& itsFileName)
 		G4String msg = "Could not open material database file '" + filePath + "'";
     G4Exception( "GateMDBFile::GateMDBFile", "GateMDBFile", FatalException, msg );
   }
+
+  std::string line;
+  while (std::getline(dbStream,line))
+    mLines.push_back(line);
+  LoadFile();
 }
 //-----------------------------------------------------------------------------
 
@@ -63,7 +67,6 @@ GateMDBFile::GateMDBFile(GateMaterialDatabase* db, const G4String& itsFileName)
 //-----------------------------------------------------------------------------
 GateMDBFile::~GateMDBFile()
 {
-  dbStream.close();
 }
 //-----------------------------------------------------------------------------
 
@@ -541,8 +544,43 @@ void GateMDBFile::ReadMaterialOption(const G4String& materialName,const G4String
 
 
 //-----------------------------------------------------------------------------
-// Go through the whole file until we find a specific section
-// The section name we'll look for is "[name]"
+// Indexes the sections and their items. As with a sequential lookup, a section
+// is the first line starting with "[name]", an item is the first line starting
+// with "Item:" in this section, and a section ends at the next line starting with '['
+void GateMDBFile::LoadFile()
+{
+  G4String lineBuf;
+  for (size_t i=0; i<mLines.size(); ++i) {
+    const G4String& line = mLines[i];
+    if (line.empty() || line[0]!='[') continue;
+    size_t end = line.find(']');
+    if (end == G4String::npos) continue;
+    G4String sectionName = line.substr(1,end-1);
+    if (mSectionLine.find(sectionName)!=mSectionLine.end()) continue;
+    mSectionLine[sectionName] = i+1;
+
+    std::map<G4String,size_t>& items = mItemLine[sectionName];
+    for (size_t j=i+1; j<mLines.size(); ++j) {
+      lineBuf = mLines[j];
+      GateTokenizer::CleanUpString(lineBuf);
+      if (lineBuf=="") continue;
+      if (lineBuf.at(0)=='[') break;
+      size_t colon = lineBuf.find(':');
+      if (colon == G4String::npos) continue;
+      G4String itemName = lineBuf.substr(0,colon);
+      if (items.find(itemName)==items.end())
+        items[itemName] = j;
+    }
+  }
+
+  GateMessage("Materials", 2, "GateMDBFile<" << fileName << ">: "
+	      << mLines.size() << " lines, " << mSectionLine.size() << " sections indexed\n");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Positions the reading just below the header "[name]" of a section
 void GateMDBFile::FindSection(const G4String& name)
 {
   if (LookForText("[" + name + "]")==false) {
@@ -557,72 +595,38 @@ void GateMDBFile::FindSection(const G4String& name)
 
 
 //-----------------------------------------------------------------------------
-// Go through the whole DB file from the start
-// until we find a specific text (at beginning of line)
-// Once the text is found, we're positioned just below the text's line
+// Finds a section header "[name]" in the index
+// Once the text is found, we're positioned just below the text's line,
+// otherwise at the end of the file
 G4bool GateMDBFile::LookForText(const G4String& text)
 {
-  G4int len = text.length() ;
-  G4String lineBuf;
-
-  if (dbStream.fail()) {
-    dbStream.close();
-    dbStream.clear();  
-    dbStream.open(fileName);
-    if (!dbStream) {
-      std::cerr << "ERROR Could not reopen " << fileName << Gateendl;
-      exit(0);
-    }
-  }
-
-  dbStream.seekg(0,std::ios::beg);  // Rewind!
-  
+  std::map<G4String,size_t>::const_iterator it = mSectionLine.end();
+  if (text.size()>2 && text[0]=='[' && text[text.size()-1]==']')
+    it = mSectionLine.find(text.substr(1,text.size()-2));
 
-  while (!dbStream.eof()) {
-    if (ReadLine(lineBuf)) return false; // Error or EOF
-   
-    if ( strncmp(text.c_str(),lineBuf.c_str(),len)==0 )
-      return true;// Line starts with the text we're looking for
+  if (it == mSectionLine.end()) {
+    mCurrentLine = mLines.size();
+    return false;
   }
-  return false;
+  mCurrentLine = it->second;
+  return true;
 }
 //-----------------------------------------------------------------------------
 
 
 
 //-----------------------------------------------------------------------------
-// Goes into a specific section of the DB file, then looks
-// for a specific item.
-// If the item is "Item", the routine will look through the
-// sectoin until it finds a line starting with "Item:"
+// Finds a specific item of a specific section in the index
+// If the item is "Item", it's the first line of the section starting with "Item:"
+// The next lines (e.g. the components of a material) are then read from this line
 G4String GateMDBFile::ReadItem(const G4String& sectionName,const G4String& itemName)
 {
-
-  
   // Go in the relevant section of the DB file
   FindSection(sectionName);
-  
-  // Prepare the lookup variables and buffer
-  G4bool flagElementFound=false;
-  G4String text = itemName + ":" ;
-  G4int len = text.length() ;
-  G4String lineBuf;
-  
-   
-  do {	// Read lines until we find the item or reach the OEF or the next section
-    if (ReadNonEmptyLine(lineBuf)) 
-      break;   // Reached EOF or read-error
-    if (lineBuf.at(0)=='[') 
-      break; // Reached next section
-    //if ( text.compare(lineBuf,0,len) == 0 ) {
-    if ( strncmp(text.c_str(),lineBuf.c_str(),len) == 0 ) {
-      // We found the item we were looking for  
-      flagElementFound = true;
-      break;
-    }
-  } while (1);
 
-  if (!flagElementFound) {  // We reached the EOF or the next section
+  std::map<G4String,std::map<G4String,size_t> >::const_iterator section = mItemLine.find(sectionName);
+  std::map<G4String,size_t>::const_iterator item;
+  if (section == mItemLine.end() || (item = section->second.find(itemName)) == section->second.end()) {
     // GateMessage("Materials", 3, "GateMDBFile<" << fileName
     // 		<< ">::ReadItem: I could NOT find the item '"
     // 		<< itemName << "' in section ["
@@ -630,13 +634,17 @@ G4String GateMDBFile::ReadItem(const G4String& sectionName,const G4String& itemN
     return theReadItemErrorMsg;
   }
 
+  G4String lineBuf = mLines[item->second];
+  GateTokenizer::CleanUpString(lineBuf);
+  mCurrentLine = item->second+1;
+
   GateMessage("Materials", 2, "GateMDBFile<" << fileName
 	      << ">::ReadItem: I find the item '"
 	      << itemName << "' in section ["
 	      << sectionName << "] of the material database. \n\n");
 
   // We found the item: we return the text after the colon
-  return lineBuf.substr(len);
+  return lineBuf.substr(itemName.length()+1);
 }
 //-----------------------------------------------------------------------------
 
@@ -665,14 +673,9 @@ G4int GateMDBFile::ReadNonEmptyLine(G4String& lineBuffer)
 // Returns 0 if everything went OK, 1 if there was any failure (including EOF) 
 G4int GateMDBFile::ReadLine(G4String& lineBuffer)
 {
-  static char buffer[GATE_BUFFERSIZE];
-
-  dbStream.getline(buffer,GATE_BUFFERSIZE);
-  if (dbStream.eof())  
+  if (mCurrentLine >= mLines.size())
     return 1;
-  lineBuffer = G4String(buffer);
+  lineBuffer = mLines[mCurrentLine++];
   return 0;
 }
 //-----------------------------------------------------------------------------
-
-
@@ -12,6 +12,7 @@
 #include "GateMaterialDatabase.hh"
 #include "GateMessageManager.hh"
 #include "GateMDBFile.hh"
+#include "GateProfiler.hh"
 
 #include "GateConfiguration.h"
 
@@ -40,6 +41,7 @@ GateMaterialDatabase::~GateMaterialDatabase()
 //-----------------------------------------------------------------------------
 void GateMaterialDatabase::AddMDBFile(const G4String& filename)
 {
+  GateProfilerPhase phase("materialDatabase:" + filename);
   mMDBFile.push_back(new GateMDBFile(this,filename));
   GateMessage("Materials",1, "New material database added - Number of files: "<<mMDBFile.size() << Gateendl);	  
 }
@@ -15,6 +15,7 @@
 #define GATESDM_CC
 
 #include "GateMultiSensitiveDetector.hh"
+#include "GateActorManager.hh"
 
 //-----------------------------------------------------------------------------
 GateMultiSensitiveDetector::GateMultiSensitiveDetector(G4String name)
@@ -77,10 +78,12 @@ void GateMultiSensitiveDetector::PrintAll()
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-G4bool GateMultiSensitiveDetector::ProcessHits(G4Step* aStep, G4TouchableHistory*)
+G4bool GateMultiSensitiveDetector::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist)
 {
   if(pSensitiveDetector) pSensitiveDetector->Hit(aStep);
-  if(pMultiFunctionalDetector) pMultiFunctionalDetector->Hit(aStep);
+  // the actors are called by the actor manager rather than through the
+  // G4MultiFunctionalDetector, which only keeps them registered
+  if(!theListOfActors.empty()) GateActorManager::GetInstance()->VolumeSteppingAction(this, aStep, ROhist);
   return true;
 }
 //-----------------------------------------------------------------------------
@@ -101,6 +104,7 @@ void GateMultiSensitiveDetector::SetActor(GateVActor * actor)
   if(actor->GetNumberOfFilters()!=0)
     actor->SetFilter(actor->GetFilterManager());
   pMultiFunctionalDetector ->RegisterPrimitive(actor);
+  theListOfActors.push_back(actor);
 }
 //-----------------------------------------------------------------------------
 
@@ -14,6 +14,7 @@
 
 #include <pthread.h>
 #include <set>
+#include <thread>
 
 #include "GateVImageVolume.hh"
 #include "GateMiscFunctions.hh"
@@ -23,6 +24,8 @@
 #include "GateDMaplongvol.h"
 #include "GateDMapdt.h"
 #include "GateHounsfieldMaterialTable.hh"
+#include "GateImageLabels.hh"
+#include "GateProfiler.hh"
 #include <G4TransportationManager.hh>
 #include "globals.hh"
 
@@ -39,6 +42,7 @@ GateVImageVolume::GateVImageVolume( const G4String& name,G4bool acceptsChildren,
   GateMessageInc("Volume",5,"Begin GateVImageVolume("<<name<<")\n");
   mImageFilename="";
   pImage=0;
+  mImageDataReleased = false;
   mHalfSize = G4ThreeVector(0,0,0);
   mIsoCenterIsSetByUser = false;
   mIsoCenterRotationFlag = false;
@@ -214,8 +218,10 @@ void GateVImageVolume::SetRangeMaterialTableFilename(const G4String& name)
 void GateVImageVolume::LoadImage(bool add1VoxelMargin)
 {
   GateMessageInc("Volume",4,"Begin GateVImageVolume::LoadImage("<<mImageFilename<<")\n");
+  GateProfilerPhase phase("image:" + mImageFilename);
 
   ImageType* tmp = new ImageType;
+  mImageDataReleased = false;
 
   if (mImageFilename == "test1" ) {
     // Creates a 32x32x32 image of size 20x20x20 cm3
@@ -318,6 +324,7 @@ void GateVImageVolume::LoadImage(bool add1VoxelMargin)
 void GateVImageVolume::LoadImageMaterialsTable()
 {
   GateMessageInc("Volume",4,"Begin GateVImageVolume::LoadImageMaterialsTable("<<mImageFilename<<")\n");
+  GateProfilerPhase phase("imageMaterials:" + mImageFilename);
 
   if (mLoadImageMaterialsFromHounsfieldTable) {
     LoadImageMaterialsFromHounsfieldTable();
@@ -488,6 +495,7 @@ void GateVImageVolume::LoadImageMaterialsFromHounsfieldTable() {
 void GateVImageVolume::DumpHLabelImage() {
   // Dump image if needed
   if (mWriteHLabelImage) {
+    if (mImageDataReleased) RestoreImageData();
     ImageType output;
     output.SetResolutionAndVoxelSize(pImage->GetResolution(), pImage->GetVoxelSize());
     output.SetOrigin(pImage->GetOrigin());
@@ -524,6 +532,7 @@ void GateVImageVolume::DumpHLabelImage() {
 void GateVImageVolume::DumpDensityImage() {
   // Dump image if needed
   if (mWriteDensityImage) {
+    if (mImageDataReleased) RestoreImageData();
     ImageType output;
     output.SetResolutionAndVoxelSize(pImage->GetResolution(), pImage->GetVoxelSize());
     output.SetOrigin(pImage->GetOrigin());
@@ -561,6 +570,7 @@ void GateVImageVolume::DumpDensityImage() {
 void GateVImageVolume::DumpMassImage() {
   // Dump image if needed
   if (mMassImageFilename != "none") {
+    if (mImageDataReleased) RestoreImageData();
     ImageType output;
     output.SetResolutionAndVoxelSize(pImage->GetResolution(), pImage->GetVoxelSize());
     output.SetOrigin(pImage->GetOrigin());
@@ -872,6 +882,40 @@ void GateVImageVolume::PrintInfo()
 //--------------------------------------------------------------------
 
 
+//--------------------------------------------------------------------
+// The float image is a second copy of the labels (4 bytes per voxel):
+// it is freed once the parametrisation reads the labels
+void GateVImageVolume::ReleaseImageData()
+{
+  const GateImageLabels * labels = GetLabels();
+  if (!pImage || !labels || labels->GetNumberOfValues() != (size_t)pImage->GetNumberOfValues()) return;
+  long rss = GateProfiler::GetCurrentRSS();
+  pImage->ReleaseData();
+  mImageDataReleased = true;
+  // the labels may be mapped from a file shared by the processes of the
+  // node (see GateImageLabels): the process then keeps no copy of the voxels
+  GateMessage("Volume", 1, "Image " << mImageFilename << ": "
+              << labels->GetNumberOfValues()*sizeof(float)/1024 << " kB of float values released, the materials are read from "
+              << labels->GetNumberOfValues()*labels->GetBytesPerLabel()/1024 << " kB of labels"
+              << (labels->IsShared() ? " (shared)" : "")
+              << ", process RSS " << rss/1024 << " MB -> " << GateProfiler::GetCurrentRSS()/1024 << " MB" << Gateendl);
+}
+//--------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------
+void GateVImageVolume::RestoreImageData() const
+{
+  mImageDataReleased = false;
+  const GateImageLabels * labels = GetLabels();
+  pImage->Allocate();
+  for (int i=0; i<pImage->GetNumberOfValues(); i++)
+    pImage->SetValue(i, labels->GetLabel(i));
+  GateMessage("Volume", 1, "Image " << mImageFilename << ": float values copied back from the labels" << Gateendl);
+}
+//--------------------------------------------------------------------
+
+
 //--------------------------------------------------------------------
 int GateVImageVolume::GetNextVoxel(const G4ThreeVector& position,
                                    const G4ThreeVector& direction)
@@ -909,6 +953,19 @@ void GateVImageVolume::SetBuildDistanceTransfoFilename(G4String filename)
 
 //--------------------------------------------------------------------
 void GateVImageVolume::BuildDistanceTransfo()
+{
+  GateImage output;
+  ComputeDistanceTransfo(output);
+
+  // Dump final result ...
+  output.Write(mDistanceTransfoOutput);
+  GateMessage("Geometry", 1, "Distance map write to disk in the file '" << mDistanceTransfoOutput << "'.\n");
+  GateMessage("Geometry", 1, "You can now use it in the simulation. Use the macro 'distanceMap'. The macro 'buildAndDumpDistanceTransfo' is no more needed.\n");
+}
+//--------------------------------------------------------------------
+
+//--------------------------------------------------------------------
+void GateVImageVolume::ComputeDistanceTransfo(GateImage & output)
 {
   GateMessage("Geometry", 1, "Building distante map image (dmap) for the image '"
               << mImageFilename << "' (it could be long for large image)."
@@ -966,13 +1023,13 @@ void GateVImageVolume::BuildDistanceTransfo()
               tmpOutput.sizeX()<<"x"<<tmpOutput.sizeY()<<"x"<< tmpOutput.sizeZ()<< Gateendl);
 
   // Go ?
-  GateMessage("Geometry", 4, "Start distance map computation ...\n");
-  bool b = computeSEDT(v, tmpOutput, true, false, 1);
+  unsigned int nbThreads = std::max(1u, std::thread::hardware_concurrency());
+  GateMessage("Geometry", 4, "Start distance map computation (" << nbThreads << " threads) ...\n");
+  bool b = computeSEDT(v, tmpOutput, true, false, nbThreads);
   GateMessage("Geometry", 4, "End ! b = " << b << Gateendl);
 
   // Convert (copy) image from Vol structure into GateImage
   GateDebugMessage("Geometry", 4, "Convert and output\n");
-  GateImage output;
   output.SetResolutionAndHalfSize(pImage->GetResolution(), pImage->GetHalfSize());
   output.SetOrigin(pImage->GetOrigin());
   output.Allocate();
@@ -984,10 +1041,5 @@ void GateVImageVolume::BuildDistanceTransfo()
     ++pp;
     ++it;
   }
-
-  // Dump final result ...
-  output.Write(mDistanceTransfoOutput);
-  GateMessage("Geometry", 1, "Distance map write to disk in the file '" << mDistanceTransfoOutput << "'.\n");
-  GateMessage("Geometry", 1, "You can now use it in the simulation. Use the macro 'distanceMap'. The macro 'buildAndDumpDistanceTransfo' is no more needed.\n");
 }
 //--------------------------------------------------------------------
@@ -27,6 +27,7 @@
 #include "GateVolumeID.hh"
 #include "GateDetectorConstruction.hh"
 #include "GateSystemListMessenger.hh"
+#include "GateMessageManager.hh"
 
 #include "GateConfiguration.h"
 
@@ -42,7 +43,8 @@ G4int GateVSystem::m_insertionOrder=-1;
 GateVSystem::GateVSystem(const G4String& itsName,G4bool isWithGantry)
   : GateClockDependent( itsName , false ),
     m_BaseComponent(0),
-    m_mainComponentDepth( isWithGantry ? 1 : 0 ) 
+    m_mainComponentDepth( isWithGantry ? 1 : 0 ),
+    m_addressLayoutDone(false)
 {
   // Next lines were added for the multi-system approach
   G4String itsOwnName = GateSystemListManager::GetInstance()->GetInsertedSystemsNames()->back();
@@ -495,3 +497,103 @@ G4ThreeVector GateVSystem::ComputeObjectCenter(const GateVolumeID* volID) const
     G4ThreeVector(0,0,0);
 }
 //-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void GateVSystem::ComputeDetectorAddressLayout()
+{
+  m_addressLayoutDone = true;
+  m_addressShift.clear();
+  m_addressBits.clear();
+  m_addressMasks.clear();
+  m_componentCreators.clear();
+
+  G4int freeBits = DETECTOR_ADDRESS_LEVEL_BITS;
+  std::vector<G4int> shifts, bits;
+  for (size_t level=0; level<GetTreeDepth(); ++level) {
+    // The output ID of a level is the copy number of a component plus the number of volumes
+    // of its elder siblings, so it is lower than the number of volumes of the level
+    compList_t* currentList = MakeComponentListAtLevel(level);
+    G4int nofValues = 0;
+    for (size_t i=0; i<currentList->size(); ++i) {
+      size_t nofVol = (*currentList)[i]->GetVolumeNumber();
+      nofValues += nofVol ? nofVol : 1;
+      if ((*currentList)[i]->GetCreator())
+        m_componentCreators.insert((*currentList)[i]->GetCreator());
+    }
+    delete currentList;
+    // The level 0 holds the system number in multi-system simulations
+    if (level==0 && m_itsNumber>=nofValues) nofValues = m_itsNumber+1;
+
+    // One more value for -1 (no volume at this level)
+    G4int nofBits = 0;
+    while ( (1<<nofBits) < nofValues+1 ) nofBits++;
+    freeBits -= nofBits;
+    shifts.push_back(freeBits);
+    bits.push_back(nofBits);
+  }
+
+  if (freeBits<0 || m_itsNumber>=(1<<DETECTOR_ADDRESS_SYSTEM_BITS)) {
+    GateWarning("The output volume IDs of the system " << GetObjectName()
+                << " do not fit in 64 bits, the digitizer will compare the volume IDs.");
+    return;
+  }
+  m_addressShift = shifts;
+  m_addressBits = bits;
+
+  GateDetectorAddress mask = ((((GateDetectorAddress)1)<<DETECTOR_ADDRESS_SYSTEM_BITS)-1) << DETECTOR_ADDRESS_LEVEL_BITS;
+  for (size_t level=0; level<m_addressBits.size(); ++level) {
+    mask |= ((((GateDetectorAddress)1)<<m_addressBits[level])-1) << m_addressShift[level];
+    m_addressMasks.push_back(mask);
+  }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+GateDetectorAddress GateVSystem::ComputeDetectorAddress(const GateVolumeID& volumeID, const GateOutputVolumeID& outputVolumeID)
+{
+  if (!m_addressLayoutDone)
+    ComputeDetectorAddressLayout();
+  if (m_addressBits.empty())
+    return -1;
+
+  GateDetectorAddress address = ((GateDetectorAddress)m_itsNumber) << DETECTOR_ADDRESS_LEVEL_BITS;
+  G4int nofComponentLevels = 0;
+  for (size_t level=0; level<m_addressBits.size(); ++level) {
+    GateDetectorAddress value = (level<outputVolumeID.size()) ? outputVolumeID[level]+1 : 0;
+    if ( (value<0) || (value>=(((GateDetectorAddress)1)<<m_addressBits[level])) )
+      return -1;
+    address |= value << m_addressShift[level];
+    if (level>0 && value>0)
+      nofComponentLevels++;
+  }
+
+  // The address is exact if each volume below the base of the system is a component,
+  // with one copy of the base when the level 0 holds the system number
+  size_t baseDepth;
+  for (baseDepth=0; baseDepth<volumeID.size(); ++baseDepth)
+    if (volumeID.GetCreator(baseDepth) == m_BaseComponent->GetCreator())
+      break;
+  if (baseDepth==volumeID.size())
+    return address;
+  if ( (G4int)(volumeID.size()-1-baseDepth) != nofComponentLevels )
+    return address;
+  for (size_t depth=baseDepth+1; depth<volumeID.size(); ++depth)
+    if (m_componentCreators.find(volumeID.GetCreator(depth))==m_componentCreators.end())
+      return address;
+  if ( (m_sysNumber>1) && (m_BaseComponent->GetVolumeNumber()>1) )
+    return address;
+
+  return address | DETECTOR_ADDRESS_EXACT;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+GateDetectorAddress GateVSystem::GetDetectorAddressMask(size_t depth)
+{
+  if (!m_addressLayoutDone)
+    ComputeDetectorAddressLayout();
+  if (m_addressMasks.empty())
+    return 0;
+  return (depth<m_addressMasks.size()) ? m_addressMasks[depth] : m_addressMasks.back();
+}
+//-----------------------------------------------------------------------------
@@ -367,6 +367,37 @@ void GateVVolume::ConstructOwnPhysicalVolume(G4bool flagUpdateOnly)
 //----------------------------------------------------------------------------------------
 
 
+//----------------------------------------------------------------------------------------
+// Transform-only update of the tree (see GateDetectorConstruction::UpdateGeometry())
+void GateVVolume::UpdatePlacements(std::vector<G4VPhysicalVolume*>& movedVolumes)
+{
+  if ((m_moveList || m_repeaterList) && theListOfOwnPhysVolume.size()) {
+    size_t n = theListOfOwnPhysVolume.size();
+    std::vector<G4ThreeVector> translations(n);
+    std::vector<G4RotationMatrix> rotations(n);
+    for (size_t i=0; i<n; i++) {
+      translations[i] = theListOfOwnPhysVolume[i]->GetTranslation();
+      if (theListOfOwnPhysVolume[i]->GetRotation()) rotations[i] = *theListOfOwnPhysVolume[i]->GetRotation();
+    }
+
+    ConstructOwnPhysicalVolume(true);
+
+    for (size_t i=0; i<n; i++) {
+      G4VPhysicalVolume* physVol = theListOfOwnPhysVolume[i];
+      G4RotationMatrix rotation;
+      if (physVol->GetRotation()) rotation = *physVol->GetRotation();
+      if (physVol->GetTranslation() != translations[i] || rotation != rotations[i])
+        movedVolumes.push_back(physVol);
+    }
+    GateMessage("Move", 6, GetObjectName() << " placements updated\n");
+  }
+
+  for (size_t i=0; i<pChildList->size(); i++)
+    pChildList->GetVolume(i)->UpdatePlacements(movedVolumes);
+}
+//----------------------------------------------------------------------------------------
+
+
 //----------------------------------------------------------------------------------------
 // Tell the creator that the logical volume should be attached to the crystal-SD
 void GateVVolume::AttachCrystalSD()
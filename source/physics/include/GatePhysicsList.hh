@@ -96,6 +96,14 @@ public:
   RegionCutMapType & GetMapOfRegionCuts() { return mapOfRegionCuts; }
   G4double GetLowEdgeEnergy();
 
+  // Physics tables stored in a directory, in a sub-directory named by a
+  // key of the materials, cuts and physics list, and retrieved by the next
+  // jobs with the same key (first run only)
+  void SetPhysicsTableDirectory(G4String dir) { mPhysicsTableDirectory = dir; }
+  G4String ComputePhysicsTableKey();
+  void RetrievePhysicsTables(G4VUserPhysicsList * phys);
+  void StorePhysicsTables(G4VUserPhysicsList * phys);
+
   std::vector<G4String> mListOfStepLimiter;
   std::vector<G4String> mListOfG4UserSpecialCut;
   RegionCutMapType mapOfRegionCuts;
@@ -131,6 +139,10 @@ protected:
   G4String mListOfPhysicsLists;
   G4double mLowEnergyRangeLimit;
 
+  G4String mPhysicsTableDirectory;
+  G4String mPhysicsTablePath;
+  bool mPhysicsTablesDone;
+
   G4EmParameters *emPar;
 };
 
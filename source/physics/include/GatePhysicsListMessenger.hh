@@ -87,6 +87,7 @@ protected:
   G4UIcmdWithABool * pConstructProcessMixed;
 
   G4UIcmdWithADoubleAndUnit * pEnergyRangeMinLimitCmd;
+  G4UIcmdWithAString * pPhysicsTableDirectoryCmd;
 
 private:
   int nInit;
@@ -12,6 +12,7 @@ See LICENSE.md for further details
 
 #include "globals.hh"
 #include <vector>
+#include <set>
 
 #include "GateModuleListManager.hh"
 
@@ -43,6 +44,15 @@ class GatePulseProcessorChain : public GateModuleListManager
      virtual GateVPulseProcessor* GetProcessor(size_t i)
       	  {return (GateVPulseProcessor*) GetElement(i);}
      GatePulseList* ProcessPulseList();
+
+     /*! \brief Prepares the processing of the chain for the next run
+
+	If 'fuse' is true, the consecutive enabled processors which can process the pulse-lists
+	as arrays (GateVPulseProcessor::IsBatchProcessor()) are grouped, and each group is applied
+	in one pass on the list, without creating the intermediate pulse-lists. The processors
+	whose output is read by name ('usedNames', e.g. the input of another chain) end a group.
+     */
+     void Compile(const std::set<G4String>& usedNames, G4bool fuse);
      virtual size_t GetProcessorNumber()
       	  { return size();}
 	  
@@ -59,10 +69,18 @@ class GatePulseProcessorChain : public GateModuleListManager
        { m_system = aSystem; }
 
   protected:
+      //! A processor, or a group of processors fused by Compile()
+      struct Stage {
+        std::vector<GateVPulseProcessor*> processors;
+        G4String name;                  //!< Name of the group for the profiler
+      };
+
       GatePulseProcessorChainMessenger*    m_messenger;
       GateVSystem *m_system;            //!< System to which the chain is attached
       G4String				   m_outputName;
       G4String                             m_inputName;
+      std::vector<Stage>                   m_stages;          //!< Stages built by Compile()
+      G4bool                               m_isCompiled;      //!< False: sequential processing
 };
 
 #endif
@@ -25,6 +25,7 @@ See LICENSE.md for further details
 #include "globals.hh"
 #include <vector>
 #include <list>
+#include <ostream>
 #include "G4ios.hh"
 
 #include "G4ParticleDefinition.hh"
@@ -158,6 +159,11 @@ public:
   void SetLinearlosslimit(G4String part,  G4double limit);
   void SetMsclimitation(G4String part, G4String limit );
 
+  /// Writes the settings of the process given by macro (models with their
+  /// energy ranges, datasets, wrapper factors and step options), used in
+  /// the key of the stored physics tables
+  void DescribeSettings(std::ostream & os);
+
 
 
 protected:  
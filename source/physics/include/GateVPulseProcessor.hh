@@ -48,6 +48,14 @@ class GatePulseProcessorChain;
       - The other option is to overload the method ProcessPulseList() (if the pulse-processing 
       	sequential mechanism provided by ProcessPulseList() is not appropriate. 
 	In that case, one should provide some dummy implementation (such as {;}) for ProcessOnePulse()
+
+    - The processors which only change the energy and/or the time of the pulses, or drop some of
+      them, can also implement ProcessPulseBatch() and return true in IsBatchProcessor().
+      ProcessPulseList() then gathers the energies and times of the whole list into contiguous
+      arrays, calls ProcessPulseBatch() once, and copies the kept pulses with their new values.
+      ProcessOnePulse() is only used when the batch processing is disabled
+      (/gate/digitizer/processBatches false), so it must give the same results, including the
+      sequence of random numbers (see ShootGaussArray()).
       	
       \sa GatePulseProcessorChainMessenger, GatePulse, GatePulseList
 */      
@@ -79,6 +87,20 @@ class GateVPulseProcessor : public GateClockDependent
     //! This function is called by ProcessPulseList() for each of the input pulses
     //! The result of the pulse-processing must be incorporated into the output pulse-list
     virtual void ProcessOnePulse(const GatePulse* inputPulse,GatePulseList& outputPulseList)=0;
+
+    //! True if the processor implements ProcessPulseBatch()
+    virtual G4bool IsBatchProcessor() const { return false; }
+
+    //! Batch processing of a whole list: 'energies' and 'times' hold the values of the input pulses,
+    //! they are modified in place, and 'keep' (initialised to 1, 0 for the null pulses) is set to 0 for the dropped pulses
+    virtual void ProcessPulseBatch(const GatePulseList& /*inputPulseList*/, std::vector<G4double>& /*energies*/,
+                                   std::vector<G4double>& /*times*/, std::vector<char>& /*keep*/) {}
+
+    //! Applies n batch processors in one pass on the arrays of the input list, and creates
+    //! only the output list of the last one. Returns 0 if an intermediate list would be empty,
+    //! as the sequential processing of the chain.
+    static GatePulseList* ProcessPulseListBatch(GateVPulseProcessor* const* processors, size_t n,
+                                                const GatePulseList* inputPulseList);
     //@}
 
    
@@ -99,7 +121,20 @@ class GateVPulseProcessor : public GateClockDependent
      virtual void DescribeMyself(size_t indent=0) =0 ;
      
   protected:
+    //! Gaussian blurring of an array of values, value += sigma*G4RandGauss::shoot(), for the values
+    //! whose sigma is not negative. The random numbers are drawn in one G4RandGauss::shootArray()
+    //! call, in the order of the values: the same sequence as a loop on G4RandGauss::shoot(value,sigma).
+    void ShootGaussArray(std::vector<G4double>& values, const std::vector<G4double>& sigmas);
+
     GatePulseProcessorChain* m_chain;
+
+    std::vector<G4double> m_sigmas;          //!< Scratch array of the sigmas of ProcessPulseBatch(), kept between the events
+
+  private:
+    std::vector<G4double> m_gaussBuffer;     //!< Random numbers of ShootGaussArray()
+    std::vector<G4double> m_batchEnergies;   //!< Arrays of ProcessPulseListBatch(), those of the first processor
+    std::vector<G4double> m_batchTimes;      //!< of a group are used, kept between the events
+    std::vector<char>     m_batchKeep;
 };
 
 
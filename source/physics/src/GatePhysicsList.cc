@@ -16,6 +16,7 @@
 #include "G4ParticleWithCuts.hh"
 #include "G4ProcessManager.hh"
 #include "GatePhysicsListMessenger.hh"
+#include "GateSharedFile.hh"
 #include "G4BosonConstructor.hh"
 #include "G4LeptonConstructor.hh"
 #include "G4MesonConstructor.hh"
@@ -33,6 +34,12 @@
 #include "G4VModularPhysicsList.hh"
 #include "G4ExceptionHandler.hh"
 #include "G4StateManager.hh"
+#include "G4Material.hh"
+#include "G4IonisParamMat.hh"
+#include "G4ProcessVector.hh"
+#include "G4VEmProcess.hh"
+#include "G4VEnergyLossProcess.hh"
+#include "G4VEmModel.hh"
 
 #include "G4EmStandardPhysics.hh"
 #include "G4EmStandardPhysics_option1.hh"
@@ -60,6 +67,15 @@
 #include "GateParaPositronium.hh"
 #include "GateOrthoPositronium.hh"
 
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 
 //-----------------------------------------------------------------------------------------
 GatePhysicsList::GatePhysicsList(): G4VModularPhysicsList()
@@ -81,6 +97,7 @@ GatePhysicsList::GatePhysicsList(): G4VModularPhysicsList()
   mSplineFlag=true;
   mUserPhysicListName = "";
   userlimits=0;
+  mPhysicsTablesDone = false;
 
   G4double limit=250*eV; // limit for diplay production cuts table
   G4ProductionCutsTable::GetProductionCutsTable()->SetEnergyRange(limit, 100.*GeV);
@@ -1298,6 +1315,170 @@ G4double GatePhysicsList::GetLowEdgeEnergy()
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+// Models of an EM process with their energy range. The models given with
+// SetEmModel() are read with EmModel(i), since they are only added to the
+// model manager when the tables are built (the index starts at 0 or 1
+// depending on the Geant4 version, the missing ones are null).
+template<class Process>
+static void DescribeEmModels(std::ostream & os, Process * process)
+{
+  for (G4int i=0; i<8; i++) {
+    const G4VEmModel * model = process->EmModel(i);
+    if (model) os << " " << model->GetName() << " " << model->LowEnergyLimit() << " " << model->HighEnergyLimit();
+  }
+  os << " |";
+  for (G4int i=0; i<process->NumberOfModels(); i++) {
+    const G4VEmModel * model = process->GetModelByIndex(i);
+    if (model) os << " " << model->GetName() << " " << model->LowEnergyLimit() << " " << model->HighEnergyLimit();
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// The key describes everything the tables depend on: Geant4 version and
+// data, materials, regions with their cuts, energy range of the cuts,
+// processes of each particle with their EM models and energy ranges, the
+// settings of the GATE processes (models, datasets...) and EM options. Geant4 also checks the
+// material-cuts couples when retrieving and builds the tables if they
+// differ, so that a collision of the key is not an issue.
+G4String GatePhysicsList::ComputePhysicsTableKey()
+{
+  std::ostringstream os;
+  os << std::setprecision(17);
+  os << G4VERSION_NUMBER;
+  const char * data = std::getenv("G4LEDATA");
+  os << " " << (data ? data : "") << "\n";
+
+  const G4MaterialTable * materials = G4Material::GetMaterialTable();
+  for (size_t i=0; i<materials->size(); i++) {
+    const G4Material * m = (*materials)[i];
+    os << "M " << m->GetName() << " " << m->GetDensity() << " " << m->GetState()
+       << " " << m->GetTemperature() << " " << m->GetPressure()
+       << " " << m->GetIonisation()->GetMeanExcitationEnergy();
+    for (size_t e=0; e<m->GetNumberOfElements(); e++)
+      os << " " << m->GetElement(e)->GetName() << " " << m->GetElement(e)->GetZ()
+         << " " << m->GetElement(e)->GetA() << " " << m->GetFractionVector()[e];
+    os << "\n";
+  }
+
+  G4RegionStore * regions = G4RegionStore::GetInstance();
+  for (size_t i=0; i<regions->size(); i++) {
+    G4Region * r = (*regions)[i];
+    os << "R " << r->GetName();
+    G4ProductionCuts * cuts = r->GetProductionCuts();
+    if (cuts) for (int p=0; p<4; p++) os << " " << cuts->GetProductionCut(p);
+    std::vector<G4LogicalVolume*>::iterator v = r->GetRootLogicalVolumeIterator();
+    for (size_t j=0; j<r->GetNumberOfRootVolumes(); j++, v++) os << " " << (*v)->GetName();
+    os << "\n";
+  }
+  os << "E " << G4ProductionCutsTable::GetProductionCutsTable()->GetLowEdgeEnergy()
+     << " " << G4ProductionCutsTable::GetProductionCutsTable()->GetHighEdgeEnergy() << "\n";
+
+  G4ParticleTable::G4PTblDicIterator * particles = G4ParticleTable::GetParticleTable()->GetIterator();
+  particles->reset();
+  while ((*particles)()) {
+    G4ParticleDefinition * p = particles->value();
+    G4ProcessManager * pm = p->GetProcessManager();
+    if (!pm) continue;
+    G4ProcessVector * pv = pm->GetProcessList();
+    os << "P " << p->GetParticleName();
+    for (int j=0; j<(int)pv->size(); j++) {
+      G4VProcess * process = (*pv)[j];
+      os << " " << process->GetProcessName();
+      G4VEmProcess * em = dynamic_cast<G4VEmProcess*>(process);
+      G4VEnergyLossProcess * loss = dynamic_cast<G4VEnergyLossProcess*>(process);
+      if (em) DescribeEmModels(os, em);
+      if (loss) DescribeEmModels(os, loss);
+    }
+    os << "\n";
+  }
+
+  std::vector<GateVProcess*> * gateProcesses = GateVProcess::GetTheListOfProcesses();
+  for (size_t i=0; i<gateProcesses->size(); i++) (*gateProcesses)[i]->DescribeSettings(os);
+
+  os << "O " << mUserPhysicListName << " " << mDEDXBinning << " " << mLambdaBinning
+     << " " << mEmin << " " << mEmax << " " << mSplineFlag
+     << " " << emPar->MinKinEnergy() << " " << emPar->MaxKinEnergy();
+#if G4VERSION_MAJOR >= 10 && G4VERSION_MINOR >= 5
+  os << " " << mUseICRU90Data;
+#endif
+
+  const std::string s = os.str();
+  return GateSharedFile::ComputeKey(s.data(), s.size());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GatePhysicsList::RetrievePhysicsTables(G4VUserPhysicsList * phys)
+{
+  if (mPhysicsTableDirectory == "" || mPhysicsTablesDone) return;
+  mPhysicsTablePath = mPhysicsTableDirectory + "/" + ComputePhysicsTableKey();
+  // the marker is written once all the tables are stored
+  std::ifstream complete(mPhysicsTablePath + "/complete");
+  if (complete) {
+    GateMessage("Physic", 1, "Retrieve the physics tables from " << mPhysicsTablePath << Gateendl);
+    phys->SetPhysicsTableRetrieved(mPhysicsTablePath);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+static void RemoveTableDirectory(const std::string & dir)
+{
+  DIR * d = opendir(dir.c_str());
+  if (d) {
+    struct dirent * entry;
+    while ((entry = readdir(d)) != 0) {
+      std::string name = entry->d_name;
+      if (name != "." && name != "..") std::remove((dir + "/" + name).c_str());
+    }
+    closedir(d);
+  }
+  rmdir(dir.c_str());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GatePhysicsList::StorePhysicsTables(G4VUserPhysicsList * phys)
+{
+  if (mPhysicsTablePath == "" || mPhysicsTablesDone) return;
+  mPhysicsTablesDone = true;
+
+  // Retrieved: the next runs build their tables as usual
+  if (phys->IsPhysicsTableRetrieved()) {
+    phys->ResetPhysicsTableRetrieved();
+    return;
+  }
+
+  // The tables are first stored in a temporary directory, so that
+  // concurrent jobs never retrieve a partial set of tables.
+  std::ostringstream tmp;
+  tmp << mPhysicsTablePath << ".tmp" << getpid();
+  mkdir(mPhysicsTableDirectory.c_str(), 0755);
+  bool stored = false;
+  if (mkdir(tmp.str().c_str(), 0755) == 0 && phys->StorePhysicsTable(tmp.str())) {
+    std::ofstream complete(tmp.str() + "/complete");
+    complete << ComputePhysicsTableKey() << std::endl;
+    complete.close();
+    stored = complete && std::rename(tmp.str().c_str(), mPhysicsTablePath.c_str()) == 0;
+  }
+  if (stored)
+    GateMessage("Physic", 1, "Physics tables stored in " << mPhysicsTablePath << Gateendl);
+  else {
+    RemoveTableDirectory(tmp.str());
+    // another job may have stored the same tables meanwhile
+    std::ifstream complete(mPhysicsTablePath + "/complete");
+    if (!complete) GateWarning("Could not store the physics tables in " << mPhysicsTablePath << Gateendl);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 GatePhysicsList *GatePhysicsList::singleton = 0;
 //-----------------------------------------------------------------------------
@@ -64,6 +64,7 @@ GatePhysicsListMessenger::~GatePhysicsListMessenger()
   delete pAddPhysicsList;
   delete pAddPhysicsListMixed;
   delete pAddProcessMixed;
+  delete pPhysicsTableDirectoryCmd;
 
 }
 //----------------------------------------------------------------------------------------
@@ -268,6 +269,13 @@ void GatePhysicsListMessenger::BuildCommands(G4String base)
   guid += "]";
   pEnergyRangeMinLimitCmd->SetGuidance(guid);
 
+  // To store/retrieve the physics tables
+  bb = base+"/setPhysicsTableDirectory";
+  pPhysicsTableDirectoryCmd = new G4UIcmdWithAString(bb,this);
+  guidance = "Store the physics tables in this directory, and retrieve them in the next jobs with the same materials, cuts and physics list";
+  pPhysicsTableDirectoryCmd->SetGuidance(guidance);
+  pPhysicsTableDirectoryCmd->SetParameterName("Directory",false);
+
 }
 //----------------------------------------------------------------------------------------
 
@@ -449,6 +457,10 @@ void GatePhysicsListMessenger::SetNewValue(G4UIcommand* command, G4String param)
     GateMessage("Physic", 1, "Min Energy range set to "<<G4BestUnit(val,"Energy") << Gateendl);
   }
 
+  if (command == pPhysicsTableDirectoryCmd) {
+    pPhylist->SetPhysicsTableDirectory(param);
+  }
+
 }
 //----------------------------------------------------------------------------------------
 
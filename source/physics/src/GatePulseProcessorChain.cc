@@ -17,6 +17,7 @@ See LICENSE.md for further details
 #include "GateTools.hh"
 #include "GateHitConvertor.hh"
 #include "GateSingleDigiMaker.hh"
+#include "GateProfiler.hh"
 
 
 
@@ -25,7 +26,8 @@ GatePulseProcessorChain::GatePulseProcessorChain( GateDigitizer* itsDigitizer,
   : GateModuleListManager(itsDigitizer,itsDigitizer->GetObjectName() + "/" + itsOutputName,"pulse-processor"),
     m_system( itsDigitizer->GetSystem() ),
     m_outputName(itsOutputName),
-    m_inputName(GateHitConvertor::GetOutputAlias())
+    m_inputName(GateHitConvertor::GetOutputAlias()),
+    m_isCompiled(false)
 {
 //  G4cout << " DEBUT Constructor GatePulseProcessorChain \n";
   m_messenger = new GatePulseProcessorChainMessenger(this);
@@ -55,6 +57,7 @@ GatePulseProcessorChain::~GatePulseProcessorChain()
 void GatePulseProcessorChain::InsertProcessor(GateVPulseProcessor* newChildProcessor)
 {
   theListOfNamedObject.push_back(newChildProcessor);
+  m_isCompiled = false;
 }
 
 
@@ -89,10 +92,31 @@ GatePulseList* GatePulseProcessorChain::ProcessPulseList()
   if (pulseList->empty())
     return 0;
 
+  if (m_isCompiled) {
+    for (size_t s = 0 ; s < m_stages.size(); s++) {
+      const Stage& stage = m_stages[s];
+      {
+        GateProfilerScope scope(GateProfiler::IsEnabled() ?
+                                GateProfiler::GetInstance()->GetIndex("pulseProcessor", stage.name) : -1);
+        if (stage.processors.size()==1)
+          pulseList = stage.processors[0]->ProcessPulseList(pulseList);
+        else
+          pulseList = GateVPulseProcessor::ProcessPulseListBatch(&stage.processors[0], stage.processors.size(), pulseList);
+      }
+      if (pulseList) GateDigitizer::GetInstance()->StorePulseList(pulseList);
+      else break;
+    }
+  }
+  else
   // Sequentially launch all pulse processors
   for (size_t processorID = 0 ; processorID < GetProcessorNumber(); processorID++) 
     if (GetProcessor(processorID)->IsEnabled()) {
-      pulseList = GetProcessor(processorID)->ProcessPulseList(pulseList);
+      {
+        GateProfilerScope scope(GateProfiler::IsEnabled() ?
+                                GateProfiler::GetInstance()->GetIndex(GetProcessor(processorID), "pulseProcessor",
+                                                                      GetProcessor(processorID)->GetObjectName()) : -1);
+        pulseList = GetProcessor(processorID)->ProcessPulseList(pulseList);
+      }
       if (pulseList) GateDigitizer::GetInstance()->StorePulseList(pulseList);
       else break;
     }
@@ -102,3 +126,35 @@ GatePulseList* GatePulseProcessorChain::ProcessPulseList()
 }
 
 
+
+void GatePulseProcessorChain::Compile(const std::set<G4String>& usedNames, G4bool fuse)
+{
+  m_stages.clear();
+  m_isCompiled = fuse;
+  if (!fuse)
+    return;
+
+  G4bool canAppend = false;
+  for (size_t processorID = 0 ; processorID < GetProcessorNumber(); processorID++) {
+    GateVPulseProcessor* processor = GetProcessor(processorID);
+    if (!processor->IsEnabled())
+      continue;
+    G4bool isBatch = processor->IsBatchProcessor() && (processor->GetVerbosity()==0);
+    if (isBatch && canAppend) {
+      m_stages.back().processors.push_back(processor);
+      m_stages.back().name += "+" + processor->GetObjectName();
+    }
+    else {
+      Stage stage;
+      stage.processors.push_back(processor);
+      stage.name = processor->GetObjectName();
+      m_stages.push_back(stage);
+    }
+    canAppend = isBatch && (usedNames.find(processor->GetObjectName()) == usedNames.end());
+  }
+
+  if (nVerboseLevel>0)
+    for (size_t s = 0 ; s < m_stages.size(); s++)
+      if (m_stages[s].processors.size()>1)
+        G4cout << "[" << GetObjectName() << "::Compile]: fused processors " << m_stages[s].name << Gateendl;
+}
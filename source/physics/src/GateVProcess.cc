@@ -1366,4 +1366,35 @@ void GateVProcess::SetMsclimitation(G4String part, G4String  limit)
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+void GateVProcess::DescribeSettings(std::ostream & os)
+{
+  os << "G " << GetG4ProcessName();
+  for (unsigned int i=0; i<theListOfParticlesWithSelectedModels.size(); i++) {
+    GateListOfHadronicModels * model = theListOfSelectedModels[i];
+    os << " model " << theListOfParticlesWithSelectedModels[i]->GetParticleName() << " " << model->GetModelName();
+    std::vector<G4String> options = model->GetTheListOfOptions();
+    std::vector<double> emin = model->GetTheListOfEmin();
+    std::vector<double> emax = model->GetTheListOfEmax();
+    for (unsigned int j=0; j<options.size(); j++)
+      os << " " << options[j] << " " << emin[j] << " " << emax[j];
+  }
+  for (unsigned int i=0; i<theListOfParticlesWithSelectedDS.size(); i++)
+    os << " dataset " << theListOfParticlesWithSelectedDS[i]->GetParticleName() << " " << theListOfSelectedDataSets[i];
+  std::map<G4String,G4double>::const_iterator it;
+  for (it=theListOfWrapperFactor.begin(); it!=theListOfWrapperFactor.end(); ++it)
+    os << " wrapper " << it->first << " " << it->second;
+  for (it=theListOfWrapperCSEFactor.begin(); it!=theListOfWrapperCSEFactor.end(); ++it)
+    os << " wrapperCSE " << it->first << " " << it->second;
+  for (it=thelistOfRatioForStepFunction.begin(); it!=thelistOfRatioForStepFunction.end(); ++it)
+    os << " step " << it->first << " " << it->second << " " << thelistOfFinalRangeForStepFunction[it->first];
+  for (it=thelistOfLinearLossLimit.begin(); it!=thelistOfLinearLossLimit.end(); ++it)
+    os << " linearLoss " << it->first << " " << it->second;
+  std::map<G4String,G4MscStepLimitType>::const_iterator msc;
+  for (msc=thelistOfMscLimitation.begin(); msc!=thelistOfMscLimitation.end(); ++msc)
+    os << " msc " << msc->first << " " << msc->second;
+  os << "\n";
+}
+//-----------------------------------------------------------------------------
+
 #endif
@@ -13,6 +13,8 @@ See LICENSE.md for further details
 #include "GatePulseProcessorChain.hh"
 #include "GateSingleDigiMaker.hh"
 #include "GateDigitizer.hh"
+#include "Randomize.hh"
+#include <algorithm>
 
 // Constructs a new pulse-processor attached to a GateDigitizer
 GateVPulseProcessor::GateVPulseProcessor(GatePulseProcessorChain* itsChain,
@@ -37,13 +39,23 @@ GatePulseList* GateVPulseProcessor::ProcessPulseList(const GatePulseList* inputP
   if (!n_pulses)
     return 0;
 
-  GatePulseList* outputPulseList = new GatePulseList(GetObjectName());
+  GatePulseList* outputPulseList;
 
   GatePulseConstIterator iter;
-  for (iter = inputPulseList->begin() ; iter != inputPulseList->end() ; ++iter)
-      	ProcessOnePulse( *iter, *outputPulseList);
+  // the batch processors have the same code path at all verbosities: above 1,
+  // they print their output list instead of each pulse in ProcessOnePulse()
+  G4bool isBatch = IsBatchProcessor() && GateDigitizer::GetInstance()->GetProcessBatches();
+  if (isBatch) {
+    GateVPulseProcessor* self = this;
+    outputPulseList = ProcessPulseListBatch(&self, 1, inputPulseList);
+  }
+  else {
+    outputPulseList = new GatePulseList(GetObjectName());
+    for (iter = inputPulseList->begin() ; iter != inputPulseList->end() ; ++iter)
+      ProcessOnePulse( *iter, *outputPulseList);
+  }
   
-  if (nVerboseLevel==1) {
+  if ( (nVerboseLevel==1) || (isBatch && nVerboseLevel>1) ) {
       G4cout << "[" << GetObjectName() << "::ProcessPulseList]: returning output pulse-list with " << outputPulseList->size() << " entries\n";
       for (iter = outputPulseList->begin() ; iter != outputPulseList->end() ; ++iter)
       	G4cout << **iter << Gateendl;
@@ -66,3 +78,63 @@ void GateVPulseProcessor::Describe(size_t indent)
   DescribeMyself(indent);
 }
      
+
+
+
+GatePulseList* GateVPulseProcessor::ProcessPulseListBatch(GateVPulseProcessor* const* processors, size_t n,
+                                                          const GatePulseList* inputPulseList)
+{
+  size_t n_pulses = inputPulseList->size();
+  // assign() keeps the capacity: no reallocation after the first events
+  std::vector<G4double>& energies = processors[0]->m_batchEnergies;
+  std::vector<G4double>& times = processors[0]->m_batchTimes;
+  std::vector<char>& keep = processors[0]->m_batchKeep;
+  energies.assign(n_pulses,0.);
+  times.assign(n_pulses,0.);
+  keep.assign(n_pulses,1);
+  for (size_t i=0; i<n_pulses; ++i) {
+    const GatePulse* inputPulse = (*inputPulseList)[i];
+    if (inputPulse) {
+      energies[i] = inputPulse->GetEnergy();
+      times[i] = inputPulse->GetTime();
+    }
+    else
+      keep[i] = 0;
+  }
+
+  for (size_t k=0; k<n; ++k) {
+    // the next processor of a sequential chain would receive an empty list
+    if (k>0 && std::find(keep.begin(), keep.end(), 1) == keep.end())
+      return 0;
+    processors[k]->ProcessPulseBatch(*inputPulseList, energies, times, keep);
+  }
+
+  GatePulseList* outputPulseList = new GatePulseList(processors[n-1]->GetObjectName());
+  outputPulseList->reserve(n_pulses);
+  for (size_t i=0; i<n_pulses; ++i)
+    if (keep[i]) {
+      GatePulse* outputPulse = new GatePulse(*(*inputPulseList)[i]);
+      outputPulse->SetEnergy(energies[i]);
+      outputPulse->SetTime(times[i]);
+      outputPulseList->push_back(outputPulse);
+    }
+  return outputPulseList;
+}
+
+
+
+void GateVPulseProcessor::ShootGaussArray(std::vector<G4double>& values, const std::vector<G4double>& sigmas)
+{
+  size_t n = 0;
+  for (size_t i=0; i<sigmas.size(); ++i)
+    if (sigmas[i]>=0) n++;
+  if (!n) return;
+
+  m_gaussBuffer.resize(n);
+  G4RandGauss::shootArray(n, &m_gaussBuffer[0]);
+
+  size_t j = 0;
+  for (size_t i=0; i<values.size(); ++i)
+    if (sigmas[i]>=0)
+      values[i] = m_gaussBuffer[j++]*sigmas[i] + values[i];
+}